@@ -28,11 +28,14 @@ static const vector<vector<IntegerSchemeType> > benchmarkedIntegerSchemes{
     {IntegerSchemeType::DICT, IntegerSchemeType::BP},
     {IntegerSchemeType::RLE},
     {IntegerSchemeType::PFOR},
-    {IntegerSchemeType::BP}};
+    {IntegerSchemeType::BP},
+    // DELTA cascades the deltas, BP packs them
+    {IntegerSchemeType::DELTA, IntegerSchemeType::BP},
+    {IntegerSchemeType::DELTA_OF_DELTA, IntegerSchemeType::BP}};
 
 static const vector<DoubleSchemeType> benchmarkedDoubleSchemes{
     DoubleSchemeType::DICT, DoubleSchemeType::RLE, DoubleSchemeType::FREQUENCY,
-    DoubleSchemeType::PSEUDODECIMAL};
+    DoubleSchemeType::PSEUDODECIMAL, DoubleSchemeType::ALP, DoubleSchemeType::XOR};
 
 static const vector<StringSchemeType> benchmarkedStringSchemes{StringSchemeType::DICT,
                                                                StringSchemeType::FSST};
@@ -12,12 +12,20 @@
 #include "compression/Datablock.hpp"
 #include "scheme/SchemeConfig.hpp"
 #include "scheme/SchemeType.hpp"
+#include "stats/Sampling.hpp"
 // ------------------------------------------------------------------------------
 namespace btrblocks {
 // ------------------------------------------------------------------------------
 // Global configuation used by the compression interface
 // ------------------------------------------------------------------------------
 enum class SchemeSelection : uint8_t { SAMPLE, TRY_ALL };
+enum class StatisticsMode : uint8_t { EXACT, APPROXIMATE };
+// What the scheme with the best score has, see SchemeCost for the decompression speeds
+enum class SelectionObjective : uint8_t {
+  MAX_RATIO,       // the highest compression ratio
+  MIN_READ_TIME,   // the lowest time to load the compressed data and decompress it
+  RATIO_AT_SPEED,  // the highest compression ratio of the schemes that are fast enough
+};
 // ------------------------------------------------------------------------------
 struct BtrBlocksConfig {
   // clang-format off
@@ -25,6 +33,11 @@ struct BtrBlocksConfig {
   uint32_t sample_size{64};                            // run size of each sample
   uint32_t sample_count{10};                           // number of samples to take
 
+  struct {
+    SamplingStrategy strategy{SamplingStrategy::STRATIFIED_RUNS}; // how the sampled rows are picked
+    uint64_t seed{0x5EED5A3B1E5ull};                   // same seed and input give the same sample
+  } sampling;
+
   struct {
     IntegerSchemeSet schemes{defaultIntegerSchemes()}; // enabled integer schemes
     IntegerSchemeType override_scheme{autoScheme()};   // force using this scheme for integer columns
@@ -37,14 +50,48 @@ struct BtrBlocksConfig {
     uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
   } doubles;
 
+  struct {
+    FloatSchemeSet schemes{defaultFloatSchemes()};     // enabled float schemes
+    FloatSchemeType override_scheme{autoScheme()};     // force using this scheme for float columns
+    uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
+  } floats;
+
+  struct {
+    BigIntSchemeSet schemes{defaultBigIntSchemes()};   // enabled bigint schemes
+    BigIntSchemeType override_scheme{autoScheme()};    // force using this scheme for bigint columns
+    uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
+  } bigints;
+
   struct {
     StringSchemeSet schemes{defaultStringSchemes()};   // enabled string schemes
     StringSchemeType override_scheme{autoScheme()};    // force using this scheme for string columns
     uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
   } strings;
+
+  struct {
+    bool enabled{true};                                // reuse the schemes of the previous chunk of a column
+    double tolerance{0.1};                             // how far unique/null ratio and run length may drift
+    uint32_t revalidation{16};                         // estimate every n-th chunk from scratch, 0 = never
+  } decision_cache;
+
+  struct {
+    SelectionObjective objective{SelectionObjective::MAX_RATIO}; // what chooseScheme optimizes for
+    double read_bandwidth{2.0};                        // GB/s compressed data is loaded with (MIN_READ_TIME)
+    double min_decompression_speed{4.0};               // GB/s a scheme has to reach (RATIO_AT_SPEED)
+  } selection;
+
+  struct {
+    uint32_t block_microseconds{0};                    // wall time to compress a block in, 0 = unlimited
+  } budget;
   // clang-format on
 
   SchemeSelection scheme_selection{SchemeSelection::SAMPLE};  // sample or try all schemes?
+  uint32_t trial_threads{1};  // threads trying the schemes of a block's top level, 1 = serial
+  StatisticsMode statistics{StatisticsMode::EXACT};  // estimate distinct counts and runs while sampling
+  bool zone_maps{true};  // store min/max/null count with every column chunk
+  bool metrics{false};   // count bytes, ratios and times per column and scheme, see Metrics
+  bool bloom_filters{false};     // store a bloom filter of the distinct values with every column chunk
+  uint32_t bloom_filter_bits{12};  // bits per distinct value, 12 give ~0.5% false positives
 
   /// Get the global configuration instance.
   /// This is a singleton, so you can modify it to change the compression behaviour.
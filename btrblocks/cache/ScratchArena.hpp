@@ -0,0 +1,85 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <type_traits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Bump pointer allocator for the temporaries of compression. Memory is handed
+// out from a list of blocks that is only ever extended, and given back in
+// bulk when the Scope that was opened before it ends. Scopes nest like the
+// levels of the cascade, so after the first chunks a thread compresses without
+// touching the heap. Memory is not initialized.
+class ScratchArena {
+  struct Position {
+    u32 block;
+    u64 offset;
+  };
+
+ public:
+  static constexpr u64 ALIGNMENT = 64;
+  static constexpr u64 MIN_BLOCK_SIZE = 1 << 20;
+  // -------------------------------------------------------------------------------------
+  // Everything allocated while the scope lives is released when it ends
+  class Scope {
+   public:
+    explicit Scope(ScratchArena& arena) : arena(arena), checkpoint(arena.position) {}
+    ~Scope() { arena.position = checkpoint; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    ScratchArena& arena;
+    const Position checkpoint;
+  };
+  // -------------------------------------------------------------------------------------
+  template <typename T>
+  T* allocate(u64 count) {
+    static_assert(std::is_trivially_destructible_v<T> && alignof(T) <= ALIGNMENT);
+    return reinterpret_cast<T*>(allocateBytes(count * sizeof(T)));
+  }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] u64 capacity() const {
+    u64 capacity = 0;
+    for (const auto& block : blocks) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+  [[nodiscard]] u32 blockCount() const { return blocks.size(); }
+
+ private:
+  struct Block {
+    unique_ptr<u8[]> memory;
+    u8* data;  // memory aligned by ALIGNMENT
+    u64 size;
+  };
+  vector<Block> blocks;
+  Position position{0, 0};
+  // -------------------------------------------------------------------------------------
+  u8* allocateBytes(u64 size) {
+    size = (std::max<u64>(size, 1) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    // Blocks behind the current one are free, take the first that fits
+    for (; position.block < blocks.size(); position.block++, position.offset = 0) {
+      auto& block = blocks[position.block];
+      if (position.offset + size <= block.size) {
+        u8* data = block.data + position.offset;
+        position.offset += size;
+        return data;
+      }
+    }
+    const u64 block_size =
+        std::max({MIN_BLOCK_SIZE, size, blocks.empty() ? 0 : 2 * blocks.back().size});
+    auto memory = unique_ptr<u8[]>(new u8[block_size + ALIGNMENT]);
+    auto data = reinterpret_cast<u8*>(
+        (reinterpret_cast<uintptr_t>(memory.get()) + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+    blocks.push_back({std::move(memory), data, block_size});
+    position = {static_cast<u32>(blocks.size() - 1), size};
+    return data;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
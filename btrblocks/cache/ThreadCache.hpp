@@ -1,5 +1,6 @@
 #pragma once
 // ------------------------------------------------------------------------------
+#include "cache/ScratchArena.hpp"
 #include "common/Log.hpp"
 #include "common/Units.hpp"
 // -------------------------------------------------------------------------------------
@@ -25,6 +26,8 @@ struct ThreadCacheContainer {
   // -------------------------------------------------------------------------------------
   bool fsst = false;
   // -------------------------------------------------------------------------------------
+  ScratchArena arena;  // temporaries of compression, released level by level
+  // -------------------------------------------------------------------------------------
   std::ostream& operator<<([[maybe_unused]] const string& str) {
 #if defined(BTR_FLAG_LOGGING) and BTR_FLAG_LOGGING
     if (estimation_level == 0) {
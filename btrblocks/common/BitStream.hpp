@@ -0,0 +1,69 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Appends bits to u64 words, lowest bit first
+class BitWriter {
+ public:
+  explicit BitWriter(u64* words) : begin(words), words(words) {}
+  // value must fit into bits, bits <= 64. Only the words that are counted by
+  // wordCount are written, a word is cleared when the first bits go into it.
+  void write(u64 value, u32 bits) {
+    if (bits == 0) {
+      return;
+    }
+    if (offset == 0) {
+      *words = value;
+    } else {
+      *words |= value << offset;
+    }
+    if (offset + bits > 64) {
+      words++;
+      *words = value >> (64 - offset);
+      offset = offset + bits - 64;
+    } else if (offset + bits == 64) {
+      words++;
+      offset = 0;
+    } else {
+      offset += bits;
+    }
+  }
+  // Words written so far, including the one that is partly filled
+  u32 wordCount() const { return words - begin + (offset > 0 ? 1 : 0); }
+
+ private:
+  u64* begin;
+  u64* words;
+  u32 offset = 0;
+};
+// -------------------------------------------------------------------------------------
+class BitReader {
+ public:
+  explicit BitReader(const u64* words) : words(words) {}
+  // bits <= 64
+  u64 read(u32 bits) {
+    if (bits == 0) {
+      return 0;
+    }
+    u64 value = *words >> offset;
+    if (offset + bits >= 64) {
+      words++;
+      if (offset + bits > 64) {
+        value |= *words << (64 - offset);
+      }
+      offset = offset + bits - 64;
+    } else {
+      offset += bits;
+    }
+    return bits == 64 ? value : value & ((u64(1) << bits) - 1);
+  }
+
+ private:
+  const u64* words;
+  u32 offset = 0;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -49,9 +49,9 @@ enum class ColumnType : u8 {
   DOUBLE = 1,
   STRING = 2,
   SKIP,  // SKIP THIS COLUMN
+  FLOAT = 4,
+  BIGINT = 5,
   // The next types are out of scope
-  FLOAT,
-  BIGINT,
   SMALLINT,
   UNDEFINED
 };
@@ -60,6 +60,8 @@ using SMALLINT = s16;
 using INTEGER = s32;  // we use FOR always at the beginning so negative integers
                       // will be handled out
 using UINTEGER = u32;
+using BIGINT = s64;
+using FLOAT = float;
 using DOUBLE = double;
 using STRING = string;
 using BITMAP = u8;
@@ -73,6 +75,10 @@ inline ColumnType ConvertStringToType(const string& type_str) {
     return ColumnType::DOUBLE;
   } else if (type_str == "string") {
     return ColumnType::STRING;
+  } else if (type_str == "bigint") {
+    return ColumnType::BIGINT;
+  } else if (type_str == "float") {
+    return ColumnType::FLOAT;
   } else {
     return ColumnType::SKIP;
   }
@@ -85,6 +91,10 @@ inline string ConvertTypeToString(const ColumnType type_str) {
     return "double";
   } else if (type_str == ColumnType::STRING) {
     return "string";
+  } else if (type_str == ColumnType::BIGINT) {
+    return "bigint";
+  } else if (type_str == ColumnType::FLOAT) {
+    return "float";
   } else {
     UNREACHABLE();
     return "";
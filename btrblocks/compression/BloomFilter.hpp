@@ -0,0 +1,108 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/SIMD.hpp"
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Split block Bloom filter as used by Parquet. A value only touches a single
+// 256 bit block, in which it sets one bit in each of the eight 32 bit words,
+// so a probe is one cache line access and a handful of AVX2 instructions.
+// The filter does not own its blocks, it either fills a chunk that is being
+// written or reads one that is stored.
+class BloomFilter {
+ public:
+  static constexpr u32 BLOCK_SIZE = 32;
+  // -------------------------------------------------------------------------------------
+  BloomFilter(const u8* blocks, u32 block_count) : blocks(blocks), block_count(block_count) {}
+  // -------------------------------------------------------------------------------------
+  static inline u32 blockCount(u32 value_count, u32 bits_per_value) {
+    return std::max<u32>(1, (u64(value_count) * bits_per_value + BLOCK_SIZE * 8 - 1) /
+                                (BLOCK_SIZE * 8));
+  }
+  // blocks has to be zeroed before the first insert
+  static inline void insert(u8* blocks, u32 block_count, u64 hash) {
+    auto words = reinterpret_cast<u32*>(blocks + blockIndex(hash, block_count) * BLOCK_SIZE);
+    const auto key = static_cast<u32>(hash);
+    for (u32 i = 0; i < 8; i++) {
+      words[i] |= 1u << ((key * SALT[i]) >> 27);
+    }
+  }
+  // false means that the value was never inserted
+  [[nodiscard]] inline bool mayContain(u64 hash) const {
+    auto block = blocks + blockIndex(hash, block_count) * BLOCK_SIZE;
+    const auto key = static_cast<u32>(hash);
+#ifdef BTR_USE_SIMD
+    const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALT));
+    const __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+    const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), mask);
+#else
+    u32 words[8];
+    std::memcpy(words, block, BLOCK_SIZE);
+    for (u32 i = 0; i < 8; i++) {
+      if ((words[i] & (1u << ((key * SALT[i]) >> 27))) == 0) {
+        return false;
+      }
+    }
+    return true;
+#endif
+  }
+  // -------------------------------------------------------------------------------------
+  // The hashes are part of the file format and must not change
+  static inline u64 hash(INTEGER value) { return mix(SEED ^ static_cast<u32>(value)); }
+  static inline u64 hash(BIGINT value) { return mix(SEED ^ static_cast<u64>(value)); }
+  static inline u64 hash(DOUBLE value) {
+    // -0.0 == 0.0
+    value = value == 0 ? 0.0 : value;
+    u64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mix(SEED ^ bits);
+  }
+  static inline u64 hash(FLOAT value) {
+    // -0.0f == 0.0f
+    value = value == 0 ? 0.0f : value;
+    u32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mix(SEED ^ bits);
+  }
+  static inline u64 hash(str value) {
+    u64 hash = SEED ^ value.size();
+    size_t i = 0;
+    for (; i + 8 <= value.size(); i += 8) {
+      u64 word;
+      std::memcpy(&word, value.data() + i, 8);
+      hash = mix(hash ^ word);
+    }
+    u64 tail = 0;
+    std::memcpy(&tail, value.data() + i, value.size() - i);
+    return mix(hash ^ tail);
+  }
+
+ private:
+  static constexpr u64 SEED = 0x9E3779B97F4A7C15ull;
+  static constexpr u32 SALT[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+  // -------------------------------------------------------------------------------------
+  const u8* blocks;
+  u32 block_count;
+  // -------------------------------------------------------------------------------------
+  static inline u32 blockIndex(u64 hash, u32 block_count) {
+    return static_cast<u32>(((hash >> 32) * block_count) >> 32);
+  }
+  // Finalizer of MurmurHash3
+  static inline u64 mix(u64 value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include <sys/mman.h>
 #include <cassert>
 #include "common/Exceptions.hpp"
+#include "compression/Metrics.hpp"
 #include "compression/SchemePicker.hpp"
 #include "extern/RoaringBitmap.hpp"
 
@@ -39,8 +40,10 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
   u32 tuple_count = meta->tuple_count;
   BitmapWrapper* bitmap = this->getBitmap(index);
 
-  auto output_chunk = get_data(output_chunk_v, this->getDecompressedSize(index) + SIMD_EXTRA_BYTES);
+  const u32 decompressed_size = this->getDecompressedSize(index);
+  auto output_chunk = get_data(output_chunk_v, decompressed_size + SIMD_EXTRA_BYTES);
   bool requires_copy = false;
+  const u64 start_ns = Metrics::now();
   // Decompress data
   switch (meta->type) {
     case ColumnType::INTEGER: {
@@ -60,6 +63,18 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
       scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0);
       break;
     }
+    case ColumnType::BIGINT: {
+      auto destination_array = reinterpret_cast<BIGINT*>(output_chunk);
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto destination_array = reinterpret_cast<FLOAT*>(output_chunk);
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0);
+      break;
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
       requires_copy = scheme.decompressNoCopy(output_chunk, bitmap, input_data, tuple_count, 0);
@@ -69,10 +84,494 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
       throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
     }
   }
+  if (Metrics::isEnabled()) {
+    Metrics::recordDecompression(meta->type, meta->compression_type, decompressed_size,
+                                 Metrics::now() - start_ns);
+  }
 
   return requires_copy;
 }
 
+void BtrReader::readColumnSelected(std::vector<u8>& output_chunk_v,
+                                   u32 index,
+                                   const std::vector<u32>& selection) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = static_cast<const u8*>(meta->data);
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+  u32 count = selection.size();
+
+  switch (meta->type) {
+    case ColumnType::INTEGER: {
+      auto output_chunk = get_data(output_chunk_v, count * sizeof(INTEGER) + SIMD_EXTRA_BYTES);
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressSelected(reinterpret_cast<INTEGER*>(output_chunk), selection.data(), count,
+                                bitmap, input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::DOUBLE: {
+      auto output_chunk = get_data(output_chunk_v, count * sizeof(DOUBLE) + SIMD_EXTRA_BYTES);
+      auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressSelected(reinterpret_cast<DOUBLE*>(output_chunk), selection.data(), count,
+                                bitmap, input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::BIGINT: {
+      auto output_chunk = get_data(output_chunk_v, count * sizeof(BIGINT) + SIMD_EXTRA_BYTES);
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressSelected(reinterpret_cast<BIGINT*>(output_chunk), selection.data(), count,
+                                bitmap, input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto output_chunk = get_data(output_chunk_v, count * sizeof(FLOAT) + SIMD_EXTRA_BYTES);
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressSelected(reinterpret_cast<FLOAT*>(output_chunk), selection.data(), count,
+                                bitmap, input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::STRING: {
+      auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      // The selected strings are never longer than all strings together
+      u32 size = (count + 1) * sizeof(StringArrayViewer::Slot) +
+                 scheme.getTotalLength(input_data, tuple_count, bitmap) + SIMD_EXTRA_BYTES;
+      auto output_chunk = get_data(output_chunk_v, size);
+      scheme.decompressSelected(output_chunk, selection.data(), count, bitmap, input_data,
+                                tuple_count, 0);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+}
+
+u32 BtrReader::readDictionary(std::vector<u8>& dictionary, std::vector<u32>& codes, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = static_cast<const u8*>(meta->data);
+  u32 tuple_count = meta->tuple_count;
+  codes.resize(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+
+  u32 dict_size;
+  switch (meta->type) {
+    case ColumnType::INTEGER: {
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      dict_size = scheme.decompressDictionary(dictionary, codes.data(), input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::DOUBLE: {
+      auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      dict_size = scheme.decompressDictionary(dictionary, codes.data(), input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::BIGINT: {
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      dict_size = scheme.decompressDictionary(dictionary, codes.data(), input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      dict_size = scheme.decompressDictionary(dictionary, codes.data(), input_data, tuple_count, 0);
+      break;
+    }
+    case ColumnType::STRING: {
+      auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      dict_size = scheme.decompressDictionary(dictionary, codes.data(), input_data, tuple_count, 0);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+
+  codes.resize(dict_size > 0 ? tuple_count : 0);
+  return dict_size;
+}
+
+INTEGER BtrReader::lookupInteger(u32 index, u32 row) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::INTEGER) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  die_if(row < meta->tuple_count);
+  auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.lookup(meta->data, row, meta->tuple_count, 0);
+}
+
+DOUBLE BtrReader::lookupDouble(u32 index, u32 row) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::DOUBLE) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  die_if(row < meta->tuple_count);
+  auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.lookup(meta->data, row, meta->tuple_count, 0);
+}
+
+BIGINT BtrReader::lookupBigInt(u32 index, u32 row) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::BIGINT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  die_if(row < meta->tuple_count);
+  auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.lookup(meta->data, row, meta->tuple_count, 0);
+}
+
+FLOAT BtrReader::lookupFloat(u32 index, u32 row) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::FLOAT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  die_if(row < meta->tuple_count);
+  auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.lookup(meta->data, row, meta->tuple_count, 0);
+}
+
+double BtrReader::aggregate(u32 index, AggKind kind) {
+  auto meta = this->getChunkMetadata(index);
+  switch (meta->type) {
+    case ColumnType::INTEGER:
+      return this->aggregateInteger(index).get(kind);
+    case ColumnType::DOUBLE:
+      return this->aggregateDouble(index).get(kind);
+    case ColumnType::BIGINT:
+      return this->aggregateBigInt(index).get(kind);
+    case ColumnType::FLOAT:
+      return this->aggregateFloat(index).get(kind);
+    default:
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+}
+
+TAggregate<INTEGER> BtrReader::aggregateInteger(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::INTEGER) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.aggregate(this->getBitmap(index), meta->data, meta->tuple_count, 0);
+}
+
+TAggregate<DOUBLE> BtrReader::aggregateDouble(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::DOUBLE) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.aggregate(this->getBitmap(index), meta->data, meta->tuple_count, 0);
+}
+
+TAggregate<BIGINT> BtrReader::aggregateBigInt(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::BIGINT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.aggregate(this->getBitmap(index), meta->data, meta->tuple_count, 0);
+}
+
+TAggregate<FLOAT> BtrReader::aggregateFloat(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::FLOAT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  return scheme.aggregate(this->getBitmap(index), meta->data, meta->tuple_count, 0);
+}
+
+std::vector<u32> BtrReader::toSelection(const std::vector<BITMAP>& matches) {
+  std::vector<u32> selection;
+  for (u32 row_i = 0; row_i < matches.size(); row_i++) {
+    if (matches[row_i]) {
+      selection.push_back(row_i);
+    }
+  }
+  return selection;
+}
+
+namespace {
+// Answers the parts of a scan that only depend on the nullmap. Returns true if
+// result is final and the data does not have to be looked at.
+template <typename T>
+bool scanNullmap(const TPredicate<T>& predicate,
+                 BitmapWrapper* bitmap,
+                 BITMAP* result,
+                 u32 tuple_count) {
+  if (predicate.isNullCheck()) {
+    bitmap->writeBITMAP(result);
+    if (predicate.type == PredicateType::IS_NULL) {
+      for (u32 i = 0; i < tuple_count; i++) {
+        result[i] ^= 1;
+      }
+    }
+    return true;
+  }
+  if (bitmap->type() == BitmapType::ALLZEROS) {
+    // Nothing but nulls, no need to look at the data
+    std::memset(result, 0, tuple_count);
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool zoneMapMayMatch(const TPredicate<T>& predicate, const ColumnZoneMap& zone_map, u32 tuple_count) {
+  switch (predicate.type) {
+    case PredicateType::IS_NULL:
+      return zone_map.null_count > 0;
+    case PredicateType::IS_NOT_NULL:
+      return zone_map.null_count < tuple_count;
+    default:
+      break;
+  }
+  if (zone_map.null_count == tuple_count) {
+    return false;
+  }
+  const T min = zone_map.getMin<T>();
+  const T max = zone_map.getMax<T>();
+  auto at_most_max = [&](const T& value) { return !zone_map.hasMax() || value <= max; };
+  switch (predicate.type) {
+    case PredicateType::EQUAL:
+      return min <= predicate.lower && at_most_max(predicate.lower);
+    case PredicateType::NOT_EQUAL:
+      return !(zone_map.hasMax() && min == max && min == predicate.lower);
+    case PredicateType::LESS:
+      return min < predicate.lower;
+    case PredicateType::LESS_EQUAL:
+      return min <= predicate.lower;
+    case PredicateType::GREATER:
+      return !zone_map.hasMax() || max > predicate.lower;
+    case PredicateType::GREATER_EQUAL:
+      return at_most_max(predicate.lower);
+    case PredicateType::BETWEEN:
+      return predicate.lower <= predicate.upper && min <= predicate.upper &&
+             at_most_max(predicate.lower);
+    case PredicateType::IN: {
+      auto it = std::lower_bound(predicate.values.begin(), predicate.values.end(), min);
+      return it != predicate.values.end() && at_most_max(*it);
+    }
+    case PredicateType::PREFIX:
+      if constexpr (std::is_same_v<T, str>) {
+        // The values with the prefix lie between the prefix and the prefix
+        // followed by 0xFF bytes
+        return min.substr(0, predicate.lower.size()) <= predicate.lower &&
+               at_most_max(predicate.lower);
+      }
+      return true;
+    default:
+      return true;
+  }
+}
+
+template <typename T>
+bool bloomFilterMayMatch(const TPredicate<T>& predicate, const BloomFilter& bloom_filter) {
+  switch (predicate.type) {
+    case PredicateType::EQUAL:
+      return bloom_filter.mayContain(BloomFilter::hash(predicate.lower));
+    case PredicateType::IN:
+      return std::any_of(predicate.values.begin(), predicate.values.end(), [&](const T& value) {
+        return bloom_filter.mayContain(BloomFilter::hash(value));
+      });
+    default:
+      return true;
+  }
+}
+}  // namespace
+
+void BtrReader::scanColumn(std::vector<BITMAP>& result_v, u32 index, const Predicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = static_cast<const u8*>(meta->data);
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+
+  result_v.resize(tuple_count);
+  auto result = result_v.data();
+  if (scanNullmap(predicate, bitmap, result, tuple_count)) {
+    return;
+  }
+
+  switch (meta->type) {
+    case ColumnType::INTEGER: {
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.scan(predicate, result, input_data, tuple_count, 0);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+  bitmap->maskBITMAP(result);
+}
+
+void BtrReader::scanColumn(std::vector<BITMAP>& result_v,
+                           u32 index,
+                           const StringPredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = static_cast<const u8*>(meta->data);
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+
+  result_v.resize(tuple_count);
+  auto result = result_v.data();
+  if (scanNullmap(predicate, bitmap, result, tuple_count)) {
+    return;
+  }
+
+  switch (meta->type) {
+    case ColumnType::STRING: {
+      auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.scan(predicate, result, input_data, tuple_count, 0);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+  bitmap->maskBITMAP(result);
+}
+
+void BtrReader::scanColumn(std::vector<BITMAP>& result_v,
+                           u32 index,
+                           const BigIntPredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = static_cast<const u8*>(meta->data);
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+
+  result_v.resize(tuple_count);
+  auto result = result_v.data();
+  if (scanNullmap(predicate, bitmap, result, tuple_count)) {
+    return;
+  }
+
+  switch (meta->type) {
+    case ColumnType::BIGINT: {
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.scan(predicate, result, input_data, tuple_count, 0);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+  bitmap->maskBITMAP(result);
+}
+
+const ColumnZoneMap* BtrReader::getZoneMap(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (!meta->hasSection(ChunkSection::ZONE_MAP)) {
+    return nullptr;
+  }
+  return reinterpret_cast<const ColumnZoneMap*>(meta->data + meta->nullmap_offset -
+                                                sizeof(ColumnZoneMap));
+}
+
+bool BtrReader::mayMatch(u32 index, const Predicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::INTEGER) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto zone_map = this->getZoneMap(index);
+  if (zone_map != nullptr && !zoneMapMayMatch(predicate, *zone_map, meta->tuple_count)) {
+    return false;
+  }
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloomFilterMayMatch(predicate, *bloom_filter);
+}
+
+bool BtrReader::mayMatch(u32 index, const DoublePredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::DOUBLE) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto zone_map = this->getZoneMap(index);
+  if (zone_map != nullptr && !zoneMapMayMatch(predicate, *zone_map, meta->tuple_count)) {
+    return false;
+  }
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloomFilterMayMatch(predicate, *bloom_filter);
+}
+
+bool BtrReader::mayMatch(u32 index, const BigIntPredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::BIGINT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto zone_map = this->getZoneMap(index);
+  if (zone_map != nullptr && !zoneMapMayMatch(predicate, *zone_map, meta->tuple_count)) {
+    return false;
+  }
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloomFilterMayMatch(predicate, *bloom_filter);
+}
+
+bool BtrReader::mayMatch(u32 index, const FloatPredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::FLOAT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto zone_map = this->getZoneMap(index);
+  if (zone_map != nullptr && !zoneMapMayMatch(predicate, *zone_map, meta->tuple_count)) {
+    return false;
+  }
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloomFilterMayMatch(predicate, *bloom_filter);
+}
+
+bool BtrReader::mayMatch(u32 index, const StringPredicate& predicate) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::STRING) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+  }
+  auto zone_map = this->getZoneMap(index);
+  if (zone_map != nullptr && !zoneMapMayMatch(predicate, *zone_map, meta->tuple_count)) {
+    return false;
+  }
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloomFilterMayMatch(predicate, *bloom_filter);
+}
+
+std::optional<BloomFilter> BtrReader::getBloomFilter(u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (!meta->hasSection(ChunkSection::BLOOM_FILTER)) {
+    return std::nullopt;
+  }
+  u32 end = meta->nullmap_offset;
+  if (meta->hasSection(ChunkSection::ZONE_MAP)) {
+    end -= sizeof(ColumnZoneMap);
+  }
+  u32 block_count;
+  std::memcpy(&block_count, meta->data + end - sizeof(block_count), sizeof(block_count));
+  return BloomFilter(meta->data + end - sizeof(block_count) - block_count * BloomFilter::BLOCK_SIZE,
+                     block_count);
+}
+
+bool BtrReader::mayContain(u32 index, INTEGER value) {
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloom_filter->mayContain(BloomFilter::hash(value));
+}
+
+bool BtrReader::mayContain(u32 index, DOUBLE value) {
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloom_filter->mayContain(BloomFilter::hash(value));
+}
+
+bool BtrReader::mayContain(u32 index, str value) {
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloom_filter->mayContain(BloomFilter::hash(value));
+}
+
+bool BtrReader::mayContain(u32 index, BIGINT value) {
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloom_filter->mayContain(BloomFilter::hash(value));
+}
+
+bool BtrReader::mayContain(u32 index, FLOAT value) {
+  auto bloom_filter = this->getBloomFilter(index);
+  return !bloom_filter || bloom_filter->mayContain(BloomFilter::hash(value));
+}
+
 string BtrReader::getSchemeDescription(u32 index) {
   auto meta = this->getChunkMetadata(index);
   u8 compression = meta->compression_type;
@@ -87,6 +586,14 @@ string BtrReader::getSchemeDescription(u32 index) {
       auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.fullDescription(src);
     }
+    case ColumnType::BIGINT: {
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.fullDescription(src);
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.fullDescription(src);
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.fullDescription(src);
@@ -111,6 +618,14 @@ string BtrReader::getBasicSchemeDescription(u32 index) {
       auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.selfDescription();
     }
+    case ColumnType::BIGINT: {
+      auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.selfDescription();
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.selfDescription();
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.selfDescription(src);
@@ -166,6 +681,12 @@ u32 BtrReader::getDecompressedSize(u32 index) {
     case ColumnType::DOUBLE: {
       return sizeof(DOUBLE) * meta->tuple_count;
     }
+    case ColumnType::BIGINT: {
+      return sizeof(BIGINT) * meta->tuple_count;
+    }
+    case ColumnType::FLOAT: {
+      return sizeof(FLOAT) * meta->tuple_count;
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
 
@@ -192,6 +713,12 @@ u32 BtrReader::getDecompressedDataSize(u32 index) {
     case ColumnType::DOUBLE: {
       return sizeof(DOUBLE) * meta->tuple_count;
     }
+    case ColumnType::BIGINT: {
+      return sizeof(BIGINT) * meta->tuple_count;
+    }
+    case ColumnType::FLOAT: {
+      return sizeof(FLOAT) * meta->tuple_count;
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
 
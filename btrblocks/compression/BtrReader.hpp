@@ -5,6 +5,8 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include "compression/BloomFilter.hpp"
 #include "compression/Datablock.hpp"
 
 namespace btrblocks {
@@ -14,6 +16,62 @@ class BtrReader {
   explicit BtrReader(void* data);
   virtual ~BtrReader();
   bool readColumn(std::vector<u8>& output_chunk, u32 index);
+  // Evaluates the predicate on the compressed chunk and writes one entry per
+  // tuple into result (1 = qualifies). Null rows only qualify for IS_NULL.
+  void scanColumn(std::vector<BITMAP>& result, u32 index, const Predicate& predicate);
+  void scanColumn(std::vector<BITMAP>& result, u32 index, const StringPredicate& predicate);
+  void scanColumn(std::vector<BITMAP>& result, u32 index, const BigIntPredicate& predicate);
+  // Decompresses only the tuples in selection (ascending row ids), e.g. the
+  // matches of a scan on another column. output holds selection.size()
+  // values, strings in the StringArrayViewer layout. Values of null rows are
+  // unspecified, null strings are empty.
+  void readColumnSelected(std::vector<u8>& output_chunk,
+                          u32 index,
+                          const std::vector<u32>& selection);
+  // Dictionary encoded chunks: copies the distinct values to dictionary (like
+  // readColumn, strings in the StringArrayViewer layout) and the code of every
+  // tuple to codes, without mapping codes back to values. A group by can then
+  // index an array with the codes and only translate the groups. Returns the
+  // number of dictionary entries, 0 if the chunk does not use a dictionary.
+  u32 readDictionary(std::vector<u8>& dictionary, std::vector<u32>& codes, u32 index);
+  // The value of a single tuple, decoded without decompressing the chunk
+  // where the scheme allows it. The value of a null row is unspecified.
+  [[nodiscard]] INTEGER lookupInteger(u32 index, u32 row);
+  [[nodiscard]] DOUBLE lookupDouble(u32 index, u32 row);
+  [[nodiscard]] BIGINT lookupBigInt(u32 index, u32 row);
+  [[nodiscard]] FLOAT lookupFloat(u32 index, u32 row);
+  // SUM/COUNT/MIN/MAX over the non-null tuples of a numeric chunk, computed on
+  // the compressed data where the scheme allows it. The typed variants sum
+  // integers exactly, bigints in 128 bits. aggregate returns the sum as a
+  // double, exact as long as its magnitude stays below 2^53, rounded to the
+  // nearest double beyond that. MIN and MAX of a chunk without values are NaN.
+  [[nodiscard]] double aggregate(u32 index, AggKind kind);
+  [[nodiscard]] TAggregate<INTEGER> aggregateInteger(u32 index);
+  [[nodiscard]] TAggregate<DOUBLE> aggregateDouble(u32 index);
+  [[nodiscard]] TAggregate<BIGINT> aggregateBigInt(u32 index);
+  [[nodiscard]] TAggregate<FLOAT> aggregateFloat(u32 index);
+  // The row ids of the qualifying tuples of a scan result
+  static std::vector<u32> toSelection(const std::vector<BITMAP>& matches);
+  // The zone map of the chunk, nullptr if it was written without one
+  [[nodiscard]] const ColumnZoneMap* getZoneMap(u32 index);
+  // Tests the predicate against the zone map and the bloom filter only. false
+  // means that no tuple of the chunk qualifies and the chunk does not have to
+  // be scanned. Chunks without either always may match.
+  [[nodiscard]] bool mayMatch(u32 index, const Predicate& predicate);
+  [[nodiscard]] bool mayMatch(u32 index, const DoublePredicate& predicate);
+  [[nodiscard]] bool mayMatch(u32 index, const StringPredicate& predicate);
+  [[nodiscard]] bool mayMatch(u32 index, const BigIntPredicate& predicate);
+  [[nodiscard]] bool mayMatch(u32 index, const FloatPredicate& predicate);
+  // The bloom filter over the distinct values of the chunk, if it was written
+  // with BtrBlocksConfig::bloom_filters. mayMatch consults it for EQUAL and IN.
+  [[nodiscard]] std::optional<BloomFilter> getBloomFilter(u32 index);
+  // false means that the chunk does not contain the value. Chunks without a
+  // bloom filter always may contain it.
+  [[nodiscard]] bool mayContain(u32 index, INTEGER value);
+  [[nodiscard]] bool mayContain(u32 index, DOUBLE value);
+  [[nodiscard]] bool mayContain(u32 index, str value);
+  [[nodiscard]] bool mayContain(u32 index, BIGINT value);
+  [[nodiscard]] bool mayContain(u32 index, FLOAT value);
   [[nodiscard]] string getSchemeDescription(u32 index);
   [[nodiscard]] string getBasicSchemeDescription(u32 index);
 
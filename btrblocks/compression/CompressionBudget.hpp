@@ -0,0 +1,53 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <chrono>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// The wall time the thread may still spend on its current block, see
+// BtrBlocksConfig::budget. Without a budget nothing is ever exhausted. Once the
+// budget is spent, the scheme picker stops estimating, compresses the rest of
+// the block without further cascades, and expensive schemes give up.
+class CompressionBudget {
+ public:
+  using Clock = std::chrono::steady_clock;
+  // -------------------------------------------------------------------------------------
+  // Starts the budget of a block, a block compressed within another one
+  // shares the budget of the outer one
+  class Scope {
+   public:
+    explicit Scope(u64 microseconds) : owner(microseconds > 0 && !current().active) {
+      if (owner) {
+        current().deadline = Clock::now() + std::chrono::microseconds(microseconds);
+        current().active = true;
+      }
+    }
+    ~Scope() {
+      if (owner) {
+        current().active = false;
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const bool owner;
+  };
+  // -------------------------------------------------------------------------------------
+  static bool isActive() { return current().active; }
+  static bool isExhausted() { return current().active && Clock::now() >= current().deadline; }
+  // The budget of this thread, worker threads copy the one of their caller
+  static CompressionBudget& current() {
+    thread_local CompressionBudget budget;
+    return budget;
+  }
+
+ private:
+  Clock::time_point deadline;
+  bool active = false;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
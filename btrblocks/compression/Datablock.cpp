@@ -7,6 +7,9 @@
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
 #include "cache/ThreadCache.hpp"
+#include "compression/BloomFilter.hpp"
+#include "compression/CompressionBudget.hpp"
+#include "compression/Metrics.hpp"
 #include "compression/SchemePicker.hpp"
 #include "scheme/CompressionScheme.hpp"
 #include "scheme/SchemePool.hpp"
@@ -23,7 +26,8 @@
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
-Datablock::Datablock(const Relation& relation) : RelationCompressor(relation) {}
+Datablock::Datablock(const Relation& relation)
+    : RelationCompressor(relation), decision_caches(relation.columns.size()) {}
 u32 Datablock::writeMetadata(const std::string& path,
                              std::vector<ColumnType> types,
                              vector<u32> part_counters,
@@ -55,49 +59,208 @@ std::vector<u8> Datablock::compress(const InputChunk& input_chunk) {
   // We do not now the exact output size. Therefore we allocate too much and
   // then simply make the space smaller afterwards
   const u32 size =
-      sizeof(ColumnChunkMeta) + 10 * input_chunk.size + sizeof(BITMAP) * input_chunk.tuple_count;
-  std::vector<u8> output(size);
+      sizeof(ColumnChunkMeta) + 10 * input_chunk.size + sizeof(ColumnZoneMap) +
+      sizeof(BITMAP) * input_chunk.tuple_count;
+  const u32 bloom_filter_size =
+      BtrBlocksConfig::get().bloom_filters
+          ? BloomFilter::blockCount(input_chunk.tuple_count,
+                                    BtrBlocksConfig::get().bloom_filter_bits) *
+                    BloomFilter::BLOCK_SIZE +
+                sizeof(u32)
+          : 0;
+  std::vector<u8> output(size + bloom_filter_size);
   auto total_size = compress(input_chunk, output.data());
   // Resize the output vector to the actual used size
   output.resize(total_size);
   return output;
 }
 // -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Returns false if the values cannot be described by a zone map (NaN)
+template <typename T>
+bool buildZoneMap(const T* src, const BITMAP* nullmap, u32 tuple_count, ColumnZoneMap& zone_map) {
+  T min{}, max{};
+  u32 null_count = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    if (nullmap != nullptr && !nullmap[row_i]) {
+      null_count++;
+      continue;
+    }
+    const T value = src[row_i];
+    if (value != value) {
+      return false;
+    }
+    if (null_count == row_i) {
+      min = max = value;
+    }
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+  zone_map.null_count = null_count;
+  zone_map.min_length = zone_map.max_length = sizeof(T);
+  std::memcpy(zone_map.min, &min, sizeof(T));
+  std::memcpy(zone_map.max, &max, sizeof(T));
+  return true;
+}
+// -------------------------------------------------------------------------------------
+bool buildZoneMap(const StringArrayViewer src,
+                  const BITMAP* nullmap,
+                  u32 tuple_count,
+                  ColumnZoneMap& zone_map) {
+  str min, max;
+  u32 null_count = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    if (nullmap != nullptr && !nullmap[row_i]) {
+      null_count++;
+      continue;
+    }
+    const str value = src(row_i);
+    if (null_count == row_i) {
+      min = max = value;
+    }
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+  zone_map.null_count = null_count;
+  // A prefix of the minimum is still a lower bound
+  zone_map.min_length = std::min<size_t>(min.length(), ColumnZoneMap::STRING_PREFIX);
+  std::memcpy(zone_map.min, min.data(), zone_map.min_length);
+  // The maximum has to be rounded up to the next prefix when it is cut off
+  zone_map.max_length = std::min<size_t>(max.length(), ColumnZoneMap::STRING_PREFIX);
+  std::memcpy(zone_map.max, max.data(), zone_map.max_length);
+  if (max.length() > ColumnZoneMap::STRING_PREFIX) {
+    while (zone_map.max_length > 0 && zone_map.max[zone_map.max_length - 1] == 0xFF) {
+      zone_map.max_length--;
+    }
+    if (zone_map.max_length == 0) {
+      zone_map.max_length = ColumnZoneMap::UNBOUNDED;
+    } else {
+      zone_map.max[zone_map.max_length - 1]++;
+    }
+  }
+  return true;
+}
+// -------------------------------------------------------------------------------------
+// Schemes that need the distinct strings make the stats exact themselves
+StringStats generateStringStats(const StringArrayViewer src,
+                                const BITMAP* nullmap,
+                                u32 tuple_count,
+                                SIZE column_data_size) {
+  auto& cfg = BtrBlocksConfig::get();
+  if (cfg.statistics == StatisticsMode::APPROXIMATE) {
+    return StringStats::generateApproximateStats(src, nullmap, tuple_count, column_data_size,
+                                                 cfg.sample_count, cfg.sample_size);
+  }
+  return StringStats::generateStats(src, nullmap, tuple_count, column_data_size);
+}
+// -------------------------------------------------------------------------------------
+// Writes the blocks followed by their count, returns the number of bytes
+// written. project maps an entry of distinct_values to the value.
+template <typename Container, typename Projection>
+u32 writeBloomFilter(const Container& distinct_values, Projection project, u8* dest) {
+  const u32 block_count =
+      BloomFilter::blockCount(distinct_values.size(), BtrBlocksConfig::get().bloom_filter_bits);
+  std::memset(dest, 0, block_count * BloomFilter::BLOCK_SIZE);
+  for (const auto& entry : distinct_values) {
+    BloomFilter::insert(dest, block_count, BloomFilter::hash(project(entry)));
+  }
+  std::memcpy(dest + block_count * BloomFilter::BLOCK_SIZE, &block_count, sizeof(block_count));
+  return block_count * BloomFilter::BLOCK_SIZE + sizeof(block_count);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
 SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
   auto& cfg = BtrBlocksConfig::get();
+  CompressionBudget::Scope budget(cfg.budget.block_microseconds);
   auto meta = reinterpret_cast<ColumnChunkMeta*>(output);
   meta->tuple_count = input_chunk.tuple_count;
   meta->type = input_chunk.type;
+  meta->sections = 0;
 
   auto output_data = meta->data;
+  // Filled in by the type specific branch if bloom filters are enabled
+  u32 bloom_filter_size = 0;
+  auto bloom_filter = [&](const auto& distinct_values) {
+    return writeBloomFilter(
+        distinct_values,
+        [](const auto& entry) {
+          if constexpr (std::is_same_v<std::decay_t<decltype(entry)>, str>) {
+            return entry;
+          } else {
+            return entry.first;
+          }
+        },
+        output_data + meta->nullmap_offset);
+  };
 
   switch (input_chunk.type) {
     case ColumnType::INTEGER: {
-      IntegerSchemePicker::compress(reinterpret_cast<INTEGER*>(input_chunk.data.get()),
-                                    input_chunk.nullmap.get(), output_data, input_chunk.tuple_count,
+      auto src = reinterpret_cast<INTEGER*>(input_chunk.data.get());
+      auto stats = IntegerSchemePicker::generateStats(src, input_chunk.nullmap.get(),
+                                                      input_chunk.tuple_count);
+      IntegerSchemePicker::compress(src, input_chunk.nullmap.get(), output_data, stats,
                                     cfg.integers.max_cascade_depth, meta->nullmap_offset,
                                     meta->compression_type);
+      if (cfg.bloom_filters) {
+        stats.makeExact();
+        bloom_filter_size = bloom_filter(stats.distinct_values.entries());
+      }
       break;
     }
     case ColumnType::DOUBLE: {
       // -------------------------------------------------------------------------------------
-      DoubleSchemePicker::compress(reinterpret_cast<DOUBLE*>(input_chunk.data.get()),
-                                   input_chunk.nullmap.get(), output_data, input_chunk.tuple_count,
+      auto src = reinterpret_cast<DOUBLE*>(input_chunk.data.get());
+      auto stats = DoubleSchemePicker::generateStats(src, input_chunk.nullmap.get(),
+                                                     input_chunk.tuple_count);
+      DoubleSchemePicker::compress(src, input_chunk.nullmap.get(), output_data, stats,
                                    cfg.doubles.max_cascade_depth, meta->nullmap_offset,
                                    meta->compression_type);
+      if (cfg.bloom_filters) {
+        stats.makeExact();
+        bloom_filter_size = bloom_filter(stats.distinct_values.entries());
+      }
       // -------------------------------------------------------------------------------------
       break;
     }
+    case ColumnType::BIGINT: {
+      auto src = reinterpret_cast<BIGINT*>(input_chunk.data.get());
+      auto stats = BigIntSchemePicker::generateStats(src, input_chunk.nullmap.get(),
+                                                     input_chunk.tuple_count);
+      BigIntSchemePicker::compress(src, input_chunk.nullmap.get(), output_data, stats,
+                                   cfg.bigints.max_cascade_depth, meta->nullmap_offset,
+                                   meta->compression_type);
+      if (cfg.bloom_filters) {
+        stats.makeExact();
+        bloom_filter_size = bloom_filter(stats.distinct_values.entries());
+      }
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto src = reinterpret_cast<FLOAT*>(input_chunk.data.get());
+      auto stats = FloatSchemePicker::generateStats(src, input_chunk.nullmap.get(),
+                                                    input_chunk.tuple_count);
+      FloatSchemePicker::compress(src, input_chunk.nullmap.get(), output_data, stats,
+                                  cfg.floats.max_cascade_depth, meta->nullmap_offset,
+                                  meta->compression_type);
+      if (cfg.bloom_filters) {
+        stats.makeExact();
+        bloom_filter_size = bloom_filter(stats.distinct_values.entries());
+      }
+      break;
+    }
     case ColumnType::STRING: {
       // -------------------------------------------------------------------------------------
+      const u64 start_ns = Metrics::now();
       // Collect stats
-      StringStats stats = StringStats::generateStats(StringArrayViewer(input_chunk.data.get()),
-                                                     input_chunk.nullmap.get(),
-                                                     input_chunk.tuple_count, input_chunk.size);
+      StringStats stats = generateStringStats(StringArrayViewer(input_chunk.data.get()),
+                                              input_chunk.nullmap.get(), input_chunk.tuple_count,
+                                              input_chunk.size);
       // -------------------------------------------------------------------------------------
       // Make decisions
       StringScheme& preferred_scheme =
-          StringSchemePicker::chooseScheme(stats, cfg.strings.max_cascade_depth);
+          StringSchemePicker::chooseOrReuseScheme(stats, cfg.strings.max_cascade_depth);
       // Update meta data
       meta->compression_type = static_cast<u8>(preferred_scheme.schemeType());
       // -------------------------------------------------------------------------------------
@@ -124,7 +287,18 @@ SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
                                 (ThreadCache::hasUsedFsst() ? "_FSST" : ""),
                             estimated_cf, stats.total_size, after_column_size, stats.unique_count,
                             "?");
+      if (Metrics::isEnabled()) {
+        Metrics::recordCompression(
+            ColumnType::STRING, CB(preferred_scheme.schemeType()),
+            ThreadCache::get().compression_level, stats.total_size, after_column_size,
+            preferred_scheme.expectedCompressionRatio(stats, cfg.strings.max_cascade_depth),
+            Metrics::now() - start_ns);
+      }
       ThreadCache::get().compression_level--;
+      if (cfg.bloom_filters) {
+        stats.makeExact();
+        bloom_filter_size = bloom_filter(stats.distinct_values.entries());
+      }
       // -------------------------------------------------------------------------------------
       break;
     }
@@ -132,6 +306,50 @@ SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
       throw Generic_Exception("Type not supported");
   }
 
+  // Bloom filter, already written behind the data
+  if (bloom_filter_size > 0) {
+    meta->sections |= static_cast<u8>(ChunkSection::BLOOM_FILTER);
+    meta->nullmap_offset += bloom_filter_size;
+  }
+
+  // Zone map
+  if (cfg.zone_maps) {
+    auto& zone_map = *reinterpret_cast<ColumnZoneMap*>(output_data + meta->nullmap_offset);
+    std::memset(&zone_map, 0, sizeof(ColumnZoneMap));
+    const BITMAP* nullmap = input_chunk.nullmap.get();
+    bool has_zone_map;
+    switch (input_chunk.type) {
+      case ColumnType::INTEGER:
+        has_zone_map =
+            buildZoneMap(reinterpret_cast<const INTEGER*>(input_chunk.data.get()), nullmap,
+                         input_chunk.tuple_count, zone_map);
+        break;
+      case ColumnType::DOUBLE:
+        has_zone_map = buildZoneMap(reinterpret_cast<const DOUBLE*>(input_chunk.data.get()),
+                                    nullmap, input_chunk.tuple_count, zone_map);
+        break;
+      case ColumnType::BIGINT:
+        has_zone_map = buildZoneMap(reinterpret_cast<const BIGINT*>(input_chunk.data.get()),
+                                    nullmap, input_chunk.tuple_count, zone_map);
+        break;
+      case ColumnType::FLOAT:
+        has_zone_map = buildZoneMap(reinterpret_cast<const FLOAT*>(input_chunk.data.get()),
+                                    nullmap, input_chunk.tuple_count, zone_map);
+        break;
+      case ColumnType::STRING:
+        has_zone_map = buildZoneMap(StringArrayViewer(input_chunk.data.get()), nullmap,
+                                    input_chunk.tuple_count, zone_map);
+        break;
+      default:
+        has_zone_map = false;
+        break;
+    }
+    if (has_zone_map) {
+      meta->sections |= static_cast<u8>(ChunkSection::ZONE_MAP);
+      meta->nullmap_offset += sizeof(ColumnZoneMap);
+    }
+  }
+
   // Compress bitmap
   auto [nullmap_size, bitmap_type] = bitmap::RoaringBitmap::compress(
       input_chunk.nullmap.get(), output_data + meta->nullmap_offset, input_chunk.tuple_count);
@@ -175,6 +393,22 @@ bool Datablock::decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* da
       requires_copy_out = false;
       break;
     }
+    case ColumnType::BIGINT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->bigint_schemes[static_cast<BigIntSchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<BIGINT*>(data_out), *bitmap_out, meta->data,
+                         meta->tuple_count, 0);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->float_schemes[static_cast<FloatSchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<FLOAT*>(data_out), *bitmap_out, meta->data,
+                         meta->tuple_count, 0);
+      requires_copy_out = false;
+      break;
+    }
     case ColumnType::STRING: {
       auto& scheme = SchemePool::available_schemes
                          ->string_schemes[static_cast<StringSchemeType>(meta->compression_type)];
@@ -228,6 +462,8 @@ OutputBlockStats Datablock::compress(const Chunk& input_chunk, BytesArray& outpu
     // -------------------------------------------------------------------------------------
     Log::info("DB: compressing column : {}", column.name);
     ThreadCache::dumpSet(relation.name, column.name, ConvertTypeToString(column.type));
+    SchemeDecisionCache::Scope decisions(decision_caches[column_i]);
+    Metrics::ColumnScope metrics(column.name);
     // -------------------------------------------------------------------------------------
     switch (column.type) {
       case ColumnType::INTEGER: {
@@ -253,16 +489,31 @@ OutputBlockStats Datablock::compress(const Chunk& input_chunk, BytesArray& outpu
         // -------------------------------------------------------------------------------------
         break;
       }
+      case ColumnType::BIGINT: {
+        BigIntSchemePicker::compress(
+            input_chunk.array<BIGINT>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.bigints.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
+      case ColumnType::FLOAT: {
+        FloatSchemePicker::compress(
+            input_chunk.array<FLOAT>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.floats.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
       case ColumnType::STRING: {
         // -------------------------------------------------------------------------------------
+        const u64 start_ns = Metrics::now();
         // Collect stats
-        StringStats stats = StringStats::generateStats(
+        StringStats stats = generateStringStats(
             StringArrayViewer(input_chunk.array<const u8>(column_i)), input_chunk.nullmap(column_i),
             input_chunk.tuple_count, input_chunk.size(column_i));
         // -------------------------------------------------------------------------------------
         // Make decisions
         StringScheme& preferred_scheme =
-            StringSchemePicker::chooseScheme(stats, cfg.strings.max_cascade_depth);
+            StringSchemePicker::chooseOrReuseScheme(stats, cfg.strings.max_cascade_depth);
         // Update meta data
         column_meta.compression_type = static_cast<u8>(preferred_scheme.schemeType());
         // -------------------------------------------------------------------------------------
@@ -288,6 +539,13 @@ OutputBlockStats Datablock::compress(const Chunk& input_chunk, BytesArray& outpu
                                   (ThreadCache::hasUsedFsst() ? "_FSST" : ""),
                               estimated_cf, stats.total_size, after_column_size, stats.unique_count,
                               "?");
+        if (Metrics::isEnabled()) {
+          Metrics::recordCompression(
+              ColumnType::STRING, CB(preferred_scheme.schemeType()),
+              ThreadCache::get().compression_level, stats.total_size, after_column_size,
+              preferred_scheme.expectedCompressionRatio(stats, cfg.strings.max_cascade_depth),
+              Metrics::now() - start_ns);
+        }
         ThreadCache::get().compression_level--;
         // -------------------------------------------------------------------------------------
         break;
@@ -389,6 +647,26 @@ btrblocks::Chunk Datablock::decompress(const BytesArray& input_db) {
         column_requires_copy[column_i] = false;
         break;
       }
+      case ColumnType::BIGINT: {
+        sizes[column_i] = sizeof(BIGINT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(BIGINT) * tuple_count + SIMD_EXTRA_BYTES);
+        auto destination_array = reinterpret_cast<BIGINT*>(columns[column_i].get());
+        auto& scheme = BigIntSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::FLOAT: {
+        sizes[column_i] = sizeof(FLOAT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(FLOAT) * tuple_count + SIMD_EXTRA_BYTES);
+        auto destination_array = reinterpret_cast<FLOAT*>(columns[column_i].get());
+        auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
       case ColumnType::STRING: {
         // -------------------------------------------------------------------------------------
         const auto used_compression_scheme =
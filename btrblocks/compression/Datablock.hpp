@@ -1,25 +1,78 @@
 #pragma once
 // -------------------------------------------------------------------------------------
 #include "compression/Compressor.hpp"
+#include "compression/SchemeDecisionCache.hpp"
 #include "scheme/CompressionScheme.hpp"
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
+#include <cstring>
+#include <type_traits>
 #include <unordered_map>
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
 // Begin new chunking
+// Optional parts of a chunk, stored as bits in ColumnChunkMeta::sections.
+// They lie between the data and the nullmap in the order
+// [data][bloom filter blocks][u32 block count][zone map][nullmap].
+enum class ChunkSection : u8 { ZONE_MAP = 1, BLOOM_FILTER = 2 };
+
 struct ColumnChunkMeta {
   u8 compression_type;
   BitmapType nullmap_type;
   ColumnType type;
-  // There is 1 unused Bytes here.
+  u8 sections = 0;
   u32 nullmap_offset = 0;
   u32 tuple_count;
   u8 data[];
+
+  [[nodiscard]] inline bool hasSection(ChunkSection section) const {
+    return (sections & static_cast<u8>(section)) != 0;
+  }
 };
 static_assert(sizeof(ColumnChunkMeta) == 12);
 
+// Written between the compressed data and the nullmap, so that it can be
+// found from nullmap_offset alone. min and max bound the non-null values.
+// Numbers are stored as is, strings as a prefix of at most
+// STRING_PREFIX bytes; a cut off maximum is rounded up to the next prefix so
+// that it still is an upper bound.
+struct ColumnZoneMap {
+  static constexpr u32 STRING_PREFIX = 8;
+  static constexpr u8 UNBOUNDED = 0xFF;  // max_length if there is no upper bound
+
+  u32 null_count;
+  u8 min_length;  // strings only
+  u8 max_length;  // strings only
+  // There are 2 unused bytes here.
+  u8 min[STRING_PREFIX];
+  u8 max[STRING_PREFIX];
+
+  [[nodiscard]] inline bool hasMax() const { return max_length != UNBOUNDED; }
+  template <typename T>
+  [[nodiscard]] inline T getMin() const {
+    return get<T>(min, min_length);
+  }
+  template <typename T>
+  [[nodiscard]] inline T getMax() const {
+    return get<T>(max, max_length);
+  }
+
+ private:
+  template <typename T>
+  [[nodiscard]] static inline T get(const u8* bytes, u8 length) {
+    if constexpr (std::is_same_v<T, str>) {
+      return str(reinterpret_cast<const char*>(bytes), length == UNBOUNDED ? 0 : length);
+    } else {
+      static_assert(sizeof(T) <= STRING_PREFIX);
+      T value;
+      std::memcpy(&value, bytes, sizeof(T));
+      return value;
+    }
+  }
+};
+static_assert(sizeof(ColumnZoneMap) == 24);
+
 struct ColumnPartInfo {
   ColumnType type;
   // There are 3 unused bytes here.
@@ -57,6 +110,9 @@ static_assert(sizeof(DatablockMeta) == 16);
 class Datablock : public RelationCompressor {
  public:
   explicit Datablock(const Relation& relation);
+  // Updates the scheme decisions of the columns, so the chunks of one
+  // Datablock have to be compressed one after the other. Compress
+  // concurrently with one Datablock per thread.
   OutputBlockStats compress(const Chunk& input_chunk, BytesArray& output_block) override;
   Chunk decompress(const BytesArray& input_block) override;
   virtual void getCompressedColumn(const BytesArray& input_db, u32 col_i, u8*& ptr, u32& size);
@@ -69,6 +125,10 @@ class Datablock : public RelationCompressor {
                            u32 num_chunks);
 
   static SIZE compress(const InputChunk& input_chunk, u8* output_buffer);
+
+ private:
+  // One per column, the chunks of a relation are compressed in order
+  vector<SchemeDecisionCache> decision_caches;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks
@@ -0,0 +1,232 @@
+// -------------------------------------------------------------------------------------
+#include "Metrics.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "common/Exceptions.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <sstream>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+constexpr ColumnType METRIC_TYPES[] = {ColumnType::INTEGER, ColumnType::DOUBLE,
+                                       ColumnType::STRING, ColumnType::FLOAT,
+                                       ColumnType::BIGINT};
+// -------------------------------------------------------------------------------------
+string schemeName(ColumnType type, u8 scheme_code) {
+  switch (type) {
+    case ColumnType::INTEGER:
+      return ConvertSchemeTypeToString(static_cast<IntegerSchemeType>(scheme_code));
+    case ColumnType::DOUBLE:
+      return ConvertSchemeTypeToString(static_cast<DoubleSchemeType>(scheme_code));
+    case ColumnType::FLOAT:
+      return ConvertSchemeTypeToString(static_cast<FloatSchemeType>(scheme_code));
+    case ColumnType::BIGINT:
+      return ConvertSchemeTypeToString(static_cast<BigIntSchemeType>(scheme_code));
+    default:
+      return ConvertSchemeTypeToString(static_cast<StringSchemeType>(scheme_code));
+  }
+}
+// -------------------------------------------------------------------------------------
+// Column names come from the schema, quotes and backslashes have to be escaped
+// for both JSON and Prometheus label values
+string escape(const string& value) {
+  string escaped;
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+// -------------------------------------------------------------------------------------
+double ratio(u64 before, u64 after) {
+  return after == 0 ? 0 : CD(before) / CD(after);
+}
+// -------------------------------------------------------------------------------------
+struct CounterField {
+  const char* name;
+  std::atomic<u64> Metrics::SchemeCounters::*counter;
+  const char* prometheus_type;
+  const char* help;
+};
+// clang-format off
+constexpr CounterField COUNTER_FIELDS[] = {
+    {"compressed_chunks", &Metrics::SchemeCounters::compressed_chunks, "counter", "Chunks compressed with the scheme"},
+    {"bytes_in", &Metrics::SchemeCounters::bytes_in, "counter", "Bytes given to the scheme"},
+    {"bytes_out", &Metrics::SchemeCounters::bytes_out, "counter", "Bytes the scheme compressed them to"},
+    {"estimated_bytes_out", &Metrics::SchemeCounters::estimated_bytes_out, "counter", "Bytes the estimated compression ratio promised"},
+    {"compression_ns", &Metrics::SchemeCounters::compression_ns, "counter", "Nanoseconds spent choosing and compressing, including the cascade"},
+    {"cascade_depth_sum", &Metrics::SchemeCounters::cascade_depth_sum, "counter", "Sum of the cascade depths the scheme was used at"},
+    {"max_cascade_depth", &Metrics::SchemeCounters::max_cascade_depth, "gauge", "Deepest cascade level the scheme was used at"},
+    {"decompressed_chunks", &Metrics::SchemeCounters::decompressed_chunks, "counter", "Chunks decompressed with the scheme"},
+    {"decompressed_bytes", &Metrics::SchemeCounters::decompressed_bytes, "counter", "Bytes the decompressed chunks have"},
+    {"decompression_ns", &Metrics::SchemeCounters::decompression_ns, "counter", "Nanoseconds spent decompressing"},
+};
+// clang-format on
+// -------------------------------------------------------------------------------------
+// Calls f(column, type, scheme_code, counters) for every counter set in use
+template <typename F>
+void forEachUsed(std::deque<Metrics::ColumnCounters>& columns, F&& f) {
+  for (auto& column : columns) {
+    for (auto type : METRIC_TYPES) {
+      for (u32 scheme_code = 0; scheme_code < Metrics::SCHEME_COUNT; scheme_code++) {
+        auto& counters =
+            column.schemes[static_cast<u32>(type) * Metrics::SCHEME_COUNT + scheme_code];
+        if (counters.compressed_chunks.load(std::memory_order_relaxed) > 0 ||
+            counters.decompressed_chunks.load(std::memory_order_relaxed) > 0) {
+          f(column, type, static_cast<u8>(scheme_code), counters);
+        }
+      }
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+std::mutex Metrics::columns_mutex;
+// -------------------------------------------------------------------------------------
+std::deque<Metrics::ColumnCounters>& Metrics::columns() {
+  static std::deque<ColumnCounters> columns;
+  return columns;
+}
+// -------------------------------------------------------------------------------------
+Metrics::ColumnCounters*& Metrics::current() {
+  thread_local ColumnCounters* current = nullptr;
+  return current;
+}
+// -------------------------------------------------------------------------------------
+Metrics::ColumnScope::ColumnScope(const string& column_name) : previous(current()) {
+  current() = isEnabled() ? &column(column_name) : nullptr;
+}
+// -------------------------------------------------------------------------------------
+Metrics::ColumnScope::~ColumnScope() {
+  current() = previous;
+}
+// -------------------------------------------------------------------------------------
+u32& Metrics::suspended() {
+  thread_local u32 suspended = 0;
+  return suspended;
+}
+// -------------------------------------------------------------------------------------
+bool Metrics::isEnabled() {
+  return BtrBlocksConfig::get().metrics && suspended() == 0;
+}
+// -------------------------------------------------------------------------------------
+Metrics::ColumnCounters& Metrics::column(const string& name) {
+  std::lock_guard<std::mutex> guard(columns_mutex);
+  for (auto& column : columns()) {
+    if (column.name == name) {
+      return column;
+    }
+  }
+  return columns().emplace_back(name);
+}
+// -------------------------------------------------------------------------------------
+Metrics::SchemeCounters& Metrics::counters(ColumnType type, u8 scheme_code) {
+  if (type != ColumnType::INTEGER && type != ColumnType::DOUBLE && type != ColumnType::STRING &&
+      type != ColumnType::FLOAT && type != ColumnType::BIGINT) {
+    throw Generic_Exception("No metrics for this type");
+  }
+  if (scheme_code >= SCHEME_COUNT) {
+    throw Generic_Exception("Unknown scheme code " + std::to_string(scheme_code));
+  }
+  auto column_counters = current();
+  if (column_counters == nullptr) {
+    static ColumnCounters& unnamed = column("");
+    column_counters = &unnamed;
+  }
+  return column_counters->schemes[static_cast<u32>(type) * SCHEME_COUNT + scheme_code];
+}
+// -------------------------------------------------------------------------------------
+void Metrics::recordCompression(ColumnType type,
+                                u8 scheme_code,
+                                u32 cascade_depth,
+                                u64 bytes_in,
+                                u64 bytes_out,
+                                double estimated_ratio,
+                                u64 nanoseconds) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  auto& scheme = counters(type, scheme_code);
+  scheme.compressed_chunks.fetch_add(1, relaxed);
+  scheme.bytes_in.fetch_add(bytes_in, relaxed);
+  scheme.bytes_out.fetch_add(bytes_out, relaxed);
+  if (estimated_ratio > 0) {
+    scheme.estimated_bytes_out.fetch_add(std::llround(bytes_in / estimated_ratio), relaxed);
+  }
+  scheme.compression_ns.fetch_add(nanoseconds, relaxed);
+  scheme.cascade_depth_sum.fetch_add(cascade_depth, relaxed);
+  u64 max_depth = scheme.max_cascade_depth.load(relaxed);
+  while (max_depth < cascade_depth &&
+         !scheme.max_cascade_depth.compare_exchange_weak(max_depth, cascade_depth, relaxed)) {
+  }
+}
+// -------------------------------------------------------------------------------------
+void Metrics::recordDecompression(ColumnType type, u8 scheme_code, u64 bytes, u64 nanoseconds) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  auto& scheme = counters(type, scheme_code);
+  scheme.decompressed_chunks.fetch_add(1, relaxed);
+  scheme.decompressed_bytes.fetch_add(bytes, relaxed);
+  scheme.decompression_ns.fetch_add(nanoseconds, relaxed);
+}
+// -------------------------------------------------------------------------------------
+string Metrics::toJson() {
+  std::lock_guard<std::mutex> guard(columns_mutex);
+  std::ostringstream json;
+  json << "{\"schemes\":[";
+  bool first = true;
+  forEachUsed(columns(), [&](const ColumnCounters& column, ColumnType type, u8 scheme_code,
+                             const SchemeCounters& counters) {
+    json << (first ? "" : ",") << "{\"column\":\"" << escape(column.name) << "\",\"type\":\""
+         << ConvertTypeToString(type) << "\",\"scheme\":\"" << schemeName(type, scheme_code)
+         << '"';
+    for (const auto& field : COUNTER_FIELDS) {
+      json << ",\"" << field.name << "\":" << (counters.*field.counter).load();
+    }
+    json << ",\"estimated_ratio\":" << ratio(counters.bytes_in, counters.estimated_bytes_out)
+         << ",\"actual_ratio\":" << ratio(counters.bytes_in, counters.bytes_out) << '}';
+    first = false;
+  });
+  json << "]}";
+  return json.str();
+}
+// -------------------------------------------------------------------------------------
+string Metrics::toPrometheus() {
+  std::lock_guard<std::mutex> guard(columns_mutex);
+  std::ostringstream text;
+  for (const auto& field : COUNTER_FIELDS) {
+    // Counters end in _total by convention
+    const string name = string("btrblocks_") + field.name +
+                        (string(field.prometheus_type) == "counter" ? "_total" : "");
+    text << "# HELP " << name << ' ' << field.help << '\n';
+    text << "# TYPE " << name << ' ' << field.prometheus_type << '\n';
+    forEachUsed(columns(), [&](const ColumnCounters& column, ColumnType type, u8 scheme_code,
+                               const SchemeCounters& counters) {
+      text << name << "{column=\"" << escape(column.name) << "\",type=\""
+           << ConvertTypeToString(type) << "\",scheme=\"" << schemeName(type, scheme_code)
+           << "\"} " << (counters.*field.counter).load() << '\n';
+    });
+  }
+  return text.str();
+}
+// -------------------------------------------------------------------------------------
+void Metrics::reset() {
+  std::lock_guard<std::mutex> guard(columns_mutex);
+  for (auto& column : columns()) {
+    for (auto& counters : column.schemes) {
+      for (const auto& field : COUNTER_FIELDS) {
+        (counters.*field.counter).store(0);
+      }
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
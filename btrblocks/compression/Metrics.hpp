@@ -0,0 +1,95 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/SchemeType.hpp"
+// -------------------------------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Counters of what the schemes did, recorded while BtrBlocksConfig::metrics
+// is set. Every column has a counter set per scheme, columns compressed
+// outside of a ColumnScope count towards the column "". Threads add to the
+// counters with relaxed atomics, only registering a column takes a lock.
+class Metrics {
+ public:
+  static constexpr u32 SCHEME_COUNT = static_cast<u32>(IntegerSchemeType::SCHEME_MAX);
+  // -------------------------------------------------------------------------------------
+  struct SchemeCounters {
+    std::atomic<u64> compressed_chunks{0};
+    std::atomic<u64> bytes_in{0};
+    std::atomic<u64> bytes_out{0};
+    std::atomic<u64> estimated_bytes_out{0};  // bytes_in / estimated ratio
+    std::atomic<u64> compression_ns{0};       // including the cascade below the scheme
+    std::atomic<u64> cascade_depth_sum{0};    // 1 for the top level of a chunk
+    std::atomic<u64> max_cascade_depth{0};
+    std::atomic<u64> decompressed_chunks{0};
+    std::atomic<u64> decompressed_bytes{0};
+    std::atomic<u64> decompression_ns{0};
+  };
+  struct ColumnCounters {
+    explicit ColumnCounters(string name) : name(std::move(name)) {}
+    const string name;
+    // Indexed by the column type, up to BIGINT
+    std::array<SchemeCounters, (static_cast<u32>(ColumnType::BIGINT) + 1) * SCHEME_COUNT> schemes;
+  };
+  // -------------------------------------------------------------------------------------
+  // Attributes the chunks compressed or decompressed on this thread to a column
+  class ColumnScope {
+   public:
+    explicit ColumnScope(const string& column_name);
+    ~ColumnScope();
+    ColumnScope(const ColumnScope&) = delete;
+    ColumnScope& operator=(const ColumnScope&) = delete;
+
+   private:
+    ColumnCounters* previous;
+  };
+  // Nothing is recorded on this thread while it lives, e.g. for the chunks
+  // that TRY_ALL compresses only to compare their sizes
+  class Suspend {
+   public:
+    Suspend() { suspended()++; }
+    ~Suspend() { suspended()--; }
+    Suspend(const Suspend&) = delete;
+    Suspend& operator=(const Suspend&) = delete;
+  };
+  // -------------------------------------------------------------------------------------
+  static bool isEnabled();
+  static ColumnCounters& column(const string& name);
+  // -------------------------------------------------------------------------------------
+  static void recordCompression(ColumnType type,
+                                u8 scheme_code,
+                                u32 cascade_depth,
+                                u64 bytes_in,
+                                u64 bytes_out,
+                                double estimated_ratio,
+                                u64 nanoseconds);
+  static void recordDecompression(ColumnType type, u8 scheme_code, u64 bytes, u64 nanoseconds);
+  // -------------------------------------------------------------------------------------
+  // Only counters that saw a chunk are exported
+  static string toJson();
+  static string toPrometheus();
+  static void reset();
+  // -------------------------------------------------------------------------------------
+  static u64 now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+ private:
+  static SchemeCounters& counters(ColumnType type, u8 scheme_code);
+  static ColumnCounters*& current();
+  static u32& suspended();
+  // Columns are never removed, reset() only clears their counters
+  static std::deque<ColumnCounters>& columns();
+  static std::mutex columns_mutex;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
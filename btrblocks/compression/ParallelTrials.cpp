@@ -0,0 +1,85 @@
+// -------------------------------------------------------------------------------------
+#include "ParallelTrials.hpp"
+// -------------------------------------------------------------------------------------
+#include <memory>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+TrialPool& TrialPool::get() {
+  static TrialPool pool;
+  return pool;
+}
+// -------------------------------------------------------------------------------------
+TrialPool::~TrialPool() {
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    stopping = true;
+  }
+  wakeup.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+// -------------------------------------------------------------------------------------
+void TrialPool::workerLoop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeup.wait(lock, [&]() { return stopping || !jobs.empty(); });
+      if (jobs.empty()) {
+        return;
+      }
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+    job();
+  }
+}
+// -------------------------------------------------------------------------------------
+void TrialPool::run(u32 helpers,
+                    const std::function<void()>& helper,
+                    const std::function<void()>& caller) {
+  // Jobs may still be queued when run returns, they only reach helper while
+  // the caller waits for them
+  struct Run {
+    std::mutex mutex;
+    std::condition_variable finished;
+    const std::function<void()>* helper;
+    u32 running = 0;
+    bool closed = false;
+  };
+  auto state = std::make_shared<Run>();
+  state->helper = &helper;
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    while (threads.size() < helpers) {
+      threads.emplace_back([this]() { workerLoop(); });
+    }
+    for (u32 helper_i = 0; helper_i < helpers; helper_i++) {
+      jobs.emplace_back([state]() {
+        {
+          std::lock_guard<std::mutex> guard(state->mutex);
+          if (state->closed) {
+            return;
+          }
+          state->running++;
+        }
+        (*state->helper)();
+        std::lock_guard<std::mutex> guard(state->mutex);
+        if (--state->running == 0 && state->closed) {
+          state->finished.notify_all();
+        }
+      });
+    }
+  }
+  wakeup.notify_all();
+  // -------------------------------------------------------------------------------------
+  caller();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->closed = true;
+  state->finished.wait(lock, [&]() { return state->running == 0; });
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "cache/ThreadCache.hpp"
+#include "common/Units.hpp"
+#include "compression/CompressionBudget.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Threads that help with the trials of all callers. They are started on
+// demand and kept until exit, so their ThreadCache with its arena and level
+// buffers is built only once and logs on exit like the one of any thread.
+class TrialPool {
+ public:
+  static TrialPool& get();
+  ~TrialPool();
+  // Runs helper on up to `helpers` pool threads and caller on the calling
+  // thread. Returns once caller is done and no helper is running anymore,
+  // helpers that only start afterwards return right away.
+  void run(u32 helpers, const std::function<void()>& helper, const std::function<void()>& caller);
+  // -------------------------------------------------------------------------------------
+ private:
+  void workerLoop();
+  // -------------------------------------------------------------------------------------
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::deque<std::function<void()>> jobs;
+  vector<std::thread> threads;
+  bool stopping = false;
+};
+// -------------------------------------------------------------------------------------
+// Runs trial(i) for every i < count on up to `threads` threads, the calling
+// thread and threads of the TrialPool. The workers start at the cascade level and with the budget
+// of the caller, so that the schemes behave as if they ran on it, and allocate
+// from their own ThreadCache. Trials must only write to their own slot of the
+// results. If trials throw, the exception of the lowest i is rethrown.
+template <typename Trial>
+void runTrials(u32 count, u32 threads, const Trial& trial) {
+  const auto& caller = ThreadCache::get();
+  const u16 estimation_level = caller.estimation_level;
+  const u16 compression_level = caller.compression_level;
+  const CompressionBudget budget = CompressionBudget::current();
+  std::atomic<u32> next{0};
+  vector<std::exception_ptr> errors(count);
+  auto work = [&]() {
+    for (u32 i = next++; i < count; i = next++) {
+      try {
+        trial(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  // -------------------------------------------------------------------------------------
+  TrialPool::get().run(
+      std::min(threads, count) - 1,
+      [&]() {
+        auto& cache = ThreadCache::get();
+        cache.estimation_level = estimation_level;
+        cache.compression_level = compression_level;
+        CompressionBudget::current() = budget;
+        work();
+      },
+      work);
+  // -------------------------------------------------------------------------------------
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
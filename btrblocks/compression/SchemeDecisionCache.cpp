@@ -0,0 +1,83 @@
+// -------------------------------------------------------------------------------------
+#include "SchemeDecisionCache.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+thread_local SchemeDecisionCache* current_cache = nullptr;
+}  // namespace
+// -------------------------------------------------------------------------------------
+bool SchemeDecisionCache::Fingerprint::isCloseTo(const Fingerprint& other,
+                                                 double tolerance) const {
+  return range_exponent == other.range_exponent &&
+         magnitude_exponent == other.magnitude_exponent &&
+         unique_exponent == other.unique_exponent &&
+         std::abs(unique_ratio - other.unique_ratio) <= tolerance &&
+         std::abs(null_ratio - other.null_ratio) <= tolerance &&
+         std::abs(run_length - other.run_length) <=
+             tolerance * std::max(run_length, other.run_length);
+}
+// -------------------------------------------------------------------------------------
+SchemeDecisionCache::Scope::Scope(SchemeDecisionCache& cache) : previous(current_cache) {
+  cache.beginChunk();
+  current_cache = &cache;
+}
+// -------------------------------------------------------------------------------------
+SchemeDecisionCache::Scope::~Scope() {
+  current_cache = previous;
+}
+// -------------------------------------------------------------------------------------
+SchemeDecisionCache* SchemeDecisionCache::current() {
+  return current_cache;
+}
+// -------------------------------------------------------------------------------------
+void SchemeDecisionCache::beginChunk() {
+  const auto& cfg = BtrBlocksConfig::get().decision_cache;
+  cursor = 0;
+  revalidate = !cfg.enabled || chunk_count == 0 ||
+               (cfg.revalidation != 0 && chunk_count % cfg.revalidation == 0);
+  chunk_count++;
+}
+// -------------------------------------------------------------------------------------
+std::optional<u8> SchemeDecisionCache::lookup(ColumnType type,
+                                              u8 compression_level,
+                                              u8 allowed_cascading_level,
+                                              const Fingerprint& fingerprint) const {
+  if (revalidate || cursor >= decisions.size()) {
+    return std::nullopt;
+  }
+  const auto& decision = decisions[cursor];
+  if (decision.type != type || decision.compression_level != compression_level ||
+      decision.allowed_cascading_level != allowed_cascading_level ||
+      !fingerprint.isCloseTo(decision.fingerprint,
+                             BtrBlocksConfig::get().decision_cache.tolerance)) {
+    return std::nullopt;
+  }
+  return decision.scheme_code;
+}
+// -------------------------------------------------------------------------------------
+void SchemeDecisionCache::reuse() {
+  cursor++;
+  reused_count++;
+}
+// -------------------------------------------------------------------------------------
+void SchemeDecisionCache::record(ColumnType type,
+                                 u8 compression_level,
+                                 u8 allowed_cascading_level,
+                                 const Fingerprint& fingerprint,
+                                 u8 scheme_code) {
+  const Decision decision{type, compression_level, allowed_cascading_level, scheme_code,
+                          fingerprint};
+  if (cursor < decisions.size()) {
+    decisions[cursor] = decision;
+  } else {
+    decisions.push_back(decision);
+  }
+  cursor++;
+  estimated_count++;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "stats/NumberStats.hpp"
+#include "stats/StringStats.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <optional>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Remembers the schemes that were chosen for the previous chunk of a column,
+// in the order in which the cascade asked for them. As long as the cheap stats
+// of a chunk stay close to those of the chunk the decision was estimated on,
+// the scheme is reused instead of estimating every scheme again. Every
+// BtrBlocksConfig::decision_cache.revalidation-th chunk is estimated from
+// scratch, so that slow drift is noticed.
+// The chunks of a column have to be compressed one after another, each one
+// within a Scope of the column's cache.
+class SchemeDecisionCache {
+ public:
+  // The stats that decide which schemes are usable and how well they do.
+  // Exponents are compared exactly, so that every threshold on bit widths and
+  // dictionary sizes falls on the same side as for the original decision.
+  struct Fingerprint {
+    s32 range_exponent;      // of max - min, strings: of the total length
+    s32 magnitude_exponent;  // of the largest absolute value, strings: of the total length
+    s32 unique_exponent;
+    double unique_ratio;
+    double null_ratio;
+    double run_length;  // strings: average length
+    // -------------------------------------------------------------------------------------
+    [[nodiscard]] bool isCloseTo(const Fingerprint& other, double tolerance) const;
+  };
+  // -------------------------------------------------------------------------------------
+  template <typename T>
+  static Fingerprint fingerprint(const NumberStats<T>& stats) {
+    const double min = stats.min, max = stats.max;
+    return {exponent(max - min), exponent(std::max(std::abs(min), std::abs(max))),
+            exponent(stats.unique_count), ratio(stats.unique_count, stats.tuple_count),
+            ratio(stats.null_count, stats.tuple_count), CD(stats.average_run_length)};
+  }
+  static Fingerprint fingerprint(const StringStats& stats) {
+    return {exponent(stats.total_length), exponent(stats.total_length),
+            exponent(stats.unique_count), ratio(stats.unique_count, stats.tuple_count),
+            ratio(stats.null_count, stats.tuple_count),
+            ratio(stats.total_length, stats.tuple_count)};
+  }
+  // -------------------------------------------------------------------------------------
+  // Makes the cache the one of the current thread for one chunk
+  class Scope {
+   public:
+    explicit Scope(SchemeDecisionCache& cache);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    SchemeDecisionCache* previous;
+  };
+  // nullptr outside of a Scope
+  static SchemeDecisionCache* current();
+  // -------------------------------------------------------------------------------------
+  // The scheme chosen at this point of the cascade of the previous chunks, if
+  // it may be reused for stats with the given fingerprint. Either reuse() or
+  // record() has to follow.
+  std::optional<u8> lookup(ColumnType type,
+                           u8 compression_level,
+                           u8 allowed_cascading_level,
+                           const Fingerprint& fingerprint) const;
+  void reuse();
+  void record(ColumnType type,
+              u8 compression_level,
+              u8 allowed_cascading_level,
+              const Fingerprint& fingerprint,
+              u8 scheme_code);
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] inline u64 reusedCount() const { return reused_count; }
+  [[nodiscard]] inline u64 estimatedCount() const { return estimated_count; }
+
+ private:
+  struct Decision {
+    ColumnType type;
+    u8 compression_level;
+    u8 allowed_cascading_level;
+    u8 scheme_code;
+    Fingerprint fingerprint;  // of the chunk the scheme was estimated on
+  };
+  vector<Decision> decisions;
+  u32 cursor = 0;
+  u32 chunk_count = 0;
+  bool revalidate = true;
+  u64 reused_count = 0;
+  u64 estimated_count = 0;
+  // -------------------------------------------------------------------------------------
+  void beginChunk();
+  // -------------------------------------------------------------------------------------
+  static inline s32 exponent(double value) { return value == 0 ? -1 : std::ilogb(value); }
+  static inline double ratio(u32 count, u32 tuple_count) {
+    return tuple_count == 0 ? 0 : CD(count) / CD(tuple_count);
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -5,9 +5,14 @@
 #include "common/Utils.hpp"
 // -------------------------------------------------------------------------------------
 #include "cache/ThreadCache.hpp"
+#include "compression/CompressionBudget.hpp"
 #include "compression/Datablock.hpp"
+#include "compression/Metrics.hpp"
+#include "compression/ParallelTrials.hpp"
+#include "compression/SchemeDecisionCache.hpp"
 // -------------------------------------------------------------------------------------
 #include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeCost.hpp"
 #include "scheme/SchemePool.hpp"
 // -------------------------------------------------------------------------------------
 #if defined(BTR_FLAG_ENABLE_FOR_SCHEME) && BTR_FLAG_ENABLE_FOR_SCHEME
@@ -38,25 +43,47 @@ class CSchemePicker {
       MyTypeWrapper::getOverrideScheme() = autoScheme();
       return MyTypeWrapper::getScheme(scheme_code);
     } else {
-      SchemeType* preferred_scheme = nullptr;
-      for (auto& scheme : MyTypeWrapper::getSchemes()) {
+      vector<SchemeType*> candidates;
+      for (auto scheme : orderedSchemes()) {
         if (ThreadCache::get().estimation_level != 0 || ThreadCache::get().compression_level > 1) {
-          if (scheme.second->schemeType() == SchemeCodeType::ONE_VALUE) {
+          if (scheme->schemeType() == SchemeCodeType::ONE_VALUE) {
             continue;
           }
         }
 
-        if (!scheme.second->isUsable(stats)) {
+        if (!scheme->isUsable(stats)) {
           continue;
         }
+        candidates.push_back(scheme);
+      }
+      vector<double> compression_ratios(candidates.size());
+      runSchemeTrials(stats, candidates.size(), [&](u32 candidate_i) {
+        // Out of budget, the candidates estimated so far have to do. Keeping
+        // values uncompressed is always estimated as the fallback.
+        if (candidate_i > 0 && CompressionBudget::isExhausted() &&
+            candidates[candidate_i]->schemeType() != SchemeCodeType::UNCOMPRESSED) {
+          return;
+        }
+        compression_ratios[candidate_i] =
+            candidates[candidate_i]->expectedCompressionRatio(stats, allowed_cascading_level);
+      });
 
-        auto compression_ratio =
-            scheme.second->expectedCompressionRatio(stats, allowed_cascading_level);
-        if (compression_ratio > max_compression_ratio) {
+      SchemeType* preferred_scheme = nullptr;
+      double max_score = 0;
+      for (u32 candidate_i = 0; candidate_i < candidates.size(); candidate_i++) {
+        auto compression_ratio = compression_ratios[candidate_i];
+        auto score = objectiveScore(compression_ratio, CB(candidates[candidate_i]->schemeType()));
+        if (score > max_score) {
+          max_score = score;
           max_compression_ratio = compression_ratio;
-          preferred_scheme = scheme.second.get();
+          preferred_scheme = candidates[candidate_i];
         }
       }
+      if ((preferred_scheme == nullptr || max_compression_ratio < 1.0) &&
+          CompressionBudget::isExhausted()) {
+        // None of the candidates tried in time compresses
+        return MyTypeWrapper::getScheme(SchemeCodeType::UNCOMPRESSED);
+      }
       if (max_compression_ratio < 1.0) {
         throw Generic_Exception("compression ratio lower than 1");
       }
@@ -67,6 +94,108 @@ class CSchemePicker {
     }
   }
   // -------------------------------------------------------------------------------------
+  // The enabled schemes ordered by their code. Trials are evaluated in this
+  // order and the first of equally good schemes wins, with or without threads.
+  // Under a budget the schemes that decompress fastest come first, they are
+  // the simple ones and cheap to try, and the slow ones are left out when the
+  // budget runs out.
+  static vector<SchemeType*> orderedSchemes() {
+    vector<SchemeType*> schemes;
+    for (auto& scheme : MyTypeWrapper::getSchemes()) {
+      schemes.push_back(scheme.second.get());
+    }
+    std::sort(schemes.begin(), schemes.end(), [](SchemeType* a, SchemeType* b) {
+      return a->schemeType() < b->schemeType();
+    });
+    if (CompressionBudget::isActive()) {
+      auto speed = [](SchemeType* scheme) {
+        return SchemeCost::get().decompressionSpeed(MyTypeWrapper::getColumnType(),
+                                                    CB(scheme->schemeType()));
+      };
+      std::stable_sort(schemes.begin(), schemes.end(), [&](SchemeType* a, SchemeType* b) {
+        return speed(a) > speed(b);
+      });
+    }
+    return schemes;
+  }
+  // -------------------------------------------------------------------------------------
+  // Runs trial(i) for every i < count, on BtrBlocksConfig::trial_threads
+  // threads when choosing the top level scheme of a block. Deeper levels work
+  // on the output of a single trial and stay on its thread.
+  template <typename Trial>
+  static void runSchemeTrials(StatsType& stats, u32 count, const Trial& trial) {
+    const u32 threads = BtrBlocksConfig::get().trial_threads;
+    if (threads > 1 && count > 1 && ThreadCache::get().isOnHotPath() &&
+        ThreadCache::get().compression_level == 1) {
+      stats.makeShareable();
+      runTrials(count, threads, trial);
+    } else {
+      for (u32 i = 0; i < count; i++) {
+        trial(i);
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Higher is better. The decompression speed is the one of the scheme alone,
+  // it stands for the speed of the cascade below it as well.
+  static double objectiveScore(double compression_ratio, u8 scheme_code) {
+    const auto& selection = BtrBlocksConfig::get().selection;
+    if (selection.objective == SelectionObjective::MAX_RATIO || compression_ratio <= 0) {
+      return compression_ratio;
+    }
+    const double speed =
+        SchemeCost::get().decompressionSpeed(MyTypeWrapper::getColumnType(), scheme_code);
+    switch (selection.objective) {
+      case SelectionObjective::MIN_READ_TIME:
+        // Inverse of the seconds to read one GB of decompressed data
+        return 1.0 / (1.0 / (compression_ratio * selection.read_bandwidth) + 1.0 / speed);
+      case SelectionObjective::RATIO_AT_SPEED:
+        // Too slow schemes only win if none is fast enough
+        return speed >= selection.min_decompression_speed ? compression_ratio
+                                                          : compression_ratio * 1e-6;
+      default:
+        return compression_ratio;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // chooseScheme, unless the decision cache of the column remembers a scheme
+  // for this point of the cascade that was chosen on similar stats
+  static SchemeType& chooseOrReuseScheme(StatsType& stats, u8 allowed_cascading_level) {
+    auto decisions = SchemeDecisionCache::current();
+    if (decisions == nullptr || !ThreadCache::get().isOnHotPath() ||
+        MyTypeWrapper::getOverrideScheme() != autoScheme()) {
+      return chooseScheme(stats, allowed_cascading_level);
+    }
+    const auto type = MyTypeWrapper::getColumnType();
+    const auto level = static_cast<u8>(ThreadCache::get().compression_level);
+    const auto fingerprint = SchemeDecisionCache::fingerprint(stats);
+    if (auto scheme_code = decisions->lookup(type, level, allowed_cascading_level, fingerprint)) {
+      auto it = MyTypeWrapper::getSchemes().find(static_cast<SchemeCodeType>(*scheme_code));
+      // ONE_VALUE is only correct for the chunk it was chosen for
+      if (it != MyTypeWrapper::getSchemes().end() &&
+          it->second->schemeType() != SchemeCodeType::ONE_VALUE && it->second->isUsable(stats)) {
+        decisions->reuse();
+        return *it->second;
+      }
+    }
+    auto& scheme = chooseScheme(stats, allowed_cascading_level);
+    decisions->record(type, level, allowed_cascading_level, fingerprint, CB(scheme.schemeType()));
+    return scheme;
+  }
+  // -------------------------------------------------------------------------------------
+  // Approximate if BtrBlocksConfig::statistics asks for it and the scheme is
+  // chosen by sampling, compress makes them exact for the chosen scheme only
+  static StatsType generateStats(const Type* src, const BITMAP* nullmap, u32 tuple_count) {
+    auto& cfg = BtrBlocksConfig::get();
+    if (cfg.statistics == StatisticsMode::APPROXIMATE &&
+        cfg.scheme_selection == SchemeSelection::SAMPLE &&
+        ThreadCache::get().estimation_level == 0) {
+      return StatsType::generateApproximateStats(src, nullmap, tuple_count, cfg.sample_count,
+                                                 cfg.sample_size);
+    }
+    return StatsType::generateStats(src, nullmap, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
   static void compress(const Type* src,
                        const BITMAP* nullmap,
                        u8* dest,
@@ -76,9 +205,30 @@ class CSchemePicker {
                        u8& scheme_code,
                        u8 force_scheme = autoScheme(),
                        const string& comment = "?") {
+    StatsType stats = generateStats(src, nullmap, tuple_count);
+    compress(src, nullmap, dest, stats, allowed_cascading_level, after_size, scheme_code,
+             force_scheme, comment);
+  }
+  // Same as above, for callers that need the stats of the column themselves
+  static void compress(const Type* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       StatsType& stats,
+                       u8 allowed_cascading_level,
+                       u32& after_size,
+                       u8& scheme_code,
+                       u8 force_scheme = autoScheme(),
+                       const string& comment = "?") {
     Log::debug("Compressing with max level {}", allowed_cascading_level);
+    const u64 start_ns = Metrics::now();
     ThreadCache::get().compression_level++;
-    StatsType stats = StatsType::generateStats(src, nullmap, tuple_count);
+    // Temporaries of the chosen scheme and of the levels below it
+    ScratchArena::Scope scratch(ThreadCache::get().arena);
+    if (CompressionBudget::isExhausted()) {
+      // Falling behind, what is left of the block is not cascaded any further
+      allowed_cascading_level = std::min<u8>(allowed_cascading_level, 1);
+    }
+    const u32 tuple_count = stats.tuple_count;
     SchemeType* preferred_scheme = nullptr;
 
     // -----------------------------------------------------------------------------------
@@ -86,19 +236,20 @@ class CSchemePicker {
     // compression ratio (and thus test how much worse sampling vs optimal is).
     // -----------------------------------------------------------------------------------
 #if defined(BTR_FLAG_SAMPLING_TEST_MODE) and BTR_FLAG_SAMPLING_TEST_MODE
+    stats.makeExact();
     if (allowed_cascading_level == 0 || tuple_count == 0) {
       Log::debug(MyTypeWrapper::getTypeName() + ": UNCOMPRESSED");
       preferred_scheme = &MyTypeWrapper::getScheme(SchemeCodeType::UNCOMPRESSED);
       after_size = preferred_scheme->compress(src, nullmap, dest, stats, 0);
       scheme_code = CB(preferred_scheme->schemeType());
     } else {
-      auto tmp_dest = makeBytesArray(stats.total_size * 10);
+      auto tmp_dest = ThreadCache::get().arena.allocate<u8>(stats.total_size * 10);
       u32 least_after_size = std::numeric_limits<u32>::max();
       // SchemeType *preferred_scheme = nullptr;
       for (auto& scheme : MyTypeWrapper::getSchemes()) {
         if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level) > 0) {
           u32 after_size =
-              scheme.second->compress(src, nullmap, tmp_dest.get(), stats, allowed_cascading_level);
+              scheme.second->compress(src, nullmap, tmp_dest, stats, allowed_cascading_level);
           if (after_size < least_after_size) {
             least_after_size = after_size;
             preferred_scheme = scheme.second.get();
@@ -115,6 +266,10 @@ class CSchemePicker {
 #endif
     // -----------------------------------------------------------------------------------
 
+    if (stats.unique_count <= 1) {
+      // An estimate of 1 may hide a second value
+      stats.makeExact();
+    }
     if ((ThreadCache::get().estimation_level == 0 && ThreadCache::get().compression_level == 1) &&
         (stats.null_count == stats.tuple_count || stats.unique_count == 1)) {
       Log::debug(MyTypeWrapper::getTypeName() + ": ONE_VALUE");
@@ -131,6 +286,7 @@ class CSchemePicker {
     else if (MyTypeWrapper::shouldUseFOR(stats.min) && allowed_cascading_level > 1) {
       Log::debug(MyTypeWrapper::getTypeName() + ": FOR");
       preferred_scheme = &MyTypeWrapper::getFORScheme();
+      stats.makeExact();
       after_size = preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level);
       scheme_code = CB(preferred_scheme->schemeType());
     }
@@ -139,19 +295,33 @@ class CSchemePicker {
       switch (BtrBlocksConfig::get().scheme_selection) {
         // try all schemes
         case SchemeSelection::TRY_ALL: {
-          auto tmp_dest = makeBytesArray(stats.total_size * 10);
+          stats.makeExact();
+          const auto schemes = orderedSchemes();
+          vector<u32> after_sizes(schemes.size(), std::numeric_limits<u32>::max());
+          runSchemeTrials(stats, schemes.size(), [&](u32 scheme_i) {
+            if (scheme_i > 0 && CompressionBudget::isExhausted() &&
+                schemes[scheme_i]->schemeType() != SchemeCodeType::UNCOMPRESSED) {
+              return;
+            }
+            // Only the chosen scheme counts
+            Metrics::Suspend no_metrics;
+            if (schemes[scheme_i]->expectedCompressionRatio(stats, allowed_cascading_level) > 0) {
+              ScratchArena::Scope trial_scratch(ThreadCache::get().arena);
+              auto tmp_dest = ThreadCache::get().arena.allocate<u8>(stats.total_size * 10);
+              after_sizes[scheme_i] = schemes[scheme_i]->compress(src, nullmap, tmp_dest, stats,
+                                                                  allowed_cascading_level);
+            }
+          });
           u32 least_after_size = std::numeric_limits<u32>::max();
-          // SchemeType *preferred_scheme = nullptr;
-          for (auto& scheme : MyTypeWrapper::getSchemes()) {
-            if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level) > 0) {
-              u32 after_size = scheme.second->compress(src, nullmap, tmp_dest.get(), stats,
-                                                       allowed_cascading_level);
-              if (after_size < least_after_size) {
-                least_after_size = after_size;
-                preferred_scheme = scheme.second.get();
-              }
+          for (u32 scheme_i = 0; scheme_i < schemes.size(); scheme_i++) {
+            if (after_sizes[scheme_i] < least_after_size) {
+              least_after_size = after_sizes[scheme_i];
+              preferred_scheme = schemes[scheme_i];
             }
           }
+          if (preferred_scheme == nullptr && CompressionBudget::isExhausted()) {
+            preferred_scheme = &MyTypeWrapper::getScheme(SchemeCodeType::UNCOMPRESSED);
+          }
           die_if(preferred_scheme != nullptr);
           scheme_code = CB(preferred_scheme->schemeType());
           Log::debug((MyTypeWrapper::getTypeName() + ": {}").c_str(), scheme_code);
@@ -166,9 +336,11 @@ class CSchemePicker {
             preferred_scheme = &MyTypeWrapper::getScheme(MyTypeWrapper::getOverrideScheme());
             MyTypeWrapper::getOverrideScheme() = autoScheme();
           } else {
-            preferred_scheme = &chooseScheme(stats, allowed_cascading_level);
+            preferred_scheme = &chooseOrReuseScheme(stats, allowed_cascading_level);
           }
           die_if(preferred_scheme != nullptr);
+          // Only the chosen scheme needs exact stats
+          stats.makeExact();
           scheme_code = CB(preferred_scheme->schemeType());
           Log::debug((MyTypeWrapper::getTypeName() + ": {}").c_str(), scheme_code);
           after_size =
@@ -200,11 +372,24 @@ class CSchemePicker {
                                 " gain = " + std::to_string(CD(stats.total_size) / CD(after_size)) +
                                 '\n';
 #endif
-      double estimated_cf =
-          preferred_scheme->expectedCompressionRatio(stats, allowed_cascading_level);
-      ThreadCache::dumpPush(ConvertSchemeTypeToString(static_cast<SchemeCodeType>(scheme_code)),
-                            estimated_cf, stats.total_size, after_size, stats.unique_count,
-                            comment);
+#if defined(BTR_FLAG_LOGGING) and BTR_FLAG_LOGGING
+      const bool needs_estimate = true;
+#else
+      const bool needs_estimate = Metrics::isEnabled();
+#endif
+      // Estimating again is not free, only do it for someone who looks at it
+      if (needs_estimate) {
+        double estimated_cf =
+            preferred_scheme->expectedCompressionRatio(stats, allowed_cascading_level);
+        ThreadCache::dumpPush(
+            ConvertSchemeTypeToString(static_cast<SchemeCodeType>(scheme_code)), estimated_cf,
+            stats.total_size, after_size, stats.unique_count, comment);
+        if (Metrics::isEnabled()) {
+          Metrics::recordCompression(MyTypeWrapper::getColumnType(), scheme_code,
+                                     ThreadCache::get().compression_level, stats.total_size,
+                                     after_size, estimated_cf, Metrics::now() - start_ns);
+        }
+      }
 
       // if ( estimated_cf / (CD(stats.total_size) / CD(after_size)) >= 100 ) {
       //    for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
@@ -241,6 +426,7 @@ class TypeWrapper<IntegerScheme, IntegerSchemeType> {
   }
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "INTEGER"; }
+  static constexpr ColumnType getColumnType() { return ColumnType::INTEGER; }
   // -------------------------------------------------------------------------------------
   constexpr static bool shouldUseFOR(INTEGER min) {
     return enableFORScheme() && (Utils::getBitsNeeded(min) >= 8) &&
@@ -272,6 +458,7 @@ class TypeWrapper<DoubleScheme, DoubleSchemeType> {
   }
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "DOUBLE"; }
+  static constexpr ColumnType getColumnType() { return ColumnType::DOUBLE; }
   // -------------------------------------------------------------------------------------
   constexpr static bool shouldUseFOR(DOUBLE) { return false; }
   static DoubleScheme& getFORScheme() {
@@ -283,6 +470,67 @@ class TypeWrapper<DoubleScheme, DoubleSchemeType> {
 };
 // -------------------------------------------------------------------------------------
 template <>
+class TypeWrapper<FloatScheme, FloatSchemeType> {
+ public:
+  // -------------------------------------------------------------------------------------
+  static std::unordered_map<FloatSchemeType, unique_ptr<FloatScheme>>& getSchemes() {
+    return SchemePool::available_schemes->float_schemes;
+  }
+  // -------------------------------------------------------------------------------------
+  static FloatScheme& getScheme(FloatSchemeType code) { return *getSchemes()[code]; }
+  // -------------------------------------------------------------------------------------
+  static FloatScheme& getScheme(u8 code) {
+    return *getSchemes()[static_cast<FloatSchemeType>(code)];
+  }
+  // -------------------------------------------------------------------------------------
+  static u8& getOverrideScheme() {
+    auto& ref = BtrBlocksConfig::get().floats.override_scheme;
+    return reinterpret_cast<u8&>(ref);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string getTypeName() { return "FLOAT"; }
+  static constexpr ColumnType getColumnType() { return ColumnType::FLOAT; }
+  // -------------------------------------------------------------------------------------
+  constexpr static bool shouldUseFOR(FLOAT) { return false; }
+  static FloatScheme& getFORScheme() {
+    throw std::logic_error("FOR not implemented for floats.");
+  }
+  // -------------------------------------------------------------------------------------
+  static u8 maxCascadingLevel() { return BtrBlocksConfig::get().floats.max_cascade_depth; }
+  // -------------------------------------------------------------------------------------
+};
+// -------------------------------------------------------------------------------------
+template <>
+class TypeWrapper<BigIntScheme, BigIntSchemeType> {
+ public:
+  // -------------------------------------------------------------------------------------
+  static std::unordered_map<BigIntSchemeType, unique_ptr<BigIntScheme>>& getSchemes() {
+    return SchemePool::available_schemes->bigint_schemes;
+  }
+  // -------------------------------------------------------------------------------------
+  static BigIntScheme& getScheme(BigIntSchemeType code) { return *getSchemes()[code]; }
+  // -------------------------------------------------------------------------------------
+  static BigIntScheme& getScheme(u8 code) {
+    return *getSchemes()[static_cast<BigIntSchemeType>(code)];
+  }
+  // -------------------------------------------------------------------------------------
+  static u8& getOverrideScheme() {
+    auto& ref = BtrBlocksConfig::get().bigints.override_scheme;
+    return reinterpret_cast<u8&>(ref);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string getTypeName() { return "BIGINT"; }
+  static constexpr ColumnType getColumnType() { return ColumnType::BIGINT; }
+  // -------------------------------------------------------------------------------------
+  // FOR is a regular candidate for bigints, it has to compete with BP
+  constexpr static bool shouldUseFOR(BIGINT) { return false; }
+  static BigIntScheme& getFORScheme() { return getScheme(BigIntSchemeType::FOR); }
+  // -------------------------------------------------------------------------------------
+  static u8 maxCascadingLevel() { return BtrBlocksConfig::get().bigints.max_cascade_depth; }
+  // -------------------------------------------------------------------------------------
+};
+// -------------------------------------------------------------------------------------
+template <>
 class TypeWrapper<StringScheme, StringSchemeType> {
  public:
   // -------------------------------------------------------------------------------------
@@ -302,6 +550,7 @@ class TypeWrapper<StringScheme, StringSchemeType> {
   }
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "STRING"; }
+  static constexpr ColumnType getColumnType() { return ColumnType::STRING; }
   // -------------------------------------------------------------------------------------
   constexpr static bool shouldUseFOR(str) { return false; }
   static StringScheme& getFORScheme() {
@@ -315,5 +564,7 @@ class TypeWrapper<StringScheme, StringSchemeType> {
 using IntegerSchemePicker =
     CSchemePicker<INTEGER, IntegerScheme, SInteger32Stats, IntegerSchemeType>;
 using DoubleSchemePicker = CSchemePicker<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>;
+using FloatSchemePicker = CSchemePicker<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+using BigIntSchemePicker = CSchemePicker<BIGINT, BigIntScheme, BigIntStats, BigIntSchemeType>;
 using StringSchemePicker = CSchemePicker<str, StringScheme, StringStats, StringSchemeType>;
 }  // namespace btrblocks
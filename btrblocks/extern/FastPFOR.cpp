@@ -7,6 +7,7 @@
 // fastpfor
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wuninitialized"
+#include <headers/bitpackinghelpers.h>
 #include <headers/blockpacking.h>
 #include <headers/compositecodec.h>
 #include <headers/deltautil.h>
@@ -14,6 +15,8 @@
 #include <headers/variablebyte.h>
 #pragma GCC diagnostic pop
 // -------------------------------------------------------------------------------------
+#include <algorithm>
+// -------------------------------------------------------------------------------------
 using namespace btrblocks;
 // -------------------------------------------------------------------------------------
 template <>
@@ -53,6 +56,65 @@ const typename LemiereImpl<Codec>::data_t* LemiereImpl<Codec>::decompress(const
 }
 // -------------------------------------------------------------------------------------
 template <FastPForCodec Codec>
+void LemiereImpl<Codec>::decompressSelected(const data_t*, u32, const u32*, u32, data_t*) {
+  throw Generic_Exception("Selective decompression is not supported by this codec");
+}
+// -------------------------------------------------------------------------------------
+// Layout of CompositeCodec<FastBinaryPacking<32>, VariableByte>:
+// [number of bit packed values, a multiple of 32] then per block of up to 128
+// values one word with the bit widths of its 4 mini blocks of 32 values
+// followed by the packed mini blocks, then the remaining < 32 values in
+// VariableByte. The last block may hold only 1 to 3 mini blocks, the missing
+// ones have width 0.
+template <>
+void LemiereImpl<FastPForCodec::FBP>::decompressSelected(const data_t* src,
+                                                         u32 u32_count,
+                                                         const u32* selection,
+                                                         u32 count,
+                                                         data_t* dest) {
+  constexpr u32 mini_block_size = 32;
+  constexpr u32 block_size = 4 * mini_block_size;
+  const data_t* const end = src + u32_count;
+  const u32 blocked_count = *src++;
+  // -------------------------------------------------------------------------------------
+  data_t mini_block[mini_block_size];
+  u32 selection_i = 0;
+  for (u32 block_begin = 0; block_begin < blocked_count && selection_i < count;
+       block_begin += block_size) {
+    const data_t header = *src++;
+    const u32 bits[4] = {header >> 24, (header >> 16) & 0xFF, (header >> 8) & 0xFF, header & 0xFF};
+    const u32 block_end = std::min(block_begin + block_size, blocked_count);
+    if (selection[selection_i] >= block_end) {
+      src += bits[0] + bits[1] + bits[2] + bits[3];
+      continue;
+    }
+    for (u32 mini_i = 0; mini_i < 4; mini_i++) {
+      const u32 mini_end = block_begin + (mini_i + 1) * mini_block_size;
+      if (selection_i < count && selection[selection_i] < std::min(mini_end, block_end)) {
+        FastPForLib::fastunpack(src, mini_block, bits[mini_i]);
+        do {
+          dest[selection_i] = mini_block[selection[selection_i] % mini_block_size];
+          selection_i++;
+        } while (selection_i < count && selection[selection_i] < mini_end);
+      }
+      src += bits[mini_i];
+    }
+  }
+  if (selection_i == count) {
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  // All blocks have been skipped, the short tail is decoded as a whole
+  data_t tail[mini_block_size];
+  SIZE tail_count = mini_block_size;
+  FastPForLib::VariableByte tail_codec;
+  tail_codec.decodeArray(src, end - src, tail, tail_count);
+  for (; selection_i < count; selection_i++) {
+    dest[selection_i] = tail[selection[selection_i] - blocked_count];
+  }
+}
+// -------------------------------------------------------------------------------------
+template <FastPForCodec Codec>
 void LemiereImpl<Codec>::applyDelta(data_t* src, size_t count) {
   using namespace FastPForLib;
   FastPForLib::Delta::deltaSIMD(src, count);
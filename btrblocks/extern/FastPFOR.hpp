@@ -20,6 +20,14 @@ struct LemiereImpl {
   // -------------------------------------------------------------------------------------
   u32 compress(const data_t* src, u32 count, data_t* dest, size_t& outsize);
   const data_t* decompress(const data_t* src, u32 count, data_t* dest, size_t& outsize);
+  // Decodes only the values at the ascending positions in selection to
+  // dest[0, count). Only implemented for FBP, whose blocks can be skipped by
+  // their bit widths without decoding them.
+  void decompressSelected(const data_t* src,
+                          u32 u32_count,
+                          const u32* selection,
+                          u32 count,
+                          data_t* dest);
   // -------------------------------------------------------------------------------------
   static void applyDelta(data_t* src, size_t count);
   static void revertDelta(data_t* src, size_t count);
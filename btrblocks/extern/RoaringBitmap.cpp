@@ -2,6 +2,8 @@
 // -------------------------------------------------------+------------------------------
 #include "common/Log.hpp"
 // -------------------------------------------------------+------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
 
 // -------------------------------------------------------------------------------------
 namespace btrblocks::bitmap {
@@ -58,6 +60,34 @@ std::vector<BITMAP> BitmapWrapper::writeBITMAP() {
   return result;
 }
 
+void BitmapWrapper::maskBITMAP(BITMAP* dest) {
+  switch (this->m_type) {
+    case BitmapType::ALLONES: {
+      break;
+    }
+    case BitmapType::ALLZEROS: {
+      std::memset(dest, 0, this->m_tuple_count);
+      break;
+    }
+    case BitmapType::FLIPPED: {
+      // The roaring bitmap holds exactly the null rows
+      this->m_roaring.iterate(
+          [](uint32_t value, void* param) {
+            reinterpret_cast<BITMAP*>(param)[value] = 0;
+            return true;
+          },
+          dest);
+      break;
+    }
+    default: {
+      for (u32 i = 0; i < this->m_tuple_count; i++) {
+        dest[i] &= this->get_bitset()->test(i);
+      }
+      break;
+    }
+  }
+}
+
 void BitmapWrapper::releaseBitset() {
   this->m_bitset = nullptr;
   this->m_bitset_initialized = false;
@@ -23,6 +23,8 @@ class BitmapWrapper {
   virtual ~BitmapWrapper();
   void writeBITMAP(BITMAP* dest);
   std::vector<BITMAP> writeBITMAP();
+  // Clears every entry of dest whose row is null
+  void maskBITMAP(BITMAP* dest);
   boost::dynamic_bitset<>* get_bitset();
   void releaseBitset();
   [[nodiscard]] inline bool test(u32 idx) { return this->get_bitset()->test(idx); }
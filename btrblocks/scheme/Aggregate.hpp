@@ -0,0 +1,162 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/SIMD.hpp"
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+enum class AggKind : u8 { SUM, COUNT, MIN, MAX };
+// -------------------------------------------------------------------------------------
+// SUM, COUNT, MIN and MAX over the non-null values of a column. All of them
+// are maintained at once, they cost next to nothing compared to producing
+// the values. min and max are only meaningful when count > 0.
+// Integer sums are exact: 32 bit values are summed in 64 bits and 64 bit
+// values in 128 bits, neither can overflow for the 2^32 values of a chunk.
+template <typename T>
+struct TAggregate {
+  using SumType = std::conditional_t<std::is_floating_point_v<T>,
+                                     double,
+                                     std::conditional_t<(sizeof(T) > 4), __int128, s64>>;
+  // -------------------------------------------------------------------------------------
+  SumType sum = 0;
+  u64 count = 0;
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  // -------------------------------------------------------------------------------------
+  // Adds value repetitions times, e.g. a whole run
+  inline void add(T value, u64 repetitions) {
+    if (repetitions == 0) {
+      return;
+    }
+    sum += static_cast<SumType>(value) * static_cast<SumType>(repetitions);
+    count += repetitions;
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+  // -------------------------------------------------------------------------------------
+  inline void merge(const TAggregate& other) {
+    if (other.count == 0) {
+      return;
+    }
+    sum += other.sum;
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+  // -------------------------------------------------------------------------------------
+  // Adds every value of a decompressed column without nulls
+  inline void addAll(const T* values, u32 value_count) {
+    for (u32 i = 0; i < value_count; i++) {
+      sum += values[i];
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+    }
+    count += value_count;
+  }
+  // Adds the values whose not_null entry is set
+  inline void addAll(const T* values, const BITMAP* not_null, u32 value_count) {
+    for (u32 i = 0; i < value_count; i++) {
+      if (not_null[i]) {
+        add(values[i], 1);
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // NaN for MIN and MAX without any value
+  [[nodiscard]] inline double get(AggKind kind) const {
+    switch (kind) {
+      case AggKind::SUM:
+        return static_cast<double>(sum);
+      case AggKind::COUNT:
+        return static_cast<double>(count);
+      case AggKind::MIN:
+        return count > 0 ? static_cast<double>(min) : std::nan("");
+      case AggKind::MAX:
+        return count > 0 ? static_cast<double>(max) : std::nan("");
+    }
+    return std::nan("");
+  }
+};
+// -------------------------------------------------------------------------------------
+#ifdef BTR_USE_SIMD
+// Eight lanes at a time, the sum is widened to 64 bit so that it cannot
+// overflow
+template <>
+inline void TAggregate<INTEGER>::addAll(const INTEGER* values, u32 value_count) {
+  if (value_count == 0) {
+    return;
+  }
+  __m256i sum_lo = _mm256_setzero_si256();
+  __m256i sum_hi = _mm256_setzero_si256();
+  __m256i min_v = _mm256_set1_epi32(min);
+  __m256i max_v = _mm256_set1_epi32(max);
+  u32 i = 0;
+  for (; i + 8 <= value_count; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    sum_lo = _mm256_add_epi64(sum_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    sum_hi = _mm256_add_epi64(sum_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    min_v = _mm256_min_epi32(min_v, v);
+    max_v = _mm256_max_epi32(max_v, v);
+  }
+  alignas(32) s64 sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums), _mm256_add_epi64(sum_lo, sum_hi));
+  alignas(32) INTEGER mins[8], maxs[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(mins), min_v);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), max_v);
+  for (u32 lane = 0; lane < 4; lane++) {
+    sum += sums[lane];
+  }
+  for (u32 lane = 0; lane < 8; lane++) {
+    min = std::min(min, mins[lane]);
+    max = std::max(max, maxs[lane]);
+  }
+  for (; i < value_count; i++) {
+    sum += values[i];
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+  }
+  count += value_count;
+}
+// -------------------------------------------------------------------------------------
+// Four lanes at a time. The sum is added up in a different order than a
+// sequential loop would.
+template <>
+inline void TAggregate<DOUBLE>::addAll(const DOUBLE* values, u32 value_count) {
+  if (value_count == 0) {
+    return;
+  }
+  __m256d sum_v = _mm256_setzero_pd();
+  __m256d min_v = _mm256_set1_pd(min);
+  __m256d max_v = _mm256_set1_pd(max);
+  u32 i = 0;
+  for (; i + 4 <= value_count; i += 4) {
+    __m256d v = _mm256_loadu_pd(values + i);
+    sum_v = _mm256_add_pd(sum_v, v);
+    min_v = _mm256_min_pd(min_v, v);
+    max_v = _mm256_max_pd(max_v, v);
+  }
+  alignas(32) DOUBLE sums[4], mins[4], maxs[4];
+  _mm256_store_pd(sums, sum_v);
+  _mm256_store_pd(mins, min_v);
+  _mm256_store_pd(maxs, max_v);
+  for (u32 lane = 0; lane < 4; lane++) {
+    sum += sums[lane];
+    min = std::min(min, mins[lane]);
+    max = std::max(max, maxs[lane]);
+  }
+  for (; i < value_count; i++) {
+    sum += values[i];
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+  }
+  count += value_count;
+}
+#endif
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
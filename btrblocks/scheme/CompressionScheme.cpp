@@ -5,20 +5,38 @@
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
+namespace {
+template <typename T>
+TAggregate<T> reduceValues(const T* values, BitmapWrapper* nullmap, u32 tuple_count, u32 level) {
+  TAggregate<T> aggregate;
+  if (nullmap == nullptr || nullmap->type() == BitmapType::ALLONES) {
+    aggregate.addAll(values, tuple_count);
+  } else if (nullmap->type() != BitmapType::ALLZEROS) {
+    thread_local std::vector<std::vector<BITMAP>> not_null_v;
+    auto not_null = get_level_data(not_null_v, tuple_count, level);
+    nullmap->writeBITMAP(not_null);
+    aggregate.addAll(values, not_null, tuple_count);
+  }
+  return aggregate;
+}
+}  // namespace
+// -------------------------------------------------------------------------------------
 double DoubleScheme::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) {
   auto& cfg = BtrBlocksConfig::get();
-  auto dest = makeBytesArray(CS(cfg.sample_size) * cfg.sample_count * sizeof(DOUBLE) * 100);
+  ScratchArena::Scope scratch(ThreadCache::get().arena);
+  auto dest =
+      ThreadCache::get().arena.allocate<u8>(CS(cfg.sample_size) * cfg.sample_count * sizeof(DOUBLE) * 100);
   u32 total_before = 0;
   u32 total_after = 0;
   if (ThreadCache::get().estimation_level++ >= 1) {
     total_before += stats.total_size;
-    total_after += compress(stats.src, stats.bitmap, dest.get(), stats, allowed_cascading_level);
+    total_after += compress(stats.src, stats.bitmap, dest, stats, allowed_cascading_level);
   } else {
     auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
     DoubleStats c_stats = DoubleStats::generateStats(
         std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
     total_before += c_stats.total_size;
-    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest.get(),
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest,
                             c_stats, allowed_cascading_level);
   }
   ThreadCache::get().estimation_level--;
@@ -27,24 +45,254 @@ double DoubleScheme::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cas
 // -------------------------------------------------------------------------------------
 double IntegerScheme::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
   auto& cfg = BtrBlocksConfig::get();
-  auto dest = makeBytesArray(CS(cfg.sample_size) * cfg.sample_count * sizeof(INTEGER) * 100);
+  ScratchArena::Scope scratch(ThreadCache::get().arena);
+  auto dest =
+      ThreadCache::get().arena.allocate<u8>(CS(cfg.sample_size) * cfg.sample_count * sizeof(INTEGER) * 100);
   u32 total_before = 0;
   u32 total_after = 0;
   if (ThreadCache::get().estimation_level++ >= 1) {
     total_before += stats.total_size;
-    total_after += compress(stats.src, stats.bitmap, dest.get(), stats, allowed_cascading_level);
+    total_after += compress(stats.src, stats.bitmap, dest, stats, allowed_cascading_level);
   } else {
     auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
     SInteger32Stats c_stats = SInteger32Stats::generateStats(
         std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
     total_before += c_stats.total_size;
-    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest.get(),
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest,
+                            c_stats, allowed_cascading_level);
+  }
+  ThreadCache::get().estimation_level--;
+  return CD(total_before) / CD(total_after);
+}
+// -------------------------------------------------------------------------------------
+void IntegerScheme::scan(const Predicate& predicate,
+                         BITMAP* result,
+                         const u8* src,
+                         u32 tuple_count,
+                         u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decompress(values, nullptr, src, tuple_count, level);
+  predicate.evaluate(values, tuple_count, result);
+}
+// -------------------------------------------------------------------------------------
+void IntegerScheme::decompressSelected(INTEGER* dest,
+                                       const u32* selection,
+                                       u32 count,
+                                       BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+INTEGER IntegerScheme::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  INTEGER value;
+  decompressSelected(&value, &row, 1, nullptr, src, tuple_count, level);
+  return value;
+}
+// -------------------------------------------------------------------------------------
+TAggregate<INTEGER> IntegerScheme::aggregate(BitmapWrapper* nullmap,
+                                             const u8* src,
+                                             u32 tuple_count,
+                                             u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  return reduceValues(values, nullmap, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void DoubleScheme::decompressSelected(DOUBLE* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  thread_local std::vector<std::vector<DOUBLE>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+DOUBLE DoubleScheme::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  DOUBLE value;
+  decompressSelected(&value, &row, 1, nullptr, src, tuple_count, level);
+  return value;
+}
+// -------------------------------------------------------------------------------------
+TAggregate<DOUBLE> DoubleScheme::aggregate(BitmapWrapper* nullmap,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  thread_local std::vector<std::vector<DOUBLE>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  return reduceValues(values, nullmap, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+double FloatScheme::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  auto& cfg = BtrBlocksConfig::get();
+  ScratchArena::Scope scratch(ThreadCache::get().arena);
+  auto dest =
+      ThreadCache::get().arena.allocate<u8>(CS(cfg.sample_size) * cfg.sample_count * sizeof(FLOAT) * 100);
+  u32 total_before = 0;
+  u32 total_after = 0;
+  if (ThreadCache::get().estimation_level++ >= 1) {
+    total_before += stats.total_size;
+    total_after += compress(stats.src, stats.bitmap, dest, stats, allowed_cascading_level);
+  } else {
+    auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
+    FloatStats c_stats = FloatStats::generateStats(
+        std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
+    total_before += c_stats.total_size;
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest,
+                            c_stats, allowed_cascading_level);
+  }
+  ThreadCache::get().estimation_level--;
+  return CD(total_before) / CD(total_after);
+}
+// -------------------------------------------------------------------------------------
+void FloatScheme::decompressSelected(FLOAT* dest,
+                                     const u32* selection,
+                                     u32 count,
+                                     BitmapWrapper* nullmap,
+                                     const u8* src,
+                                     u32 tuple_count,
+                                     u32 level) {
+  thread_local std::vector<std::vector<FLOAT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(FLOAT), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+FLOAT FloatScheme::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  FLOAT value;
+  decompressSelected(&value, &row, 1, nullptr, src, tuple_count, level);
+  return value;
+}
+// -------------------------------------------------------------------------------------
+TAggregate<FLOAT> FloatScheme::aggregate(BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level) {
+  thread_local std::vector<std::vector<FLOAT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(FLOAT), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  return reduceValues(values, nullmap, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+double BigIntScheme::expectedCompressionRatio(BigIntStats& stats, u8 allowed_cascading_level) {
+  auto& cfg = BtrBlocksConfig::get();
+  ScratchArena::Scope scratch(ThreadCache::get().arena);
+  auto dest =
+      ThreadCache::get().arena.allocate<u8>(CS(cfg.sample_size) * cfg.sample_count * sizeof(BIGINT) * 100);
+  u32 total_before = 0;
+  u32 total_after = 0;
+  if (ThreadCache::get().estimation_level++ >= 1) {
+    total_before += stats.total_size;
+    total_after += compress(stats.src, stats.bitmap, dest, stats, allowed_cascading_level);
+  } else {
+    auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
+    BigIntStats c_stats = BigIntStats::generateStats(
+        std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
+    total_before += c_stats.total_size;
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest,
                             c_stats, allowed_cascading_level);
   }
   ThreadCache::get().estimation_level--;
   return CD(total_before) / CD(total_after);
 }
 // -------------------------------------------------------------------------------------
+void BigIntScheme::scan(const BigIntPredicate& predicate,
+                        BITMAP* result,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  thread_local std::vector<std::vector<BIGINT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(BIGINT), level);
+  decompress(values, nullptr, src, tuple_count, level);
+  predicate.evaluate(values, tuple_count, result);
+}
+// -------------------------------------------------------------------------------------
+void BigIntScheme::decompressSelected(BIGINT* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  thread_local std::vector<std::vector<BIGINT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(BIGINT), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+BIGINT BigIntScheme::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  BIGINT value;
+  decompressSelected(&value, &row, 1, nullptr, src, tuple_count, level);
+  return value;
+}
+// -------------------------------------------------------------------------------------
+TAggregate<BIGINT> BigIntScheme::aggregate(BitmapWrapper* nullmap,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  thread_local std::vector<std::vector<BIGINT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(BIGINT), level);
+  decompress(values, nullmap, src, tuple_count, level);
+  return reduceValues(values, nullmap, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void StringScheme::decompressSelected(u8* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  thread_local std::vector<std::vector<u8>> strings_v;
+  auto strings = get_level_data(
+      strings_v, getDecompressedSize(src, tuple_count, nullmap) + SIMD_EXTRA_BYTES + 4096, level);
+  decompress(strings, nullmap, src, tuple_count, level);
+  StringArrayViewer viewer(strings);
+  // -------------------------------------------------------------------------------------
+  auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+  u32 write_offset = (count + 1) * sizeof(StringArrayViewer::Slot);
+  for (u32 i = 0; i < count; i++) {
+    const str value = viewer(selection[i]);
+    dest_slots[i].offset = write_offset;
+    std::memcpy(dest + write_offset, value.data(), value.length());
+    write_offset += value.length();
+  }
+  dest_slots[count].offset = write_offset;
+}
+void StringScheme::scan(const StringPredicate& predicate,
+                        BITMAP* result,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  thread_local std::vector<std::vector<u8>> strings_v;
+  auto strings = get_level_data(
+      strings_v, getDecompressedSize(src, tuple_count, nullptr) + SIMD_EXTRA_BYTES + 4096, level);
+  decompress(strings, nullptr, src, tuple_count, level);
+  StringArrayViewer viewer(strings);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    result[row_i] = predicate.matches(viewer(row_i));
+  }
+}
+// -------------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(IntegerSchemeType type) {
   switch (type) {
     case IntegerSchemeType::PFOR:
@@ -73,6 +321,10 @@ string ConvertSchemeTypeToString(IntegerSchemeType type) {
       return "UNCOMPRESSED";
     case IntegerSchemeType::FOR:
       return "FOR";
+    case IntegerSchemeType::DELTA:
+      return "DELTA";
+    case IntegerSchemeType::DELTA_OF_DELTA:
+      return "DELTA_OF_DELTA";
     default:
       throw Generic_Exception("Unknown IntegerSchemeType");
   }
@@ -82,6 +334,10 @@ string ConvertSchemeTypeToString(DoubleSchemeType type) {
   switch (type) {
     case DoubleSchemeType::PSEUDODECIMAL:
       return "PSEUDODECIMAL";
+    case DoubleSchemeType::ALP:
+      return "ALP";
+    case DoubleSchemeType::XOR:
+      return "XOR";
     case DoubleSchemeType::RLE:
       return "RLE";
     case DoubleSchemeType::DICT:
@@ -103,6 +359,50 @@ string ConvertSchemeTypeToString(DoubleSchemeType type) {
   }
 }
 // ------------------------------------------------------------------------------
+string ConvertSchemeTypeToString(FloatSchemeType type) {
+  switch (type) {
+    case FloatSchemeType::UNCOMPRESSED:
+      return "UNCOMPRESSED";
+    case FloatSchemeType::ONE_VALUE:
+      return "ONE_VALUE";
+    case FloatSchemeType::DICT:
+      return "DICT";
+    case FloatSchemeType::RLE:
+      return "RLE";
+    case FloatSchemeType::FREQUENCY:
+      return "FREQUENCY";
+    case FloatSchemeType::ALP:
+      return "ALP";
+    case FloatSchemeType::XOR:
+      return "XOR";
+    default:
+      throw Generic_Exception("Unknown FloatSchemeType");
+  }
+}
+// ------------------------------------------------------------------------------
+string ConvertSchemeTypeToString(BigIntSchemeType type) {
+  switch (type) {
+    case BigIntSchemeType::UNCOMPRESSED:
+      return "UNCOMPRESSED";
+    case BigIntSchemeType::ONE_VALUE:
+      return "ONE_VALUE";
+    case BigIntSchemeType::DICT:
+      return "DICT";
+    case BigIntSchemeType::RLE:
+      return "RLE";
+    case BigIntSchemeType::FREQUENCY:
+      return "FREQUENCY";
+    case BigIntSchemeType::FOR:
+      return "FOR";
+    case BigIntSchemeType::BP:
+      return "BP";
+    case BigIntSchemeType::DELTA:
+      return "DELTA";
+    default:
+      throw Generic_Exception("Unknown BigIntSchemeType");
+  }
+}
+// ------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(StringSchemeType type) {
   switch (type) {
     case StringSchemeType::ONE_VALUE:
@@ -1,6 +1,8 @@
 #pragma once
 // -------------------------------------------------------------------------------------
 #include "common/Units.hpp"
+#include "scheme/Aggregate.hpp"
+#include "scheme/Predicate.hpp"
 #include "scheme/SchemeType.hpp"
 // -------------------------------------------------------------------------------------
 #include "storage/Chunk.hpp"
@@ -15,11 +17,13 @@ namespace btrblocks {
 using UInteger32Stats = NumberStats<u32>;
 using SInteger32Stats = NumberStats<s32>;
 using DoubleStats = NumberStats<DOUBLE>;
-// -------------------------------------------------------------------------------------
-struct Predicate {};
+using FloatStats = NumberStats<FLOAT>;
+using BigIntStats = NumberStats<BIGINT>;
 // -------------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(IntegerSchemeType type);
 string ConvertSchemeTypeToString(DoubleSchemeType type);
+string ConvertSchemeTypeToString(FloatSchemeType type);
+string ConvertSchemeTypeToString(BigIntSchemeType type);
 string ConvertSchemeTypeToString(StringSchemeType type);
 // -------------------------------------------------------------------------------------
 // expectedCompressionRatio should only be called at top level
@@ -40,11 +44,48 @@ class IntegerScheme {
                           u32 tuple_count,
                           u32 level) = 0;
   // -------------------------------------------------------------------------------------
+  // Writes the values of the rows in selection (ascending row ids) to
+  // dest[0, count), so that a column can be decoded only at the positions
+  // that survived a filter on another column. The default implementation
+  // decompresses everything into a thread-local buffer and gathers.
+  virtual void decompressSelected(INTEGER* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level);
+  // -------------------------------------------------------------------------------------
   virtual IntegerSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
-  virtual INTEGER lookup(u32 id) = 0;
+  // Point access to a single row of the compressed block, e.g. for index
+  // probes. The default decodes the row through decompressSelected.
+  virtual INTEGER lookup(const u8* src, u32 row, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // SUM/COUNT/MIN/MAX over the non-null rows. Schemes compute it from their
+  // compressed representation where they can, the default implementation
+  // decompresses into a thread-local buffer and reduces it.
+  virtual TAggregate<INTEGER> aggregate(BitmapWrapper* nullmap,
+                                        const u8* src,
+                                        u32 tuple_count,
+                                        u32 level);
+  // -------------------------------------------------------------------------------------
+  // Dictionary schemes copy their distinct values to dictionary and write the
+  // code of every row to codes (tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER)
+  // entries) instead of mapping them back to values. Consumers can then work
+  // on the dense codes, e.g. group by indexing an array. Returns the number of
+  // dictionary entries, 0 if the scheme does not use a dictionary.
+  virtual u32 decompressDictionary(std::vector<u8>&, u32*, const u8*, u32, u32) { return 0; }
   // -------------------------------------------------------------------------------------
-  virtual void scan(Predicate, BITMAP* result, const u8* src, u32 tuple_count) = 0;
+  // Writes result[i] = predicate.matches(value_i) without materializing the
+  // column where the scheme allows it. The entries of null rows are
+  // unspecified, the caller masks them with the nullmap. The default
+  // implementation decompresses into a thread-local buffer and compares.
+  virtual void scan(const Predicate& predicate,
+                    BITMAP* result,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level);
   // -------------------------------------------------------------------------------------
   inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
   virtual string fullDescription(const u8*) {
@@ -73,6 +114,24 @@ class DoubleScheme {
                           u32 tuple_count,
                           u32 level) = 0;
   // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::decompressSelected
+  virtual void decompressSelected(DOUBLE* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level);
+  // Same contract as IntegerScheme::lookup
+  virtual DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level);
+  // Same contract as IntegerScheme::aggregate
+  virtual TAggregate<DOUBLE> aggregate(BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level);
+  // Same contract as IntegerScheme::decompressDictionary
+  virtual u32 decompressDictionary(std::vector<u8>&, u32*, const u8*, u32, u32) { return 0; }
+  // -------------------------------------------------------------------------------------
   virtual DoubleSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
   inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
@@ -83,6 +142,106 @@ class DoubleScheme {
   virtual bool isUsable(DoubleStats&) { return true; }
 };
 // -------------------------------------------------------------------------------------
+// Float
+// -------------------------------------------------------------------------------------
+class FloatScheme {
+ public:
+  // -------------------------------------------------------------------------------------
+  virtual double expectedCompressionRatio(FloatStats& stats, [[maybe_unused]] u8 allowed_cascading_level);
+  // -------------------------------------------------------------------------------------
+  virtual u32 compress(const FLOAT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       FloatStats& stats,
+                       u8 allowed_cascading_level) = 0;
+  // -------------------------------------------------------------------------------------
+  virtual void decompress(FLOAT* dest,
+                          BitmapWrapper* bitmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) = 0;
+  // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::decompressSelected
+  virtual void decompressSelected(FLOAT* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level);
+  // Same contract as IntegerScheme::lookup
+  virtual FLOAT lookup(const u8* src, u32 row, u32 tuple_count, u32 level);
+  // Same contract as IntegerScheme::aggregate
+  virtual TAggregate<FLOAT> aggregate(BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level);
+  // Same contract as IntegerScheme::decompressDictionary
+  virtual u32 decompressDictionary(std::vector<u8>&, u32*, const u8*, u32, u32) { return 0; }
+  // -------------------------------------------------------------------------------------
+  virtual FloatSchemeType schemeType() = 0;
+  // -------------------------------------------------------------------------------------
+  inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
+  virtual string fullDescription(const u8*) {
+    // Default implementation for schemes that do not have nested schemes
+    return this->selfDescription();
+  }
+  virtual bool isUsable(FloatStats&) { return true; }
+};
+// -------------------------------------------------------------------------------------
+// BigInt
+// -------------------------------------------------------------------------------------
+class BigIntScheme {
+ public:
+  // -------------------------------------------------------------------------------------
+  virtual double expectedCompressionRatio(BigIntStats& stats, [[maybe_unused]] u8 allowed_cascading_level);
+  // -------------------------------------------------------------------------------------
+  virtual u32 compress(const BIGINT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       BigIntStats& stats,
+                       u8 allowed_cascading_level) = 0;
+  // -------------------------------------------------------------------------------------
+  virtual void decompress(BIGINT* dest,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) = 0;
+  // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::decompressSelected
+  virtual void decompressSelected(BIGINT* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level);
+  // Same contract as IntegerScheme::lookup
+  virtual BIGINT lookup(const u8* src, u32 row, u32 tuple_count, u32 level);
+  // Same contract as IntegerScheme::aggregate
+  virtual TAggregate<BIGINT> aggregate(BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level);
+  // Same contract as IntegerScheme::decompressDictionary
+  virtual u32 decompressDictionary(std::vector<u8>&, u32*, const u8*, u32, u32) { return 0; }
+  // Same contract as IntegerScheme::scan
+  virtual void scan(const BigIntPredicate& predicate,
+                    BITMAP* result,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level);
+  // -------------------------------------------------------------------------------------
+  virtual BigIntSchemeType schemeType() = 0;
+  // -------------------------------------------------------------------------------------
+  inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
+  virtual string fullDescription(const u8*) {
+    // Default implementation for schemes that do not have nested schemes
+    return this->selfDescription();
+  }
+  virtual bool isUsable(BigIntStats&) { return true; }
+};
+// -------------------------------------------------------------------------------------
 // String
 // -------------------------------------------------------------------------------------
 class StringScheme {
@@ -127,6 +286,29 @@ class StringScheme {
     return false;
   }
   // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::decompressSelected. dest receives the
+  // selected strings in the StringArrayViewer layout (count + 1 slots), it
+  // has to hold (count + 1) slots plus getTotalLength bytes.
+  virtual void decompressSelected(u8* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level);
+  // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::scan. The default implementation
+  // decompresses into a thread-local buffer and compares every string.
+  virtual void scan(const StringPredicate& predicate,
+                    BITMAP* result,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level);
+  // -------------------------------------------------------------------------------------
+  // Same contract as IntegerScheme::decompressDictionary, the dictionary is
+  // written in the StringArrayViewer layout.
+  virtual u32 decompressDictionary(std::vector<u8>&, u32*, const u8*, u32, u32) { return 0; }
+  // -------------------------------------------------------------------------------------
   virtual StringSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
   inline string selfDescription(const u8* src = nullptr) {
@@ -0,0 +1,244 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+enum class PredicateType : u8 {
+  EQUAL,
+  NOT_EQUAL,
+  LESS,
+  LESS_EQUAL,
+  GREATER,
+  GREATER_EQUAL,
+  BETWEEN,  // lower <= value <= upper
+  IN,
+  IS_NULL,
+  IS_NOT_NULL,
+  PREFIX,  // strings only: value starts with lower
+  LIKE     // strings only: lower is a SQL LIKE pattern, % and _ are wildcards
+};
+// -------------------------------------------------------------------------------------
+// SQL LIKE without escape characters: % matches any sequence, _ any single
+// byte. Backtracks to the last %, which is linear for the usual patterns.
+inline bool matchesLike(str value, str pattern) {
+  size_t value_i = 0, pattern_i = 0;
+  size_t retry_value_i = 0, retry_pattern_i = str::npos;
+  while (value_i < value.size()) {
+    if (pattern_i < pattern.size() && pattern[pattern_i] == '%') {
+      retry_pattern_i = ++pattern_i;
+      retry_value_i = value_i;
+    } else if (pattern_i < pattern.size() &&
+               (pattern[pattern_i] == '_' || pattern[pattern_i] == value[value_i])) {
+      pattern_i++;
+      value_i++;
+    } else if (retry_pattern_i != str::npos) {
+      // Let the last % swallow one more byte
+      pattern_i = retry_pattern_i;
+      value_i = ++retry_value_i;
+    } else {
+      return false;
+    }
+  }
+  while (pattern_i < pattern.size() && pattern[pattern_i] == '%') {
+    pattern_i++;
+  }
+  return pattern_i == pattern.size();
+}
+// -------------------------------------------------------------------------------------
+// A filter on a single column. The schemes evaluate the value comparison on
+// their compressed representation and write one BITMAP entry per row (1 = row
+// qualifies). Nulls are not part of the comparison: IS_NULL and IS_NOT_NULL
+// are answered from the nullmap and null rows never qualify otherwise, which is
+// taken care of by the caller (see BtrReader::scanColumn).
+template <typename T>
+struct TPredicate {
+  PredicateType type;
+  T lower{};         // operand of the comparisons, lower bound for BETWEEN
+  T upper{};         // upper bound for BETWEEN
+  vector<T> values;  // IN-list, sorted and without duplicates
+  // -------------------------------------------------------------------------------------
+  static TPredicate equal(T value) { return {PredicateType::EQUAL, value, value, {}}; }
+  static TPredicate notEqual(T value) { return {PredicateType::NOT_EQUAL, value, value, {}}; }
+  static TPredicate less(T value) { return {PredicateType::LESS, value, value, {}}; }
+  static TPredicate lessEqual(T value) { return {PredicateType::LESS_EQUAL, value, value, {}}; }
+  static TPredicate greater(T value) { return {PredicateType::GREATER, value, value, {}}; }
+  static TPredicate greaterEqual(T value) {
+    return {PredicateType::GREATER_EQUAL, value, value, {}};
+  }
+  static TPredicate between(T lower, T upper) {
+    return {PredicateType::BETWEEN, lower, upper, {}};
+  }
+  static TPredicate in(vector<T> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return {PredicateType::IN, T{}, T{}, std::move(values)};
+  }
+  static TPredicate startsWith(T prefix) { return {PredicateType::PREFIX, prefix, prefix, {}}; }
+  static TPredicate like(T pattern) { return {PredicateType::LIKE, pattern, pattern, {}}; }
+  static TPredicate isNull() { return {PredicateType::IS_NULL, T{}, T{}, {}}; }
+  static TPredicate isNotNull() { return {PredicateType::IS_NOT_NULL, T{}, T{}, {}}; }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] inline bool isNullCheck() const {
+    return type == PredicateType::IS_NULL || type == PredicateType::IS_NOT_NULL;
+  }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] inline bool matches(const T& value) const {
+    switch (type) {
+      case PredicateType::EQUAL:
+        return value == lower;
+      case PredicateType::NOT_EQUAL:
+        return value != lower;
+      case PredicateType::LESS:
+        return value < lower;
+      case PredicateType::LESS_EQUAL:
+        return value <= lower;
+      case PredicateType::GREATER:
+        return value > lower;
+      case PredicateType::GREATER_EQUAL:
+        return value >= lower;
+      case PredicateType::BETWEEN:
+        return lower <= value && value <= upper;
+      case PredicateType::IN:
+        return std::binary_search(values.begin(), values.end(), value);
+      case PredicateType::IS_NULL:
+        return false;
+      case PredicateType::IS_NOT_NULL:
+        return true;
+      case PredicateType::PREFIX:
+        if constexpr (std::is_same_v<T, str>) {
+          return value.substr(0, lower.size()) == lower;
+        }
+        break;
+      case PredicateType::LIKE:
+        if constexpr (std::is_same_v<T, str>) {
+          return matchesLike(value, lower);
+        }
+        break;
+    }
+    return false;
+  }
+  // -------------------------------------------------------------------------------------
+  // result[i] = matches(src[i]); the switch is hoisted out of the loops so that
+  // the compiler can vectorize the comparisons.
+  inline void evaluate(const T* src, u32 tuple_count, BITMAP* result) const {
+    switch (type) {
+      case PredicateType::EQUAL:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] == lower;
+        }
+        break;
+      case PredicateType::NOT_EQUAL:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] != lower;
+        }
+        break;
+      case PredicateType::LESS:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] < lower;
+        }
+        break;
+      case PredicateType::LESS_EQUAL:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] <= lower;
+        }
+        break;
+      case PredicateType::GREATER:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] > lower;
+        }
+        break;
+      case PredicateType::GREATER_EQUAL:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = src[i] >= lower;
+        }
+        break;
+      case PredicateType::BETWEEN:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = (lower <= src[i]) & (src[i] <= upper);
+        }
+        break;
+      case PredicateType::IN:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = std::binary_search(values.begin(), values.end(), src[i]);
+        }
+        break;
+      case PredicateType::IS_NULL:
+        std::memset(result, 0, tuple_count);
+        break;
+      case PredicateType::IS_NOT_NULL:
+        std::memset(result, 1, tuple_count);
+        break;
+      case PredicateType::PREFIX:
+      case PredicateType::LIKE:
+        for (u32 i = 0; i < tuple_count; i++) {
+          result[i] = matches(src[i]);
+        }
+        break;
+    }
+  }
+};
+// -------------------------------------------------------------------------------------
+using Predicate = TPredicate<INTEGER>;
+using DoublePredicate = TPredicate<DOUBLE>;
+using FloatPredicate = TPredicate<FLOAT>;
+using BigIntPredicate = TPredicate<BIGINT>;
+using StringPredicate = TPredicate<str>;
+// -------------------------------------------------------------------------------------
+// The qualifying codes of a dictionary. Dictionary schemes evaluate the
+// predicate once per distinct value instead of once per row and then only have
+// to filter the codes.
+struct CodeSelection {
+  vector<BITMAP> matches;  // one entry per code
+  u32 match_count = 0;
+  u32 first_code = 0;
+  u32 last_code = 0;
+  // -------------------------------------------------------------------------------------
+  template <typename MatchFunction>
+  static CodeSelection build(u32 dict_size, MatchFunction&& matches_code) {
+    CodeSelection selection;
+    selection.matches.resize(dict_size);
+    for (u32 code = 0; code < dict_size; code++) {
+      const bool match = matches_code(code);
+      selection.matches[code] = match;
+      if (match) {
+        if (selection.match_count == 0) {
+          selection.first_code = code;
+        }
+        selection.last_code = code;
+        selection.match_count++;
+      }
+    }
+    return selection;
+  }
+  // The codes [begin, end) of a sorted dictionary
+  static CodeSelection range(u32 dict_size, u32 begin, u32 end) {
+    return build(dict_size, [&](u32 code) { return begin <= code && code < end; });
+  }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] inline bool none() const { return match_count == 0; }
+  [[nodiscard]] inline bool all() const { return match_count == matches.size(); }
+  // Sorted dictionaries turn every comparison into a single range of codes,
+  // which can be pushed down into the scheme of the codes.
+  [[nodiscard]] inline bool isRange() const {
+    return match_count > 0 && last_code - first_code + 1 == match_count;
+  }
+  [[nodiscard]] inline Predicate rangePredicate() const {
+    return Predicate::between(static_cast<INTEGER>(first_code), static_cast<INTEGER>(last_code));
+  }
+  // -------------------------------------------------------------------------------------
+  template <typename CodeType>
+  inline void apply(const CodeType* codes, u32 tuple_count, BITMAP* result) const {
+    const BITMAP* code_matches = matches.data();
+    for (u32 i = 0; i < tuple_count; i++) {
+      result[i] = code_matches[codes[i]];
+    }
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -41,6 +41,24 @@ struct SchemeConfig {
     uint32_t pseudodecimal_significant_digit_bits_limits{31};
   } doubles;
   // ------------------------------------------------------------------------------
+  struct {
+    // maximum percentage of unique elements in a block
+    // for which frequency compression will be enabled
+    uint32_t frequency_threshold_pct{50};
+    // the average run length has to be higher than this for bigint RLE to be
+    // considered
+    uint32_t rle_run_length_threshold{2};
+  } bigints;
+  // ------------------------------------------------------------------------------
+  struct {
+    // maximum percentage of unique elements in a block
+    // for which frequency compression will be enabled
+    uint32_t frequency_threshold_pct{50};
+    // the average run length has to be higher than this for float RLE to be
+    // considered
+    uint32_t rle_run_length_threshold{2};
+  } floats;
+  // ------------------------------------------------------------------------------
   static constexpr size_t FSST_THRESHOLD = 16ul * 1024;
   struct {
     // in fused dictionary + fsst encoding, the dictionary needs
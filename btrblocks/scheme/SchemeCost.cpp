@@ -0,0 +1,147 @@
+// -------------------------------------------------------------------------------------
+#include "SchemeCost.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Exceptions.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// clang-format off
+constexpr std::pair<IntegerSchemeType, double> DEFAULT_INTEGER_SPEEDS[] = {
+    {IntegerSchemeType::UNCOMPRESSED, 40}, {IntegerSchemeType::ONE_VALUE, 30},
+    {IntegerSchemeType::DICT, 8},          {IntegerSchemeType::RLE, 10},
+    {IntegerSchemeType::PFOR, 6},          {IntegerSchemeType::BP, 12},
+    {IntegerSchemeType::FREQUENCY, 3},     {IntegerSchemeType::FOR, 10},
+    {IntegerSchemeType::PFOR_DELTA, 4},    {IntegerSchemeType::TRUNCATION_8, 12},
+    {IntegerSchemeType::TRUNCATION_16, 12}, {IntegerSchemeType::DICTIONARY_8, 8},
+    {IntegerSchemeType::DICTIONARY_16, 8}, {IntegerSchemeType::DELTA, 8},
+    {IntegerSchemeType::DELTA_OF_DELTA, 6}};
+constexpr std::pair<DoubleSchemeType, double> DEFAULT_DOUBLE_SPEEDS[] = {
+    {DoubleSchemeType::UNCOMPRESSED, 40}, {DoubleSchemeType::ONE_VALUE, 30},
+    {DoubleSchemeType::DICT, 6},          {DoubleSchemeType::RLE, 8},
+    {DoubleSchemeType::FREQUENCY, 3},     {DoubleSchemeType::PSEUDODECIMAL, 1.5},
+    {DoubleSchemeType::ALP, 5},           {DoubleSchemeType::XOR, 1},
+    {DoubleSchemeType::DOUBLE_BP, 4},     {DoubleSchemeType::DICTIONARY_8, 6},
+    {DoubleSchemeType::DICTIONARY_16, 6}};
+constexpr std::pair<FloatSchemeType, double> DEFAULT_FLOAT_SPEEDS[] = {
+    {FloatSchemeType::UNCOMPRESSED, 40}, {FloatSchemeType::ONE_VALUE, 30},
+    {FloatSchemeType::DICT, 5},          {FloatSchemeType::RLE, 6},
+    {FloatSchemeType::FREQUENCY, 2},     {FloatSchemeType::ALP, 4},
+    {FloatSchemeType::XOR, 1}};
+constexpr std::pair<BigIntSchemeType, double> DEFAULT_BIGINT_SPEEDS[] = {
+    {BigIntSchemeType::UNCOMPRESSED, 40}, {BigIntSchemeType::ONE_VALUE, 30},
+    {BigIntSchemeType::DICT, 6},          {BigIntSchemeType::RLE, 8},
+    {BigIntSchemeType::FREQUENCY, 3},     {BigIntSchemeType::FOR, 8},
+    {BigIntSchemeType::BP, 3},            {BigIntSchemeType::DELTA, 2}};
+constexpr std::pair<StringSchemeType, double> DEFAULT_STRING_SPEEDS[] = {
+    {StringSchemeType::UNCOMPRESSED, 20}, {StringSchemeType::ONE_VALUE, 20},
+    {StringSchemeType::DICT, 6},          {StringSchemeType::FSST, 2},
+    {StringSchemeType::DICTIONARY_8, 6},  {StringSchemeType::DICTIONARY_16, 6}};
+// clang-format on
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+SchemeCost& SchemeCost::get() {
+  static SchemeCost cost;
+  return cost;
+}
+// -------------------------------------------------------------------------------------
+SchemeCost::SchemeCost() {
+  speeds.fill(1.0);
+  for (auto [scheme, speed] : DEFAULT_INTEGER_SPEEDS) {
+    setDecompressionSpeed(ColumnType::INTEGER, CB(scheme), speed);
+  }
+  for (auto [scheme, speed] : DEFAULT_DOUBLE_SPEEDS) {
+    setDecompressionSpeed(ColumnType::DOUBLE, CB(scheme), speed);
+  }
+  for (auto [scheme, speed] : DEFAULT_STRING_SPEEDS) {
+    setDecompressionSpeed(ColumnType::STRING, CB(scheme), speed);
+  }
+  for (auto [scheme, speed] : DEFAULT_FLOAT_SPEEDS) {
+    setDecompressionSpeed(ColumnType::FLOAT, CB(scheme), speed);
+  }
+  for (auto [scheme, speed] : DEFAULT_BIGINT_SPEEDS) {
+    setDecompressionSpeed(ColumnType::BIGINT, CB(scheme), speed);
+  }
+}
+// -------------------------------------------------------------------------------------
+u32 SchemeCost::index(ColumnType type, u8 scheme_code) {
+  if (type != ColumnType::INTEGER && type != ColumnType::DOUBLE && type != ColumnType::STRING &&
+      type != ColumnType::FLOAT && type != ColumnType::BIGINT) {
+    throw Generic_Exception("No scheme costs for this type");
+  }
+  if (scheme_code >= SCHEME_COUNT) {
+    throw Generic_Exception("Unknown scheme code " + std::to_string(scheme_code));
+  }
+  return static_cast<u32>(type) * SCHEME_COUNT + scheme_code;
+}
+// -------------------------------------------------------------------------------------
+double SchemeCost::decompressionSpeed(ColumnType type, u8 scheme_code) const {
+  return speeds[index(type, scheme_code)];
+}
+// -------------------------------------------------------------------------------------
+void SchemeCost::setDecompressionSpeed(ColumnType type, u8 scheme_code, double speed) {
+  if (!(speed > 0)) {
+    throw Generic_Exception("Decompression speed has to be positive");
+  }
+  speeds[index(type, scheme_code)] = speed;
+}
+// -------------------------------------------------------------------------------------
+void SchemeCost::load(const string& path) {
+  std::ifstream file(path);
+  if (!file.good()) {
+    throw Generic_Exception("Opening scheme cost file failed");
+  }
+  string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    string type, name;
+    u32 scheme_code;
+    double speed;
+    if (!(fields >> type >> scheme_code >> name >> speed)) {
+      throw Generic_Exception("Malformed scheme cost line: " + line);
+    }
+    setDecompressionSpeed(ConvertStringToType(type), std::min<u32>(scheme_code, 255), speed);
+  }
+}
+// -------------------------------------------------------------------------------------
+void SchemeCost::save(const string& path) const {
+  std::ofstream file(path);
+  if (!file.good()) {
+    throw Generic_Exception("Opening scheme cost file failed");
+  }
+  file << "# type scheme_code scheme GB/s\n";
+  // Every scheme that has a default, so that the file can be edited by hand
+  auto write = [&](ColumnType type, auto scheme) {
+    file << ConvertTypeToString(type) << ' ' << CI(CB(scheme)) << ' '
+         << ConvertSchemeTypeToString(scheme) << ' ' << decompressionSpeed(type, CB(scheme))
+         << '\n';
+  };
+  for (const auto& entry : DEFAULT_INTEGER_SPEEDS) {
+    write(ColumnType::INTEGER, entry.first);
+  }
+  for (const auto& entry : DEFAULT_DOUBLE_SPEEDS) {
+    write(ColumnType::DOUBLE, entry.first);
+  }
+  for (const auto& entry : DEFAULT_STRING_SPEEDS) {
+    write(ColumnType::STRING, entry.first);
+  }
+  for (const auto& entry : DEFAULT_FLOAT_SPEEDS) {
+    write(ColumnType::FLOAT, entry.first);
+  }
+  for (const auto& entry : DEFAULT_BIGINT_SPEEDS) {
+    write(ColumnType::BIGINT, entry.first);
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
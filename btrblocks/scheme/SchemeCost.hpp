@@ -0,0 +1,40 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/SchemeType.hpp"
+// -------------------------------------------------------------------------------------
+#include <array>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// How fast every scheme decompresses, in GB/s of decompressed data, including
+// the cascade it usually ends up with. The defaults are rough numbers for a
+// current x86 server; calibrate-schemes measures them on the host and writes
+// a file that load() reads.
+class SchemeCost {
+ public:
+  static SchemeCost& get();
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] double decompressionSpeed(ColumnType type, u8 scheme_code) const;
+  void setDecompressionSpeed(ColumnType type, u8 scheme_code, double speed);
+  // -------------------------------------------------------------------------------------
+  // One scheme per line: <type> <scheme code> <scheme name> <GB/s>
+  void load(const string& path);
+  void save(const string& path) const;
+
+ private:
+  static constexpr u32 SCHEME_COUNT = static_cast<u32>(IntegerSchemeType::SCHEME_MAX);
+  static_assert(SCHEME_COUNT == static_cast<u32>(DoubleSchemeType::SCHEME_MAX) &&
+                SCHEME_COUNT == static_cast<u32>(StringSchemeType::SCHEME_MAX) &&
+                SCHEME_COUNT == static_cast<u32>(FloatSchemeType::SCHEME_MAX) &&
+                SCHEME_COUNT == static_cast<u32>(BigIntSchemeType::SCHEME_MAX));
+  // -------------------------------------------------------------------------------------
+  // Indexed by the column type, up to BIGINT
+  std::array<double, (static_cast<u32>(ColumnType::BIGINT) + 1) * SCHEME_COUNT> speeds;
+  // -------------------------------------------------------------------------------------
+  SchemeCost();
+  [[nodiscard]] static u32 index(ColumnType type, u8 scheme_code);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 // -------------------------------------------------------------------------------------
 #include "common/Utils.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/integer/Delta.hpp"
 #include "scheme/integer/DynamicDictionary.hpp"
 #include "scheme/integer/Frequency.hpp"
 #include "scheme/integer/OneValue.hpp"
@@ -15,17 +16,36 @@
 #include "scheme/integer/FixedDictionary.hpp"
 #include "scheme/integer/Truncation.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/double/Alp.hpp"
 #include "scheme/double/DynamicDictionary.hpp"
 #include "scheme/double/OneValue.hpp"
 #include "scheme/double/Pseudodecimal.hpp"
 #include "scheme/double/RLE.hpp"
 #include "scheme/double/Uncompressed.hpp"
+#include "scheme/double/Xor.hpp"
 // legacy schemes
 #include "scheme/double/DoubleBP.hpp"
 #include "scheme/double/FixedDictionary.hpp"
 #include "scheme/double/Frequency.hpp"
 #include "scheme/double/MaxExponent.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/float/Alp.hpp"
+#include "scheme/float/DynamicDictionary.hpp"
+#include "scheme/float/Frequency.hpp"
+#include "scheme/float/OneValue.hpp"
+#include "scheme/float/RLE.hpp"
+#include "scheme/float/Uncompressed.hpp"
+#include "scheme/float/Xor.hpp"
+// -------------------------------------------------------------------------------------
+#include "scheme/bigint/BP.hpp"
+#include "scheme/bigint/Delta.hpp"
+#include "scheme/bigint/DynamicDictionary.hpp"
+#include "scheme/bigint/FOR.hpp"
+#include "scheme/bigint/Frequency.hpp"
+#include "scheme/bigint/OneValue.hpp"
+#include "scheme/bigint/RLE.hpp"
+#include "scheme/bigint/Uncompressed.hpp"
+// -------------------------------------------------------------------------------------
 #include "scheme/string/DynamicDictionary.hpp"
 #include "scheme/string/Fsst.hpp"
 #include "scheme/string/OneValue.hpp"
@@ -64,6 +84,8 @@ SchemesCollection::SchemesCollection() {
                  RLE,
                  FBP,
                  PBP,
+                 Delta,
+                 DeltaOfDelta,
                  Frequency,
                  FOR,
                  PBP_DELTA,
@@ -88,11 +110,48 @@ SchemesCollection::SchemesCollection() {
                  RLE,
                  Frequency,
                  Decimal,
+                 Alp,
+                 Xor,
                  DoubleBP,
                  Dictionary8,
                  Dictionary16>(double_schemes, cfg.doubles.schemes);
     // clang-format on
   }
+  // Float Schemes
+  {
+    using namespace floats;
+    // required schemes
+    die_if(cfg.floats.schemes.isEnabled(FloatSchemeType::ONE_VALUE));
+    die_if(cfg.floats.schemes.isEnabled(FloatSchemeType::UNCOMPRESSED));
+    // optional float schemes
+    // clang-format off
+    addIfEnabled<Uncompressed,
+                 OneValue,
+                 DynamicDictionary,
+                 RLE,
+                 Frequency,
+                 Alp,
+                 Xor>(float_schemes, cfg.floats.schemes);
+    // clang-format on
+  }
+  // BigInt Schemes
+  {
+    using namespace bigints;
+    // required schemes
+    die_if(cfg.bigints.schemes.isEnabled(BigIntSchemeType::ONE_VALUE));
+    die_if(cfg.bigints.schemes.isEnabled(BigIntSchemeType::UNCOMPRESSED));
+    // optional bigint schemes
+    // clang-format off
+    addIfEnabled<Uncompressed,
+                 OneValue,
+                 DynamicDictionary,
+                 RLE,
+                 Frequency,
+                 FOR,
+                 BP,
+                 Delta>(bigint_schemes, cfg.bigints.schemes);
+    // clang-format on
+  }
   // String Schemes
   {
     using namespace legacy::strings;
@@ -6,6 +6,8 @@ namespace btrblocks {
 struct SchemesCollection {
   std::unordered_map<IntegerSchemeType, unique_ptr<IntegerScheme>> integer_schemes;
   std::unordered_map<DoubleSchemeType, unique_ptr<DoubleScheme>> double_schemes;
+  std::unordered_map<FloatSchemeType, unique_ptr<FloatScheme>> float_schemes;
+  std::unordered_map<BigIntSchemeType, unique_ptr<BigIntScheme>> bigint_schemes;
   std::unordered_map<StringSchemeType, unique_ptr<StringScheme>> string_schemes;
   SchemesCollection();
 };
@@ -16,6 +16,8 @@ enum class IntegerSchemeType : uint8_t {
   RLE = 3,
   PFOR = 4,
   BP = 5,
+  DELTA = 6,
+  DELTA_OF_DELTA = 7,
   // legacy schemes
   FREQUENCY = 25,
   FOR = 26,
@@ -29,7 +31,8 @@ enum class IntegerSchemeType : uint8_t {
 using IntegerSchemeSet = SchemeSet<IntegerSchemeType>;
 constexpr IntegerSchemeSet defaultIntegerSchemes() {
   return {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::ONE_VALUE, IntegerSchemeType::DICT,
-          IntegerSchemeType::RLE,          IntegerSchemeType::PFOR,      IntegerSchemeType::BP};
+          IntegerSchemeType::RLE,          IntegerSchemeType::PFOR,      IntegerSchemeType::BP,
+          IntegerSchemeType::DELTA,        IntegerSchemeType::DELTA_OF_DELTA};
 };
 // ------------------------------------------------------------------------------
 enum class DoubleSchemeType : uint8_t {
@@ -39,6 +42,8 @@ enum class DoubleSchemeType : uint8_t {
   RLE = 3,
   FREQUENCY = 4,
   PSEUDODECIMAL = 5,
+  ALP = 6,
+  XOR = 7,
   // legacy schemes
   DOUBLE_BP = 28,
   DICTIONARY_8 = 29,
@@ -49,7 +54,43 @@ using DoubleSchemeSet = SchemeSet<DoubleSchemeType>;
 constexpr DoubleSchemeSet defaultDoubleSchemes() {
   return {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::ONE_VALUE,
           DoubleSchemeType::DICT,         DoubleSchemeType::RLE,
-          DoubleSchemeType::FREQUENCY,    DoubleSchemeType::PSEUDODECIMAL};
+          DoubleSchemeType::FREQUENCY,    DoubleSchemeType::PSEUDODECIMAL,
+          DoubleSchemeType::ALP,          DoubleSchemeType::XOR};
+};
+// ------------------------------------------------------------------------------
+enum class FloatSchemeType : uint8_t {
+  UNCOMPRESSED = 0,
+  ONE_VALUE = 1,
+  DICT = 2,
+  RLE = 3,
+  FREQUENCY = 4,
+  ALP = 5,
+  XOR = 6,
+  SCHEME_MAX = 32
+};
+using FloatSchemeSet = SchemeSet<FloatSchemeType>;
+constexpr FloatSchemeSet defaultFloatSchemes() {
+  return {FloatSchemeType::UNCOMPRESSED, FloatSchemeType::ONE_VALUE, FloatSchemeType::DICT,
+          FloatSchemeType::RLE,          FloatSchemeType::FREQUENCY, FloatSchemeType::ALP,
+          FloatSchemeType::XOR};
+};
+// ------------------------------------------------------------------------------
+enum class BigIntSchemeType : uint8_t {
+  UNCOMPRESSED = 0,
+  ONE_VALUE = 1,
+  DICT = 2,
+  RLE = 3,
+  FREQUENCY = 4,
+  FOR = 5,
+  BP = 6,
+  DELTA = 7,
+  SCHEME_MAX = 32
+};
+using BigIntSchemeSet = SchemeSet<BigIntSchemeType>;
+constexpr BigIntSchemeSet defaultBigIntSchemes() {
+  return {BigIntSchemeType::UNCOMPRESSED, BigIntSchemeType::ONE_VALUE, BigIntSchemeType::DICT,
+          BigIntSchemeType::RLE,          BigIntSchemeType::FREQUENCY, BigIntSchemeType::FOR,
+          BigIntSchemeType::BP,           BigIntSchemeType::DELTA};
 };
 // ------------------------------------------------------------------------------
 enum class StringSchemeType : uint8_t {
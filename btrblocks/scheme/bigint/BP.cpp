@@ -0,0 +1,111 @@
+#include "BP.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+inline u32 bitsNeeded(u64 range) {
+  return range == 0 ? 0 : 64 - __builtin_clzll(range);
+}
+// -------------------------------------------------------------------------------------
+inline u32 wordCount(u32 tuple_count, u32 width) {
+  return (static_cast<u64>(tuple_count) * width + 63) / 64;
+}
+// -------------------------------------------------------------------------------------
+inline u64 unpack(const u64* words, u32 row, u32 width) {
+  if (width == 0) {
+    return 0;
+  }
+  const u64 bit = static_cast<u64>(row) * width;
+  const u32 offset = bit % 64;
+  u64 value = words[bit / 64] >> offset;
+  if (offset + width > 64) {
+    value |= words[bit / 64 + 1] << (64 - offset);
+  }
+  return width == 64 ? value : value & ((u64(1) << width) - 1);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+double BP::expectedCompressionRatio(BigIntStats& stats, u8) {
+  const u32 width = bitsNeeded(static_cast<u64>(stats.max) - static_cast<u64>(stats.min));
+  const u32 after_size = sizeof(BPStructure) + wordCount(stats.tuple_count, width) * sizeof(u64);
+  return CD(stats.total_size) / CD(after_size);
+}
+// -------------------------------------------------------------------------------------
+u32 BP::compress(const BIGINT* src, const BITMAP*, u8* dest, BigIntStats& stats, u8) {
+  auto& col_struct = *reinterpret_cast<BPStructure*>(dest);
+  // Null rows hold values as well, the bounds of the stats include them
+  col_struct.base = stats.min;
+  col_struct.width = bitsNeeded(static_cast<u64>(stats.max) - static_cast<u64>(stats.min));
+  std::memset(col_struct.padding, 0, sizeof(col_struct.padding));
+  const u32 width = col_struct.width;
+  const u32 word_count = wordCount(stats.tuple_count, width);
+  std::memset(col_struct.words, 0, word_count * sizeof(u64));
+  // -------------------------------------------------------------------------------------
+  for (u32 row_i = 0; row_i < stats.tuple_count && width > 0; row_i++) {
+    const u64 value = static_cast<u64>(src[row_i]) - static_cast<u64>(col_struct.base);
+    const u64 bit = static_cast<u64>(row_i) * width;
+    const u32 offset = bit % 64;
+    col_struct.words[bit / 64] |= value << offset;
+    if (offset + width > 64) {
+      col_struct.words[bit / 64 + 1] = value >> (64 - offset);
+    }
+  }
+  return sizeof(BPStructure) + word_count * sizeof(u64);
+}
+// -------------------------------------------------------------------------------------
+void BP::decompress(BIGINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  const auto& col_struct = *reinterpret_cast<const BPStructure*>(src);
+  const u64 base = static_cast<u64>(col_struct.base);
+  const u32 width = col_struct.width;
+  if (width == 0) {
+    std::fill(dest, dest + tuple_count, col_struct.base);
+    return;
+  }
+  // The bit position moves on by width per row, the division is left out
+  const u64 mask = width == 64 ? ~u64(0) : (u64(1) << width) - 1;
+  const u64* words = col_struct.words;
+  u32 offset = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    u64 value = *words >> offset;
+    if (offset + width >= 64) {
+      words++;
+      if (offset + width > 64) {
+        value |= *words << (64 - offset);
+      }
+      offset = offset + width - 64;
+    } else {
+      offset += width;
+    }
+    dest[row_i] = static_cast<BIGINT>(base + (value & mask));
+  }
+}
+// -------------------------------------------------------------------------------------
+void BP::decompressSelected(BIGINT* dest,
+                            const u32* selection,
+                            u32 count,
+                            BitmapWrapper*,
+                            const u8* src,
+                            u32,
+                            u32) {
+  const auto& col_struct = *reinterpret_cast<const BPStructure*>(src);
+  const u64 base = static_cast<u64>(col_struct.base);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = static_cast<BIGINT>(base + unpack(col_struct.words, selection[i], col_struct.width));
+  }
+}
+// -------------------------------------------------------------------------------------
+BIGINT BP::lookup(const u8* src, u32 row, u32, u32) {
+  const auto& col_struct = *reinterpret_cast<const BPStructure*>(src);
+  return static_cast<BIGINT>(static_cast<u64>(col_struct.base) +
+                             unpack(col_struct.words, row, col_struct.width));
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,44 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// The offsets from the minimum packed with the same number of bits each into
+// u64 words, for value ranges too wide for FOR. Every row sits at a known bit
+// position, so single rows are read without decoding their neighbours.
+struct BPStructure {
+  BIGINT base;  // the minimum
+  u8 width;     // bits per offset, 0 to 64
+  u8 padding[7];
+  u64 words[];
+};
+// -------------------------------------------------------------------------------------
+class BP : public BigIntScheme {
+ public:
+  // The size follows from the bounds alone, no sample is compressed
+  double expectedCompressionRatio(BigIntStats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               BigIntStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  void decompressSelected(BIGINT* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  BIGINT lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  inline BigIntSchemeType schemeType() override { return staticSchemeType(); }
+  inline static BigIntSchemeType staticSchemeType() { return BigIntSchemeType::BP; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
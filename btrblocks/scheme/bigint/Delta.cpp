@@ -0,0 +1,69 @@
+#include "Delta.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+inline BIGINT zigzagEncode(u64 delta) {
+  return static_cast<BIGINT>((delta << 1) ^ static_cast<u64>(static_cast<BIGINT>(delta) >> 63));
+}
+// -------------------------------------------------------------------------------------
+inline u64 zigzagDecode(u64 encoded) {
+  return (encoded >> 1) ^ (0ull - (encoded & 1));
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+u32 Delta::compress(const BIGINT* src,
+                    const BITMAP*,
+                    u8* dest,
+                    BigIntStats& stats,
+                    u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<DeltaStructure*>(dest);
+  const u32 tuple_count = stats.tuple_count;
+  auto deltas = ThreadCache::get().arena.allocate<BIGINT>(tuple_count + SIMD_EXTRA_ELEMENTS(BIGINT));
+  // -------------------------------------------------------------------------------------
+  // The first value is kept in the header, its delta is 0
+  col_struct.base = tuple_count > 0 ? src[0] : 0;
+  u64 previous = static_cast<u64>(col_struct.base);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    deltas[row_i] = zigzagEncode(static_cast<u64>(src[row_i]) - previous);
+    previous = static_cast<u64>(src[row_i]);
+  }
+  // -------------------------------------------------------------------------------------
+  u32 used_space;
+  BigIntSchemePicker::compress(deltas, nullptr, col_struct.data, tuple_count,
+                               allowed_cascading_level - 1, used_space, col_struct.deltas_scheme,
+                               autoScheme(), "deltas");
+  return sizeof(DeltaStructure) + used_space;
+}
+// -------------------------------------------------------------------------------------
+void Delta::decompress(BIGINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  BigIntScheme& deltas_scheme =
+      BigIntSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme);
+  deltas_scheme.decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+  u64 running = static_cast<u64>(col_struct.base);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    running += zigzagDecode(static_cast<u64>(dest[row_i]));
+    dest[row_i] = static_cast<BIGINT>(running);
+  }
+}
+// -------------------------------------------------------------------------------------
+string Delta::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  BigIntScheme& deltas_scheme =
+      BigIntSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme);
+  return this->selfDescription() + "\n\t-> ([bigint] deltas) " +
+         deltas_scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+bool Delta::isUsable(BigIntStats& stats) {
+  // Needs at least two distinct values, like integers::Delta
+  return stats.unique_count > 1 && stats.tuple_count > 1;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
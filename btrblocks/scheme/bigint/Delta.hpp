@@ -0,0 +1,35 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// Zig-zag encoded differences between neighbouring values, taken modulo 2^64,
+// cascaded to the bigint schemes. Timestamps turn into small or constant
+// differences, and DELTA on the differences gives the differences of them.
+struct DeltaStructure {
+  BIGINT base;  // first value
+  u8 deltas_scheme;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class Delta : public BigIntScheme {
+ public:
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               BigIntStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  bool isUsable(BigIntStats& stats) override;
+  inline BigIntSchemeType schemeType() override { return staticSchemeType(); }
+  inline static BigIntSchemeType staticSchemeType() { return BigIntSchemeType::DELTA; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+#include "FOR.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+u32 FOR::compress(const BIGINT* src,
+                  const BITMAP*,
+                  u8* dest,
+                  BigIntStats& stats,
+                  u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<FORStructure*>(dest);
+  const u32 tuple_count = stats.tuple_count;
+  // Null rows hold values as well, the bounds of the stats include them
+  col_struct.base = stats.min;
+  auto offsets =
+      ThreadCache::get().arena.allocate<INTEGER>(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    offsets[row_i] = static_cast<INTEGER>(static_cast<u64>(src[row_i]) -
+                                          static_cast<u64>(col_struct.base));
+  }
+  // -------------------------------------------------------------------------------------
+  u32 used_space;
+  IntegerSchemePicker::compress(offsets, nullptr, col_struct.data, tuple_count,
+                                allowed_cascading_level - 1, used_space,
+                                col_struct.offsets_scheme, autoScheme(), "offsets");
+  return sizeof(FORStructure) + used_space;
+}
+// -------------------------------------------------------------------------------------
+void FOR::decompress(BIGINT* dest,
+                     BitmapWrapper*,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  thread_local std::vector<std::vector<INTEGER>> offsets_v;
+  auto offsets = get_level_data(offsets_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme)
+      .decompress(offsets, nullptr, col_struct.data, tuple_count, level + 1);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    dest[row_i] = col_struct.base + offsets[row_i];
+  }
+}
+// -------------------------------------------------------------------------------------
+void FOR::decompressSelected(BIGINT* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  thread_local std::vector<std::vector<INTEGER>> offsets_v;
+  auto offsets = get_level_data(offsets_v, count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme)
+      .decompressSelected(offsets, selection, count, nullptr, col_struct.data, tuple_count,
+                          level + 1);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = col_struct.base + offsets[i];
+  }
+}
+// -------------------------------------------------------------------------------------
+BIGINT FOR::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  return col_struct.base + IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme)
+                               .lookup(col_struct.data, row, tuple_count, level + 1);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<BIGINT> FOR::aggregate(BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  auto offsets = IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme)
+                     .aggregate(nullmap, col_struct.data, tuple_count, level + 1);
+  TAggregate<BIGINT> aggregate;
+  if (offsets.count == 0) {
+    return aggregate;
+  }
+  using SumType = TAggregate<BIGINT>::SumType;
+  aggregate.sum = offsets.sum + static_cast<SumType>(col_struct.base) * offsets.count;
+  aggregate.count = offsets.count;
+  aggregate.min = col_struct.base + offsets.min;
+  aggregate.max = col_struct.base + offsets.max;
+  return aggregate;
+}
+// -------------------------------------------------------------------------------------
+string FOR::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme);
+  return this->selfDescription() + " -> ([int] offsets) " +
+         scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+bool FOR::isUsable(BigIntStats& stats) {
+  return static_cast<u64>(stats.max) - static_cast<u64>(stats.min) <=
+         static_cast<u64>(std::numeric_limits<INTEGER>::max());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
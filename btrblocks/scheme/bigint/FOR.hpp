@@ -0,0 +1,48 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// Frame of reference: the offsets from the minimum fit into 32 bits whenever
+// the values span less than 2^31, e.g. the IDs of one block. They are
+// cascaded to the integer schemes, which bring the SIMD bit-packing along.
+struct FORStructure {
+  BIGINT base;  // the minimum
+  u8 offsets_scheme;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class FOR : public BigIntScheme {
+ public:
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               BigIntStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  void decompressSelected(BIGINT* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  BIGINT lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  // The offsets are aggregated in their own scheme and shifted by the base
+  TAggregate<BIGINT> aggregate(BitmapWrapper* nullmap,
+                               const u8* src,
+                               u32 tuple_count,
+                               u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  bool isUsable(BigIntStats& stats) override;
+  inline BigIntSchemeType schemeType() override { return staticSchemeType(); }
+  inline static BigIntSchemeType staticSchemeType() { return BigIntSchemeType::FOR; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
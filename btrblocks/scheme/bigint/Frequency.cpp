@@ -0,0 +1,56 @@
+#include "Frequency.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/Frequency.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+using MyFrequency = TFrequency<BIGINT, BigIntScheme, BigIntStats, BigIntSchemeType>;
+// -------------------------------------------------------------------------------------
+double Frequency::expectedCompressionRatio(BigIntStats& stats, u8 allowed_cascading_level) {
+  if (CD(stats.unique_count) * 100.0 / CD(stats.tuple_count) >
+      SchemeConfig::get().bigints.frequency_threshold_pct) {
+    return 0;
+  }
+  return BigIntScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Frequency::compress(const BIGINT* src,
+                        const BITMAP* nullmap,
+                        u8* dest,
+                        BigIntStats& stats,
+                        u8 allowed_cascading_level) {
+  return MyFrequency::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Frequency::decompress(BIGINT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  return MyFrequency::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<BIGINT> Frequency::aggregate(BitmapWrapper* nullmap,
+                                        const u8* src,
+                                        u32 tuple_count,
+                                        u32 level) {
+  return MyFrequency::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void Frequency::scan(const BigIntPredicate& predicate,
+                     BITMAP* result,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  MyFrequency::scanColumn(predicate, result, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Frequency::fullDescription(const u8* src) {
+  return MyFrequency::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,69 @@
+#include "RLE.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/RLE.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+using MyRLE = TRLE<BIGINT, BigIntScheme, BigIntStats, BigIntSchemeType>;
+// -------------------------------------------------------------------------------------
+double RLE::expectedCompressionRatio(BigIntStats& stats, u8 allowed_cascading_level) {
+  if (stats.average_run_length < SchemeConfig::get().bigints.rle_run_length_threshold) {
+    return 0;
+  }
+  return BigIntScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::compress(const BIGINT* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  BigIntStats& stats,
+                  u8 allowed_cascading_level) {
+  return MyRLE::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompress(BIGINT* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompressSelected(BIGINT* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  MyRLE::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+BIGINT RLE::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyRLE::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::scan(const BigIntPredicate& predicate,
+               BITMAP* result,
+               const u8* src,
+               u32 tuple_count,
+               u32 level) {
+  MyRLE::scanColumn(predicate, result, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<BIGINT> RLE::aggregate(BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level) {
+  return MyRLE::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string RLE::fullDescription(const u8* src) {
+  return MyRLE::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
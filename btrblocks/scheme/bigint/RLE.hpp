@@ -0,0 +1,43 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+class RLE : public BigIntScheme {
+ public:
+  double expectedCompressionRatio(BigIntStats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               BigIntStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  void decompressSelected(BIGINT* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  BIGINT lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  void scan(const BigIntPredicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  TAggregate<BIGINT> aggregate(BitmapWrapper* nullmap,
+                               const u8* src,
+                               u32 tuple_count,
+                               u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline BigIntSchemeType schemeType() override { return staticSchemeType(); }
+  inline static BigIntSchemeType staticSchemeType() { return BigIntSchemeType::RLE; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
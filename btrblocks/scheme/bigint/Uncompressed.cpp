@@ -0,0 +1,48 @@
+#include "Uncompressed.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+double Uncompressed::expectedCompressionRatio(BigIntStats&, u8) {
+  return 1.0;
+}
+// -------------------------------------------------------------------------------------
+u32 Uncompressed::compress(const BIGINT* src, const BITMAP*, u8* dest, BigIntStats& stats, u8) {
+  std::memcpy(dest, src, stats.total_size);
+  return stats.total_size;
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompress(BIGINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  std::memcpy(dest, src, tuple_count * sizeof(BIGINT));
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompressSelected(BIGINT* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32,
+                                      u32) {
+  auto values = reinterpret_cast<const BIGINT*>(src);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+BIGINT Uncompressed::lookup(const u8* src, u32 row, u32, u32) {
+  return reinterpret_cast<const BIGINT*>(src)[row];
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::scan(const BigIntPredicate& predicate,
+                        BITMAP* result,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32) {
+  predicate.evaluate(reinterpret_cast<const BIGINT*>(src), tuple_count, result);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,32 @@
+// ------------------------------------------------------------------------------
+#include "Alp.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Alp.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+using MyAlp = TAlp<DOUBLE, u64, DoubleScheme, DoubleStats, DoubleSchemeType>;
+// -------------------------------------------------------------------------------------
+u32 Alp::compress(const DOUBLE* src,
+                  const BITMAP*,
+                  u8* dest,
+                  DoubleStats& stats,
+                  u8 allowed_cascading_level) {
+  // ignore bitmap
+  return MyAlp::compressColumn(src, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Alp::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
+  MyAlp::decompressColumn(dest, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+DOUBLE Alp::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyAlp::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Alp::fullDescription(const u8* src) {
+  return MyAlp::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
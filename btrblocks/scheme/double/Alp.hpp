@@ -0,0 +1,30 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+// Adaptive lossless floating point, see TAlp: every vector of values is
+// scaled by a power of ten and rounded to integers, values that do not
+// survive the round trip are stored as exceptions.
+class Alp : public DoubleScheme {
+ public:
+  u32 compress(const DOUBLE* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               DoubleStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(DOUBLE* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
+  inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::ALP; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
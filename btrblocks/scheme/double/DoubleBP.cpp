@@ -56,10 +56,6 @@ void DoubleBP::decompress(DOUBLE* dest,
   }
 }
 // -------------------------------------------------------------------------------------
-DOUBLE DoubleBP::lookup(u32) {
-  UNREACHABLE();
-};
-// -------------------------------------------------------------------------------------
 void DoubleBP::scan(Predicate, BITMAP*, const u8*, u32) {
   UNREACHABLE();
 };
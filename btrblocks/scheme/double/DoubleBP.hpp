@@ -25,7 +25,6 @@ class DoubleBP : public DoubleScheme {
 
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::DOUBLE_BP; }
-  DOUBLE lookup(u32);
   void scan(Predicate, BITMAP*, const u8*, u32);
 };
 // -------------------------------------------------------------------------------------
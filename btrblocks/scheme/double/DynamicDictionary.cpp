@@ -34,6 +34,36 @@ void DynamicDictionary::decompress(DOUBLE* dest,
                                    u32 level) {
   return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
+// -------------------------------------------------------------------------------------
+TAggregate<DOUBLE> DynamicDictionary::aggregate(BitmapWrapper* nullmap,
+                                                const u8* src,
+                                                u32 tuple_count,
+                                                u32 level) {
+  return MyDynamicDictionary::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::decompressDictionary(vector<u8>& dictionary,
+                                            u32* codes,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+  return MyDynamicDictionary::decompressDictionaryColumn(dictionary, codes, src, tuple_count,
+                                                         level);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompressSelected(DOUBLE* dest,
+                                           const u32* selection,
+                                           u32 count,
+                                           BitmapWrapper*,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  MyDynamicDictionary::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+DOUBLE DynamicDictionary::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyDynamicDictionary::lookupRow(src, row, tuple_count, level);
+}
 
 string DynamicDictionary::fullDescription(const u8* src) {
   return MyDynamicDictionary::fullDescription(src, this->selfDescription());
@@ -18,6 +18,23 @@ class DynamicDictionary : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  TAggregate<DOUBLE> aggregate(BitmapWrapper* nullmap,
+                               const u8* src,
+                               u32 tuple_count,
+                               u32 level) override;
+  u32 decompressDictionary(vector<u8>& dictionary,
+                           u32* codes,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) override;
+  void decompressSelected(DOUBLE* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::DICT; }
@@ -40,6 +40,13 @@ void Frequency::decompress(DOUBLE* dest,
                            u32 level) {
   return MyFrequency::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
+// -------------------------------------------------------------------------------------
+TAggregate<DOUBLE> Frequency::aggregate(BitmapWrapper* nullmap,
+                                        const u8* src,
+                                        u32 tuple_count,
+                                        u32 level) {
+  return MyFrequency::aggregateColumn(nullmap, src, tuple_count, level);
+}
 
 string Frequency::fullDescription(const u8* src) {
   return MyFrequency::fullDescription(src, this->selfDescription());
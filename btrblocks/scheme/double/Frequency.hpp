@@ -18,6 +18,10 @@ class Frequency : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  TAggregate<DOUBLE> aggregate(BitmapWrapper* nullmap,
+                               const u8* src,
+                               u32 tuple_count,
+                               u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::FREQUENCY; }
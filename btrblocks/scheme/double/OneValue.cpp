@@ -12,7 +12,7 @@
 namespace btrblocks::legacy::doubles {
 // -------------------------------------------------------------------------------------
 double OneValue::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) {
-  if (stats.distinct_values.size() <= 1) {
+  if (stats.unique_count <= 1) {
     return stats.tuple_count;
   } else {
     return 0;
@@ -40,5 +40,33 @@ void OneValue::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple
   }
 }
 // -------------------------------------------------------------------------------------
+TAggregate<DOUBLE> OneValue::aggregate(BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32) {
+  // The value repeats for every non-null row
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  TAggregate<DOUBLE> aggregate;
+  aggregate.add(static_cast<DOUBLE>(col_struct.one_value),
+                nullmap == nullptr ? tuple_count : nullmap->cardinality());
+  return aggregate;
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompressSelected(DOUBLE* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper*,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill(dest, dest + count, col_struct.one_value);
+}
+// -------------------------------------------------------------------------------------
+DOUBLE OneValue::lookup(const u8* src, u32, u32, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  return col_struct.one_value;
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::doubles
 // -------------------------------------------------------------------------------------
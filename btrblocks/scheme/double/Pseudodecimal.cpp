@@ -10,12 +10,15 @@
 // -------------------------------------------------------------------------------------
 #include <cmath>
 #include <iomanip>
+#include <tuple>
 // -------------------------------------------------------------------------------------
 namespace btrblocks::doubles {
 
 const u32 max_exponent = 22;
 const u8 exponent_exception_code = 23;
 const u8 decimal_index_mask = 0x1F;
+// Blocks converted between two looks at the compression budget
+const u32 budget_check_interval = 256;
 static const double exact_fractions_of_ten[] = {
     1.0,
     0.1,
@@ -64,9 +67,12 @@ u32 Decimal::compress(const DOUBLE* src,
   // ignore bitmap
   auto& col_struct = *reinterpret_cast<DecimalStructure*>(dest);
   col_struct.variant_selector = 0;
-  vector<INTEGER> numbers_v;
-  vector<INTEGER> exponent_v;
-  vector<DOUBLE> patches_v;  // patches
+  // Every tuple ends up in exponents and either in numbers or patches
+  auto& arena = ThreadCache::get().arena;
+  auto numbers_v = arena.allocate<INTEGER>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  auto exponent_v = arena.allocate<INTEGER>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  auto patches_v = arena.allocate<DOUBLE>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE));
+  u32 numbers_count = 0, exponent_count = 0, patches_count = 0;
 
   u32 exception_count = 0;
   u8 run_count = 0;
@@ -75,6 +81,11 @@ u32 Decimal::compress(const DOUBLE* src,
   const u32 num_blocks = (stats.tuple_count + (block_size - 1)) / block_size;
   for (u32 block_i = 0; block_i < num_blocks; block_i++) {
     bool block_has_exception = false;
+    if (block_i % budget_check_interval == 0 && CompressionBudget::isExhausted()) {
+      // Out of time, the conversion of every value may take all exponents.
+      // Same as with too many exceptions, this makes the picker fall back.
+      return stats.total_size + 1000;
+    }
 
     const u32 row_start_i = block_i * block_size;
     const u32 row_end_i = std::min(row_start_i + block_size, stats.tuple_count);
@@ -106,8 +117,8 @@ u32 Decimal::compress(const DOUBLE* src,
       // Write result
       if (convertable) {
         die_if((std::floor(std::log2(converted_number)) + 1) <= 31);
-        exponent_v.push_back(static_cast<INTEGER>(exponent));
-        numbers_v.push_back(static_cast<INTEGER>(converted_number));
+        exponent_v[exponent_count++] = static_cast<INTEGER>(exponent);
+        numbers_v[numbers_count++] = static_cast<INTEGER>(converted_number);
       } else {
         block_has_exception = true;
         exception_count++;
@@ -117,8 +128,8 @@ u32 Decimal::compress(const DOUBLE* src,
           // process select uncompressed rather than Decimal
           return stats.total_size + 1000;
         }
-        exponent_v.push_back(exponent_exception_code);
-        patches_v.push_back(src[row_i]);
+        exponent_v[exponent_count++] = exponent_exception_code;
+        patches_v[patches_count++] = src[row_i];
       }
     }
 
@@ -134,13 +145,13 @@ u32 Decimal::compress(const DOUBLE* src,
     }
   }
 
-  col_struct.converted_count = numbers_v.size();
+  col_struct.converted_count = numbers_count;
   auto write_ptr = col_struct.data;
 
   // Compress significant digits
-  if (!numbers_v.empty()) {
+  if (numbers_count > 0) {
     u32 used_space;
-    IntegerSchemePicker::compress(numbers_v.data(), nullptr, write_ptr, numbers_v.size(),
+    IntegerSchemePicker::compress(numbers_v, nullptr, write_ptr, numbers_count,
                                   allowed_cascading_level - 1, used_space,
                                   col_struct.numbers_scheme, autoScheme(), "significant digits");
     write_ptr += used_space;
@@ -151,10 +162,7 @@ u32 Decimal::compress(const DOUBLE* src,
   {
     col_struct.exponents_offset = write_ptr - col_struct.data;
     u32 used_space;
-    SInteger32Stats e_stats =
-        SInteger32Stats::generateStats(exponent_v.data(), nullptr, exponent_v.size());
-    // cout << e_stats.min << '\t' << e_stats.max << endl;
-    IntegerSchemePicker::compress(exponent_v.data(), nullptr, write_ptr, exponent_v.size(),
+    IntegerSchemePicker::compress(exponent_v, nullptr, write_ptr, exponent_count,
                                   allowed_cascading_level - 1, used_space,
                                   col_struct.exponents_scheme, autoScheme(), "exponents");
     write_ptr += used_space;
@@ -165,7 +173,7 @@ u32 Decimal::compress(const DOUBLE* src,
   {
     col_struct.patches_offset = write_ptr - col_struct.data;
     u32 used_space;
-    DoubleSchemePicker::compress(patches_v.data(), nullptr, write_ptr, patches_v.size(),
+    DoubleSchemePicker::compress(patches_v, nullptr, write_ptr, patches_count,
                                  allowed_cascading_level - 1, used_space, col_struct.patches_scheme,
                                  autoScheme(), "patches");
     write_ptr += used_space;
@@ -451,6 +459,67 @@ void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_
 #endif
 }
 
+DOUBLE Decimal::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DecimalStructure*>(src);
+  const u8* exponents_src = col_struct.data + col_struct.exponents_offset;
+  IntegerScheme& exponents_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.exponents_scheme);
+  Roaring exceptions_bitmap = Roaring::read(
+      reinterpret_cast<const char*>(col_struct.data + col_struct.exceptions_map_offset), false);
+
+  // numbers and patches are stored densely, their position is row minus the
+  // number of patches (or numbers) before row. Patches only occur in the
+  // blocks marked in the exceptions bitmap, so only their exponents are needed.
+  thread_local std::vector<std::vector<u32>> exception_rows_v;
+  get_level_data(exception_rows_v, 0, level);
+  auto& exception_rows = exception_rows_v[level];
+  exception_rows.clear();
+  std::tuple<std::vector<u32>*, u32> param = {&exception_rows, row};
+  exceptions_bitmap.iterate(
+      [](uint32_t block_i, void* param_void) {
+        auto& [rows, row] = *reinterpret_cast<std::tuple<std::vector<u32>*, u32>*>(param_void);
+        if (block_i * block_size > row) {
+          return false;
+        }
+        for (u32 row_i = block_i * block_size; row_i < (block_i + 1) * block_size && row_i <= row;
+             row_i++) {
+          rows->push_back(row_i);
+        }
+        return true;
+      },
+      &param);
+
+  thread_local std::vector<std::vector<INTEGER>> exponents_v;
+  auto exponents =
+      get_level_data(exponents_v, exception_rows.size() + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  if (!exception_rows.empty()) {
+    exponents_scheme.decompressSelected(exponents, exception_rows.data(), exception_rows.size(),
+                                        nullptr, exponents_src, tuple_count, level + 1);
+  }
+  u32 patches_before = 0;
+  for (u32 i = 0; i < exception_rows.size() && exception_rows[i] < row; i++) {
+    patches_before += exponents[i] == exponent_exception_code;
+  }
+
+  INTEGER exponent;
+  if (!exception_rows.empty() && exception_rows.back() == row) {
+    exponent = exponents[exception_rows.size() - 1];
+  } else {
+    exponent = exponents_scheme.lookup(exponents_src, row, tuple_count, level + 1);
+  }
+  if (exponent == exponent_exception_code) {
+    DoubleScheme& patches_scheme =
+        DoubleSchemePicker::MyTypeWrapper::getScheme(col_struct.patches_scheme);
+    return patches_scheme.lookup(col_struct.data + col_struct.patches_offset, patches_before,
+                                 tuple_count - col_struct.converted_count, level + 1);
+  }
+  IntegerScheme& numbers_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.numbers_scheme);
+  auto number = numbers_scheme.lookup(col_struct.data, row - patches_before,
+                                      col_struct.converted_count, level + 1);
+  return static_cast<DOUBLE>(number) * exact_fractions_of_ten[exponent & decimal_index_mask];
+}
+
 string Decimal::fullDescription(const u8* src) {
   const auto& col_struct = *reinterpret_cast<const DecimalStructure*>(src);
   string result = this->selfDescription();
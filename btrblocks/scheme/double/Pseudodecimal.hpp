@@ -43,6 +43,7 @@ class Decimal : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
   bool isUsable(DoubleStats& stats) override;
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
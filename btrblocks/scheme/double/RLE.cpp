@@ -38,6 +38,35 @@ void RLE::decompress(DOUBLE* dest,
   return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
+void RLE::decompressSelected(DOUBLE* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  MyRLE::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+DOUBLE RLE::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyRLE::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::scan(const DoublePredicate& predicate,
+               BITMAP* result,
+               const u8* src,
+               u32 tuple_count,
+               u32 level) {
+  MyRLE::scanColumn(predicate, result, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<DOUBLE> RLE::aggregate(BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level) {
+  return MyRLE::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
 string RLE::fullDescription(const u8* src) {
   return MyRLE::fullDescription(src, this->selfDescription());
 }
@@ -18,6 +18,25 @@ class RLE : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressSelected(DOUBLE* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  // Same as integers::RLE::scan, the predicate is evaluated once per run
+  void scan(const DoublePredicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level);
+  // SUM/COUNT/MIN/MAX over the non-null rows, computed per run
+  TAggregate<DOUBLE> aggregate(BitmapWrapper* nullmap,
+                               const u8* src,
+                               u32 tuple_count,
+                               u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::RLE; }
@@ -30,5 +30,22 @@ void Uncompressed::decompress(DOUBLE* dest,
   std::memcpy(dest, src, tuple_count * sizeof(DOUBLE));
 }
 // -------------------------------------------------------------------------------------
+void Uncompressed::decompressSelected(DOUBLE* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  auto values = reinterpret_cast<const DOUBLE*>(src);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+DOUBLE Uncompressed::lookup(const u8* src, u32 row, u32, u32) {
+  return reinterpret_cast<const DOUBLE*>(src)[row];
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::doubles
 // -------------------------------------------------------------------------------------
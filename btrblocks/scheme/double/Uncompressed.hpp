@@ -18,6 +18,14 @@ class Uncompressed : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressSelected(DOUBLE* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::UNCOMPRESSED; }
 };
@@ -0,0 +1,24 @@
+// ------------------------------------------------------------------------------
+#include "Xor.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Xor.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+using MyXor = TXor<DOUBLE, u64>;
+// -------------------------------------------------------------------------------------
+u32 Xor::compress(const DOUBLE* src, const BITMAP*, u8* dest, DoubleStats& stats, u8) {
+  // ignore bitmap
+  return MyXor::compressColumn(src, stats.tuple_count, dest);
+}
+// -------------------------------------------------------------------------------------
+void Xor::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyXor::decompressColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+DOUBLE Xor::lookup(const u8* src, u32 row, u32, u32) {
+  return MyXor::lookupRow(src, row);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,28 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+// Chimp on the 64 bits of a double, see TXor: the XOR with the predecessor
+// is stored without its leading and trailing zeros.
+class Xor : public DoubleScheme {
+ public:
+  u32 compress(const DOUBLE* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               DoubleStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(DOUBLE* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  DOUBLE lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
+  inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::XOR; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,29 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+// Alp for floats, see TAlp. Decoding divides by the power of ten in single
+// precision and exponents stop at 10.
+class Alp : public FloatScheme {
+ public:
+  u32 compress(const FLOAT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               FloatStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(FLOAT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  FLOAT lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline FloatSchemeType schemeType() override { return staticSchemeType(); }
+  inline static FloatSchemeType staticSchemeType() { return FloatSchemeType::ALP; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+#include "DynamicDictionary.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/DynamicDictionary.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyDynamicDictionary = TDynamicDictionary<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double DynamicDictionary::expectedCompressionRatio(FloatStats& stats,
+                                                   u8 allowed_cascading_level) {
+  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::compress(const FLOAT* src,
+                                const BITMAP* nullmap,
+                                u8* dest,
+                                FloatStats& stats,
+                                u8 allowed_cascading_level) {
+  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompress(FLOAT* dest,
+                                   BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level) {
+  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<FLOAT> DynamicDictionary::aggregate(BitmapWrapper* nullmap,
+                                               const u8* src,
+                                               u32 tuple_count,
+                                               u32 level) {
+  return MyDynamicDictionary::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::decompressDictionary(vector<u8>& dictionary,
+                                            u32* codes,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+  return MyDynamicDictionary::decompressDictionaryColumn(dictionary, codes, src, tuple_count,
+                                                         level);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompressSelected(FLOAT* dest,
+                                           const u32* selection,
+                                           u32 count,
+                                           BitmapWrapper*,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  MyDynamicDictionary::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+FLOAT DynamicDictionary::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyDynamicDictionary::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string DynamicDictionary::fullDescription(const u8* src) {
+  return MyDynamicDictionary::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+#include "Frequency.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/Frequency.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyFrequency = TFrequency<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double Frequency::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  if (CD(stats.unique_count) * 100.0 / CD(stats.tuple_count) >
+      SchemeConfig::get().floats.frequency_threshold_pct) {
+    return 0;
+  }
+  return FloatScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Frequency::compress(const FLOAT* src,
+                        const BITMAP* nullmap,
+                        u8* dest,
+                        FloatStats& stats,
+                        u8 allowed_cascading_level) {
+  return MyFrequency::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Frequency::decompress(FLOAT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  return MyFrequency::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<FLOAT> Frequency::aggregate(BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level) {
+  return MyFrequency::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Frequency::fullDescription(const u8* src) {
+  return MyFrequency::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
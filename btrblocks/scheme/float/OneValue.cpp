@@ -0,0 +1,60 @@
+#include "OneValue.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+double OneValue::expectedCompressionRatio(FloatStats& stats, u8) {
+  if (stats.unique_count <= 1) {
+    return stats.tuple_count;
+  } else {
+    return 0;
+  }
+}
+// -------------------------------------------------------------------------------------
+u32 OneValue::compress(const FLOAT* src, const BITMAP*, u8* dest, FloatStats& stats, u8) {
+  auto& col_struct = *reinterpret_cast<OneValueStructure*>(dest);
+  if (src != nullptr) {
+    col_struct.one_value = stats.distinct_values.begin()->first;
+  } else {
+    col_struct.one_value = NULL_CODE;
+  }
+  return sizeof(OneValueStructure);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompress(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill(dest, dest + tuple_count, col_struct.one_value);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<FLOAT> OneValue::aggregate(BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32) {
+  // The value repeats for every non-null row
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  TAggregate<FLOAT> aggregate;
+  aggregate.add(col_struct.one_value, nullmap == nullptr ? tuple_count : nullmap->cardinality());
+  return aggregate;
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompressSelected(FLOAT* dest,
+                                  const u32*,
+                                  u32 count,
+                                  BitmapWrapper*,
+                                  const u8* src,
+                                  u32,
+                                  u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill(dest, dest + count, col_struct.one_value);
+}
+// -------------------------------------------------------------------------------------
+FLOAT OneValue::lookup(const u8* src, u32, u32, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  return col_struct.one_value;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
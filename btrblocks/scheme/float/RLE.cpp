@@ -0,0 +1,61 @@
+#include "RLE.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/RLE.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyRLE = TRLE<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double RLE::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  if (stats.average_run_length < SchemeConfig::get().floats.rle_run_length_threshold) {
+    return 0;
+  }
+  return FloatScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::compress(const FLOAT* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  FloatStats& stats,
+                  u8 allowed_cascading_level) {
+  return MyRLE::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompress(FLOAT* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompressSelected(FLOAT* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  MyRLE::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+FLOAT RLE::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyRLE::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<FLOAT> RLE::aggregate(BitmapWrapper* nullmap,
+                                 const u8* src,
+                                 u32 tuple_count,
+                                 u32 level) {
+  return MyRLE::aggregateColumn(nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string RLE::fullDescription(const u8* src) {
+  return MyRLE::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
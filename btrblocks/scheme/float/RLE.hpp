@@ -0,0 +1,38 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+class RLE : public FloatScheme {
+ public:
+  double expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const FLOAT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               FloatStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(FLOAT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  void decompressSelected(FLOAT* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  FLOAT lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  TAggregate<FLOAT> aggregate(BitmapWrapper* nullmap,
+                              const u8* src,
+                              u32 tuple_count,
+                              u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline FloatSchemeType schemeType() override { return staticSchemeType(); }
+  inline static FloatSchemeType staticSchemeType() { return FloatSchemeType::RLE; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+#include "Uncompressed.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+double Uncompressed::expectedCompressionRatio(FloatStats&, u8) {
+  return 1.0;
+}
+// -------------------------------------------------------------------------------------
+u32 Uncompressed::compress(const FLOAT* src, const BITMAP*, u8* dest, FloatStats& stats, u8) {
+  std::memcpy(dest, src, stats.total_size);
+  return stats.total_size;
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompress(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  std::memcpy(dest, src, tuple_count * sizeof(FLOAT));
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompressSelected(FLOAT* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32,
+                                      u32) {
+  auto values = reinterpret_cast<const FLOAT*>(src);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+FLOAT Uncompressed::lookup(const u8* src, u32 row, u32, u32) {
+  return reinterpret_cast<const FLOAT*>(src)[row];
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
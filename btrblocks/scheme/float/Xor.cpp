@@ -0,0 +1,24 @@
+// ------------------------------------------------------------------------------
+#include "Xor.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Xor.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyXor = TXor<FLOAT, u32>;
+// -------------------------------------------------------------------------------------
+u32 Xor::compress(const FLOAT* src, const BITMAP*, u8* dest, FloatStats& stats, u8) {
+  // ignore bitmap
+  return MyXor::compressColumn(src, stats.tuple_count, dest);
+}
+// -------------------------------------------------------------------------------------
+void Xor::decompress(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyXor::decompressColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+FLOAT Xor::lookup(const u8* src, u32 row, u32, u32) {
+  return MyXor::lookupRow(src, row);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+#include "Delta.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+inline INTEGER zigzagEncode(u32 delta) {
+  return static_cast<INTEGER>((delta << 1) ^ static_cast<u32>(static_cast<INTEGER>(delta) >> 31));
+}
+// -------------------------------------------------------------------------------------
+inline u32 zigzagDecode(u32 encoded) {
+  return (encoded >> 1) ^ (0u - (encoded & 1));
+}
+// -------------------------------------------------------------------------------------
+// values[i] = base + delta_0 + ... + delta_i in place, modulo 2^32
+template <bool ZigZag>
+void prefixSum(INTEGER* values, u32 count, INTEGER base) {
+  auto data = reinterpret_cast<u32*>(values);
+  u32 running = static_cast<u32>(base);
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  __m256i carry = _mm256_set1_epi32(base);
+  const __m256i last_lane = _mm256_set1_epi32(7);
+  const __m256i one = _mm256_set1_epi32(1);
+  for (; row_i + 8 <= count; row_i += 8) {
+    __m256i deltas = _mm256_loadu_si256(reinterpret_cast<__m256i*>(data + row_i));
+    if constexpr (ZigZag) {
+      __m256i sign = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(deltas, one));
+      deltas = _mm256_xor_si256(_mm256_srli_epi32(deltas, 1), sign);
+    }
+    // Prefix sums within both 128 bit lanes, then the low lane's total is
+    // added to the high lane and the total of the previous 8 to all
+    deltas = _mm256_add_epi32(deltas, _mm256_slli_si256(deltas, 4));
+    deltas = _mm256_add_epi32(deltas, _mm256_slli_si256(deltas, 8));
+    __m256i low_total = _mm256_shuffle_epi32(deltas, _MM_SHUFFLE(3, 3, 3, 3));
+    deltas = _mm256_add_epi32(deltas, _mm256_permute2x128_si256(low_total, low_total, 0x08));
+    deltas = _mm256_add_epi32(deltas, carry);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + row_i), deltas);
+    carry = _mm256_permutevar8x32_epi32(deltas, last_lane);
+  }
+  running = static_cast<u32>(_mm256_cvtsi256_si32(carry));
+#endif
+  for (; row_i < count; row_i++) {
+    running += ZigZag ? zigzagDecode(data[row_i]) : data[row_i];
+    data[row_i] = running;
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+template <bool OfDelta>
+u32 TDelta<OfDelta>::compress(const INTEGER* src,
+                              const BITMAP*,
+                              u8* dest,
+                              SInteger32Stats& stats,
+                              u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<DeltaStructure*>(dest);
+  const u32 tuple_count = stats.tuple_count;
+  auto deltas = ThreadCache::get().arena.allocate<INTEGER>(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  // -------------------------------------------------------------------------------------
+  // The first value and, for OfDelta, the first difference are kept in the
+  // header, their slots in the deltas are 0 so they do not widen the packing
+  col_struct.base = tuple_count > 0 ? src[0] : 0;
+  col_struct.first_delta = 0;
+  u32 previous = static_cast<u32>(col_struct.base);
+  u32 previous_delta = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    u32 delta = static_cast<u32>(src[row_i]) - previous;
+    previous = static_cast<u32>(src[row_i]);
+    if constexpr (OfDelta) {
+      if (row_i == 1) {
+        col_struct.first_delta = static_cast<INTEGER>(delta);
+        deltas[row_i] = 0;
+      } else {
+        deltas[row_i] = zigzagEncode(delta - previous_delta);
+      }
+      previous_delta = delta;
+    } else {
+      deltas[row_i] = zigzagEncode(delta);
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  u32 used_space;
+  IntegerSchemePicker::compress(deltas, nullptr, col_struct.data, tuple_count,
+                                allowed_cascading_level - 1, used_space, col_struct.deltas_scheme,
+                                autoScheme(), "deltas");
+  return sizeof(DeltaStructure) + used_space;
+}
+// -------------------------------------------------------------------------------------
+template <bool OfDelta>
+void TDelta<OfDelta>::decompress(INTEGER* dest,
+                                 BitmapWrapper*,
+                                 const u8* src,
+                                 u32 tuple_count,
+                                 u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  IntegerScheme& deltas_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme);
+  deltas_scheme.decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+  if constexpr (OfDelta) {
+    if (tuple_count > 1) {
+      dest[1] = zigzagEncode(static_cast<u32>(col_struct.first_delta));
+    }
+    // Differences of differences to differences, then to values
+    prefixSum<true>(dest, tuple_count, 0);
+    prefixSum<false>(dest, tuple_count, col_struct.base);
+  } else {
+    prefixSum<true>(dest, tuple_count, col_struct.base);
+  }
+}
+// -------------------------------------------------------------------------------------
+template <bool OfDelta>
+string TDelta<OfDelta>::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  IntegerScheme& deltas_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme);
+  return this->selfDescription() + "\n\t-> ([int] deltas) " +
+         deltas_scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+template <bool OfDelta>
+bool TDelta<OfDelta>::isUsable(SInteger32Stats& stats) {
+  // Constant columns are ONE_VALUE, without a difference there is nothing to gain
+  return stats.unique_count > 1 && stats.tuple_count > (OfDelta ? 2 : 1);
+}
+// -------------------------------------------------------------------------------------
+template class TDelta<false>;
+template class TDelta<true>;
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
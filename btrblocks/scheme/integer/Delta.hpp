@@ -0,0 +1,43 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+// Differences between neighbouring values, zig-zag encoded so that small
+// negative differences stay small, and cascaded to the other integer schemes.
+// Differences are taken modulo 2^32, so any input round trips, sorted or not.
+struct DeltaStructure {
+  INTEGER base;         // first value
+  INTEGER first_delta;  // second minus first value, only used by DELTA_OF_DELTA
+  u8 deltas_scheme;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+// OfDelta also takes the differences of the differences, which are zero for
+// values at regular intervals like timestamps
+template <bool OfDelta>
+class TDelta : public IntegerScheme {
+ public:
+  u32 compress(const INTEGER* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger32Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(INTEGER* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  bool isUsable(SInteger32Stats& stats) override;
+  inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
+  inline static IntegerSchemeType staticSchemeType() {
+    return OfDelta ? IntegerSchemeType::DELTA_OF_DELTA : IntegerSchemeType::DELTA;
+  }
+};
+using Delta = TDelta<false>;
+using DeltaOfDelta = TDelta<true>;
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
@@ -36,11 +36,42 @@ void DynamicDictionary::decompress(INTEGER* dest,
   return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
-INTEGER DynamicDictionary::lookup(u32) {
-  UNREACHABLE();
+TAggregate<INTEGER> DynamicDictionary::aggregate(BitmapWrapper* nullmap,
+                                                 const u8* src,
+                                                 u32 tuple_count,
+                                                 u32 level) {
+  return MyDynamicDictionary::aggregateColumn(nullmap, src, tuple_count, level);
 }
-void DynamicDictionary::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::decompressDictionary(vector<u8>& dictionary,
+                                            u32* codes,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+  return MyDynamicDictionary::decompressDictionaryColumn(dictionary, codes, src, tuple_count,
+                                                         level);
+}
+// -------------------------------------------------------------------------------------
+INTEGER DynamicDictionary::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyDynamicDictionary::lookupRow(src, row, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::scan(const Predicate& predicate,
+                            BITMAP* result,
+                            const u8* src,
+                            u32 tuple_count,
+                            u32 level) {
+  MyDynamicDictionary::scanColumn(predicate, result, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompressSelected(INTEGER* dest,
+                                           const u32* selection,
+                                           u32 count,
+                                           BitmapWrapper*,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  MyDynamicDictionary::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
 }
 string DynamicDictionary::fullDescription(const u8* src) {
   return MyDynamicDictionary::fullDescription(src, this->selfDescription());
@@ -63,13 +63,6 @@ void FOR::decompress(INTEGER* dest,
     dest[row_i] += col_struct.bias;
   }
 }
-// -------------------------------------------------------------------------------------
-INTEGER FOR::lookup(u32) {
-  UNREACHABLE();
-}
-void FOR::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
 
 std::string FOR::fullDescription(const u8* src) {
   const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
@@ -27,8 +27,6 @@ class FOR : public IntegerScheme {
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::FOR; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
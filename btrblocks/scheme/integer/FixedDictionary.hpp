@@ -30,8 +30,21 @@ class Dictionary16 : public IntegerScheme {
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::DICTIONARY_16; }
   // -------------------------------------------------------------------------------------
-  INTEGER lookup(u32) override { UNREACHABLE(); }
-  void scan(Predicate, BITMAP*, const u8*, u32) override { UNREACHABLE(); }
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32) override {
+    FDictScanColumn<u16, INTEGER>(predicate, result, src, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  u32 decompressDictionary(vector<u8>& dictionary,
+                           u32* codes,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32) override {
+    return FDictDecompressDictionary<u16, INTEGER>(dictionary, codes, src, tuple_count);
+  }
 };
 // -------------------------------------------------------------------------------------
 class Dictionary8 : public IntegerScheme {
@@ -58,8 +71,21 @@ class Dictionary8 : public IntegerScheme {
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::DICTIONARY_8; }
   // -------------------------------------------------------------------------------------
-  INTEGER lookup(u32) override { UNREACHABLE(); }
-  void scan(Predicate, BITMAP*, const u8*, u32) override { UNREACHABLE(); }
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32) override {
+    FDictScanColumn<u8, INTEGER>(predicate, result, src, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  u32 decompressDictionary(vector<u8>& dictionary,
+                           u32* codes,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32) override {
+    return FDictDecompressDictionary<u8, INTEGER>(dictionary, codes, src, tuple_count);
+  }
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
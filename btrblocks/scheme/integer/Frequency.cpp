@@ -40,11 +40,18 @@ void Frequency::decompress(INTEGER* dest,
   return MyFrequency::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
-INTEGER Frequency::lookup(u32) {
-  UNREACHABLE();
+TAggregate<INTEGER> Frequency::aggregate(BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level) {
+  return MyFrequency::aggregateColumn(nullmap, src, tuple_count, level);
 }
-void Frequency::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+void Frequency::scan(const Predicate& predicate,
+                    BITMAP* result,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level) {
+  MyFrequency::scanColumn(predicate, result, src, tuple_count, level);
 }
 
 std::string Frequency::fullDescription(const u8* src) {
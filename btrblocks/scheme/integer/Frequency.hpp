@@ -26,11 +26,18 @@ class Frequency : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  TAggregate<INTEGER> aggregate(BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::FREQUENCY; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::integers
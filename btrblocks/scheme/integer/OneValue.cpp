@@ -10,7 +10,7 @@
 namespace btrblocks::legacy::integers {
 // -------------------------------------------------------------------------------------
 double OneValue::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
-  if (stats.distinct_values.size() <= 1) {
+  if (stats.unique_count <= 1) {
     return stats.tuple_count;
   } else {
     return 0;
@@ -38,11 +38,41 @@ void OneValue::decompress(INTEGER* dest,
   }
 }
 // -------------------------------------------------------------------------------------
-INTEGER OneValue::lookup(u32) {
-  UNREACHABLE();
+TAggregate<INTEGER> OneValue::aggregate(BitmapWrapper* nullmap,
+                                        const u8* src,
+                                        u32 tuple_count,
+                                        u32) {
+  // The value repeats for every non-null row
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  TAggregate<INTEGER> aggregate;
+  aggregate.add(static_cast<INTEGER>(col_struct.one_value),
+                nullmap == nullptr ? tuple_count : nullmap->cardinality());
+  return aggregate;
 }
-void OneValue::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+// -------------------------------------------------------------------------------------
+INTEGER OneValue::lookup(const u8* src, u32, u32, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  return col_struct.one_value;
+}
+// -------------------------------------------------------------------------------------
+void OneValue::scan(const Predicate& predicate,
+                   BITMAP* result,
+                   const u8* src,
+                   u32 tuple_count,
+                   u32 level) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::memset(result, predicate.matches(col_struct.one_value), tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompressSelected(INTEGER* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper*,
+                                  const u8* src,
+                                  u32 tuple_count,
+                                  u32 level) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill(dest, dest + count, static_cast<INTEGER>(col_struct.one_value));
 }
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
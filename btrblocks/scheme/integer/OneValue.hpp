@@ -21,10 +21,25 @@ class OneValue : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  TAggregate<INTEGER> aggregate(BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::ONE_VALUE; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  INTEGER lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void decompressSelected(INTEGER* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
@@ -48,13 +48,6 @@ void PBP::decompress(INTEGER* dest, BitmapWrapper*, const u8* src, u32 tuple_cou
   assert(decompressed_codes_size == tuple_count);
 }
 // -------------------------------------------------------------------------------------
-void PBP::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
-INTEGER PBP::lookup(u32) {
-  UNREACHABLE();
-}
-// -------------------------------------------------------------------------------------
 // DELTA PBP
 // -------------------------------------------------------------------------------------
 double PBP_DELTA::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
@@ -108,13 +101,6 @@ void PBP_DELTA::decompress(INTEGER* dest,
   FPFor::revertDelta(reinterpret_cast<u32*>(dest), decompressed_codes_size);
 }
 // -------------------------------------------------------------------------------------
-void PBP_DELTA::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
-INTEGER PBP_DELTA::lookup(u32) {
-  UNREACHABLE();
-}
-// -------------------------------------------------------------------------------------
 double FBP::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
   if constexpr (auto_fpb) {
     return IntegerScheme::expectedCompressionRatio(stats, allowed_cascading_level);
@@ -156,11 +142,30 @@ void FBP::decompress(INTEGER* dest, BitmapWrapper*, const u8* src, u32 tuple_cou
   assert(decompressed_codes_size == tuple_count);
 }
 // -------------------------------------------------------------------------------------
-void FBP::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
-INTEGER FBP::lookup(u32) {
-  UNREACHABLE();
+INTEGER FBP::lookup(const u8* src, u32 row, u32, u32) {
+  auto& col_struct = *reinterpret_cast<const XPBPStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // Only the 32 values around row are unpacked
+  FBPImpl codec;
+  auto encoded_array = reinterpret_cast<const u32*>(col_struct.data + col_struct.padding);
+  u32 value;
+  codec.decompressSelected(encoded_array, col_struct.u32_count, &row, 1, &value);
+  return static_cast<INTEGER>(value);
+}
+// -------------------------------------------------------------------------------------
+void FBP::decompressSelected(INTEGER* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32,
+                             u32) {
+  auto& col_struct = *reinterpret_cast<const XPBPStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  FBPImpl codec;
+  auto encoded_array = reinterpret_cast<const u32*>(col_struct.data + col_struct.padding);
+  codec.decompressSelected(encoded_array, col_struct.u32_count, selection, count,
+                           reinterpret_cast<u32*>(dest));
 }
 // -------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------
@@ -182,13 +187,6 @@ void EXP_FBP::decompress(INTEGER* dest, BitmapWrapper*, const u8* src, u32 tuple
   UNREACHABLE();
 }
 // -------------------------------------------------------------------------------------
-void EXP_FBP::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
-INTEGER EXP_FBP::lookup(u32) {
-  UNREACHABLE();
-}
-// -------------------------------------------------------------------------------------
 u32 FBP64::compress(u64* src, u8* dest, u32 tuple_count) {
   auto& col_struct = *reinterpret_cast<XPBPStructure*>(dest);
   // -------------------------------------------------------------------------------------
@@ -25,8 +25,6 @@ class PBP : public IntegerScheme {
                   u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::PFOR; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
 class PBP_DELTA : public IntegerScheme {
@@ -44,8 +42,6 @@ class PBP_DELTA : public IntegerScheme {
                   u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::PFOR_DELTA; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
 class FBP : public IntegerScheme {
@@ -63,8 +59,14 @@ class FBP : public IntegerScheme {
                   u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::BP; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  INTEGER lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  void decompressSelected(INTEGER* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
 };
 // -------------------------------------------------------------------------------------
 class EXP_FBP : public IntegerScheme {
@@ -82,8 +84,6 @@ class EXP_FBP : public IntegerScheme {
                   u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::BP; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
 class FBP64 {
@@ -41,11 +41,33 @@ u32 RLE::decompressRuns(INTEGER* values,
   return MyRLE::decompressRuns(values, counts, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
-INTEGER RLE::lookup(u32) {
-  UNREACHABLE();
+INTEGER RLE::lookup(const u8* src, u32 row, u32 tuple_count, u32 level) {
+  return MyRLE::lookupRow(src, row, tuple_count, level);
 }
-void RLE::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+// -------------------------------------------------------------------------------------
+void RLE::scan(const Predicate& predicate,
+              BITMAP* result,
+              const u8* src,
+              u32 tuple_count,
+              u32 level) {
+  MyRLE::scanColumn(predicate, result, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompressSelected(INTEGER* dest,
+                             const u32* selection,
+                             u32 count,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  MyRLE::decompressSelectedColumn(dest, selection, count, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+TAggregate<INTEGER> RLE::aggregate(BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level) {
+  return MyRLE::aggregateColumn(nullmap, src, tuple_count, level);
 }
 
 std::string RLE::fullDescription(const u8* src) {
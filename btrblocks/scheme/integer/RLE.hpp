@@ -34,8 +34,24 @@ class RLE : public IntegerScheme {
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::RLE; }
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  INTEGER lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void decompressSelected(INTEGER* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
+  // SUM/COUNT/MIN/MAX over the non-null rows, computed per run
+  TAggregate<INTEGER> aggregate(BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) override;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::integers
@@ -28,12 +28,12 @@ void Truncation16::decompress(INTEGER* dest,
                               u32 level) {
   ITruncDecompress<u16>(dest, nullmap, src, tuple_count, level);
 }
-// -------------------------------------------------------------------------------------
-INTEGER Truncation16::lookup(u32) {
-  UNREACHABLE();
-}
-void Truncation16::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+void Truncation16::scan(const Predicate& predicate,
+                       BITMAP* result,
+                       const u8* src,
+                       u32 tuple_count,
+                       u32 level) {
+  ITruncScan<u16>(predicate, result, src, tuple_count);
 }
 // -------------------------------------------------------------------------------------
 // Truncation with 8 bits
@@ -58,11 +58,12 @@ void Truncation8::decompress(INTEGER* dest,
   ITruncDecompress<u8>(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
-void Truncation8::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
-}
-INTEGER Truncation8::lookup(u32) {
-  UNREACHABLE();
+void Truncation8::scan(const Predicate& predicate,
+                      BITMAP* result,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level) {
+  ITruncScan<u8>(predicate, result, src, tuple_count);
 }
 }  // namespace btrblocks::legacy::integers
 // -------------------------------------------------------------------------------------
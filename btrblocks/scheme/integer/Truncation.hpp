@@ -20,8 +20,11 @@ class Truncation16 : public IntegerScheme {
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::TRUNCATION_16; }
   // -------------------------------------------------------------------------------------
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   virtual bool canCompress(SInteger32Stats& stats) {
     return stats.max - stats.min <= std::numeric_limits<u16>::max();
   }
@@ -43,8 +46,11 @@ class Truncation8 : public IntegerScheme {
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::TRUNCATION_8; }
   // -------------------------------------------------------------------------------------
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   virtual bool canCompress(SInteger32Stats& stats) {
     return stats.max - stats.min <= std::numeric_limits<u8>::max();
   }
@@ -114,4 +120,12 @@ void ITruncDecompress(INTEGER* dest,
   //   }
 }
 // -------------------------------------------------------------------------------------
+template <typename CodeType>
+void ITruncScan(const Predicate& predicate, BITMAP* result, const u8* src, u32 tuple_count) {
+  const auto& col_struct = *reinterpret_cast<const TruncationStructure<CodeType>*>(src);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    result[row_i] = predicate.matches(col_struct.base + col_struct.truncated_values[row_i]);
+  }
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
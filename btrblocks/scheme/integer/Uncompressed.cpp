@@ -32,11 +32,29 @@ void Uncompressed::decompress(INTEGER* dest,
   std::memcpy(dest, src, column_size);
 }
 // -------------------------------------------------------------------------------------
-INTEGER Uncompressed::lookup(u32) {
-  UNREACHABLE();
+INTEGER Uncompressed::lookup(const u8* src, u32 row, u32, u32) {
+  return reinterpret_cast<const INTEGER*>(src)[row];
 }
-void Uncompressed::scan(Predicate, BITMAP*, const u8*, u32) {
-  UNREACHABLE();
+// -------------------------------------------------------------------------------------
+void Uncompressed::scan(const Predicate& predicate,
+                       BITMAP* result,
+                       const u8* src,
+                       u32 tuple_count,
+                       u32 level) {
+  predicate.evaluate(reinterpret_cast<const INTEGER*>(src), tuple_count, result);
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompressSelected(INTEGER* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  auto values = reinterpret_cast<const INTEGER*>(src);
+  for (u32 i = 0; i < count; i++) {
+    dest[i] = values[selection[i]];
+  }
 }
 }  // namespace btrblocks::legacy::integers
 // -------------------------------------------------------------------------------------
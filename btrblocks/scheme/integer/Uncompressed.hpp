@@ -20,8 +20,19 @@ class Uncompressed : public IntegerScheme {
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::UNCOMPRESSED; }
   // -------------------------------------------------------------------------------------
-  INTEGER lookup(u32) override;
-  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  INTEGER lookup(const u8* src, u32 row, u32 tuple_count, u32 level) override;
+  void scan(const Predicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void decompressSelected(INTEGER* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::integers
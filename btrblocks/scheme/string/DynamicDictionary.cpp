@@ -1,4 +1,5 @@
 #include "DynamicDictionary.hpp"
+#include "FsstMatcher.hpp"
 #include "common/Units.hpp"
 #include "compression/SchemePicker.hpp"
 #include "scheme/integer/PBP.hpp"
@@ -21,11 +22,11 @@ namespace btrblocks::strings {
 // -------------------------------------------------------------------------------------
 double DynamicDictionary::expectedCompressionRatio(StringStats& stats, u8) {
   auto& cfg = SchemeConfig::get().strings;
-  u32 bits_per_code = std::floor(std::log2(stats.distinct_values.size())) + 1;
+  u32 bits_per_code = std::floor(std::log2(stats.unique_count)) + 1;
   u32 after_size = sizeof(DynamicDictionaryStructure);
   after_size += FSST_MAXHEADER;
   after_size += stats.tuple_count * (CD(bits_per_code) / 8.0);
-  after_size += sizeof(StringArrayViewer::Slot) * (1 + stats.distinct_values.size());
+  after_size += sizeof(StringArrayViewer::Slot) * (1 + stats.unique_count);
   if (stats.total_unique_length >= cfg.dict_fsst_input_size_threshold) {  // Threshold
     after_size += 0.5 * static_cast<double>(stats.total_unique_length);   // 0.5 for fsst
   } else {
@@ -39,7 +40,7 @@ bool DynamicDictionary::usesFsst(const u8* src) {
   return col_struct.use_fsst;
 }
 // -------------------------------------------------------------------------------------
-u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
+u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer,
                                 const BITMAP*,
                                 u8* dest,
                                 btrblocks::StringStats& stats) {
@@ -47,6 +48,7 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
   // BEGINNING@ | Compressed(Codes) OR :    DICT | OFFSETS | Compressed(Codes)
   // -------------------------------------------------------------------------------------
   auto& cfg = SchemeConfig::get().strings;
+  stats.makeExact();
   // -------------------------------------------------------------------------------------
   die_if(stats.unique_count <= std::numeric_limits<u32>::max());
   // -------------------------------------------------------------------------------------
@@ -59,7 +61,7 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
   auto write_ptr = col_struct.data;
   // IDEA: sort distinct_values ascending by number of occurences to reduce the
   // numbers of bits required for codes
-  vector<str> distinct_values(stats.distinct_values.begin(), stats.distinct_values.end());
+  const auto& distinct_values = stats.distinct_values.sorted();
   // -------------------------------------------------------------------------------------
   // FSST Compression
   // -------------------------------------------------------------------------------------
@@ -166,14 +168,15 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
   // -------------------------------------------------------------------------------------
   // Codes
   {
+    // The stats already know the string of every row, only the order changes
+    const auto& positions = stats.distinct_values.sortedPositions();
+    const auto& row_ids = stats.distinct_values.rowIds();
     s32 run_count = 0;
     s32 current_code = -1;
     vector<INTEGER> codes;
+    codes.reserve(stats.tuple_count);
     for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
-      const str& current_value = src(row_i);
-      auto it = std::lower_bound(distinct_values.begin(), distinct_values.end(), current_value);
-      assert(it != distinct_values.end());
-      auto new_code = static_cast<INTEGER>(std::distance(distinct_values.begin(), it));
+      auto new_code = static_cast<INTEGER>(positions[row_ids[row_i]]);
       codes.push_back(new_code);
       if (new_code != current_code) {
         run_count++;
@@ -575,6 +578,276 @@ bool DynamicDictionary::decompressNoCopy(u8* dest,
   return true;
 }
 
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::scan(const StringPredicate& predicate,
+                             BITMAP* result,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  const u32 dict_size = col_struct.num_codes;
+  // -------------------------------------------------------------------------------------
+  // Dictionary entries are only materialized when the search below looks at
+  // them. FSST entries are decoded one at a time into a scratch buffer.
+  fsst_decoder_t decoder;
+  const u32* fsst_offsets = nullptr;
+  const u8* fsst_compressed_buf = nullptr;
+  thread_local std::vector<std::vector<u8>> entry_v;
+  u8* entry_buffer = nullptr;
+  if (col_struct.use_fsst) {
+    die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+    fsst_offsets = reinterpret_cast<const u32*>(col_struct.data + col_struct.fsst_offsets_offset);
+    fsst_compressed_buf = col_struct.data + FSST_MAXHEADER;
+    entry_buffer = get_level_data(entry_v, MAX_STR_LENGTH + SIMD_EXTRA_BYTES, level);
+  }
+  StringArrayViewer dict_array(col_struct.data);
+  auto entry = [&](u32 code) -> str {
+    if (!col_struct.use_fsst) {
+      return dict_array(code);
+    }
+    auto compressed_str_length = fsst_offsets[code + 1] - fsst_offsets[code];
+    auto compressed_str_ptr = fsst_compressed_buf + fsst_offsets[code];
+    auto length = fsst_decompress(&decoder, compressed_str_length,
+                                  const_cast<u8*>(compressed_str_ptr), MAX_STR_LENGTH, entry_buffer);
+    return str(reinterpret_cast<const char*>(entry_buffer), length);
+  };
+  // The dictionary is sorted, so binary searches find the qualifying codes
+  // while decoding only O(log n) entries.
+  auto lower_bound = [&](str value) {
+    u32 begin = 0, end = dict_size;
+    while (begin < end) {
+      u32 middle = begin + (end - begin) / 2;
+      if (entry(middle) < value) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    return begin;
+  };
+  auto upper_bound = [&](str value) {
+    u32 begin = 0, end = dict_size;
+    while (begin < end) {
+      u32 middle = begin + (end - begin) / 2;
+      if (value < entry(middle)) {
+        end = middle;
+      } else {
+        begin = middle + 1;
+      }
+    }
+    return begin;
+  };
+  // -------------------------------------------------------------------------------------
+  CodeSelection selection;
+  switch (predicate.type) {
+    case PredicateType::EQUAL:
+      selection = CodeSelection::range(dict_size, lower_bound(predicate.lower),
+                                       upper_bound(predicate.lower));
+      break;
+    case PredicateType::NOT_EQUAL: {
+      u32 begin = lower_bound(predicate.lower);
+      u32 end = upper_bound(predicate.lower);
+      selection =
+          CodeSelection::build(dict_size, [&](u32 code) { return code < begin || code >= end; });
+      break;
+    }
+    case PredicateType::LESS:
+      selection = CodeSelection::range(dict_size, 0, lower_bound(predicate.lower));
+      break;
+    case PredicateType::LESS_EQUAL:
+      selection = CodeSelection::range(dict_size, 0, upper_bound(predicate.lower));
+      break;
+    case PredicateType::GREATER:
+      selection = CodeSelection::range(dict_size, upper_bound(predicate.lower), dict_size);
+      break;
+    case PredicateType::GREATER_EQUAL:
+      selection = CodeSelection::range(dict_size, lower_bound(predicate.lower), dict_size);
+      break;
+    case PredicateType::BETWEEN:
+      selection = CodeSelection::range(dict_size, lower_bound(predicate.lower),
+                                       upper_bound(predicate.upper));
+      break;
+    case PredicateType::IN: {
+      vector<BITMAP> in_list(dict_size, 0);
+      for (const auto& value : predicate.values) {
+        u32 code = lower_bound(value);
+        if (code < dict_size && entry(code) == value) {
+          in_list[code] = 1;
+        }
+      }
+      selection = CodeSelection::build(dict_size, [&](u32 code) { return in_list[code]; });
+      break;
+    }
+    case PredicateType::IS_NULL:
+    case PredicateType::IS_NOT_NULL:
+      selection = CodeSelection::build(dict_size, [&](u32) { return predicate.matches(str()); });
+      break;
+    case PredicateType::PREFIX: {
+      // The entries with the prefix directly follow the ones that are smaller
+      u32 begin = lower_bound(predicate.lower), end = dict_size;
+      for (u32 low = begin; low < end;) {
+        u32 middle = low + (end - low) / 2;
+        if (predicate.matches(entry(middle))) {
+          low = middle + 1;
+        } else {
+          end = middle;
+        }
+      }
+      selection = CodeSelection::range(dict_size, begin, end);
+      break;
+    }
+    case PredicateType::LIKE: {
+      // Every entry has to be looked at, FSST entries are matched without
+      // decoding them
+      if (col_struct.use_fsst) {
+        FsstMatcher matcher(decoder, predicate);
+        if (matcher.valid()) {
+          selection = CodeSelection::build(dict_size, [&](u32 code) {
+            return matcher.matches(fsst_compressed_buf + fsst_offsets[code],
+                                   fsst_offsets[code + 1] - fsst_offsets[code]);
+          });
+          break;
+        }
+      }
+      selection =
+          CodeSelection::build(dict_size, [&](u32 code) { return predicate.matches(entry(code)); });
+      break;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Filter the codes
+  if (selection.none() || selection.all()) {
+    std::memset(result, selection.all(), tuple_count);
+    return;
+  }
+  const u8* compressed_codes_ptr = col_struct.data + col_struct.codes_offset;
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  if (selection.isRange()) {
+    codes_scheme.scan(selection.rangePredicate(), result, compressed_codes_ptr, tuple_count,
+                      level + 1);
+  } else if (col_struct.use_rle_optimized_path) {
+    auto& rle = dynamic_cast<btrblocks::integers::RLE&>(codes_scheme);
+
+    thread_local std::vector<std::vector<INTEGER>> values_v;
+    auto values_ptr = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts_ptr = get_level_data(counts_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+
+    u32 runs_count = rle.decompressRuns(values_ptr, counts_ptr, nullptr, compressed_codes_ptr,
+                                        tuple_count, level + 1);
+    for (u32 run = 0; run < runs_count; run++) {
+      std::memset(result, selection.matches[values_ptr[run]], counts_ptr[run]);
+      result += counts_ptr[run];
+    }
+  } else {
+    thread_local std::vector<std::vector<INTEGER>> decompressed_codes_v;
+    auto decompressed_codes =
+        get_level_data(decompressed_codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    codes_scheme.decompress(decompressed_codes, nullptr, compressed_codes_ptr, tuple_count,
+                            level + 1);
+    selection.apply(decompressed_codes, tuple_count, result);
+  }
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompressSelected(u8* dest,
+                                           const u32* selection,
+                                           u32 count,
+                                           BitmapWrapper*,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // Only the selected codes are decoded, RLE codes are not expanded
+  thread_local std::vector<std::vector<INTEGER>> codes_v;
+  auto codes = get_level_data(codes_v, count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  codes_scheme.decompressSelected(codes, selection, count, nullptr,
+                                  col_struct.data + col_struct.codes_offset, tuple_count,
+                                  level + 1);
+  // -------------------------------------------------------------------------------------
+  auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+  auto dest_write_ptr = dest + sizeof(StringArrayViewer::Slot) * (count + 1);
+  if (col_struct.use_fsst) {
+    fsst_decoder_t decoder;
+    die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+    auto fsst_offsets =
+        reinterpret_cast<const u32*>(col_struct.data + col_struct.fsst_offsets_offset);
+    auto fsst_compressed_buf = col_struct.data + FSST_MAXHEADER;
+    for (u32 i = 0; i < count; i++) {
+      dest_slots[i].offset = dest_write_ptr - dest;
+      auto code = codes[i];
+      auto compressed_str_length = fsst_offsets[code + 1] - fsst_offsets[code];
+      auto compressed_str_ptr = fsst_compressed_buf + fsst_offsets[code];
+      dest_write_ptr +=
+          fsst_decompress(&decoder, compressed_str_length, const_cast<u8*>(compressed_str_ptr),
+                          MAX_STR_LENGTH, dest_write_ptr);
+    }
+  } else {
+    StringArrayViewer dict_array(col_struct.data);
+    for (u32 i = 0; i < count; i++) {
+      dest_slots[i].offset = dest_write_ptr - dest;
+      u32 length = dict_array.size(codes[i]);
+      std::memcpy(dest_write_ptr, dict_array.get_pointer(codes[i]), length);
+      dest_write_ptr += length;
+    }
+  }
+  dest_slots[count].offset = dest_write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::decompressDictionary(vector<u8>& dictionary,
+                                            u32* codes,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  const u32 slots_size = (col_struct.num_codes + 1) * sizeof(StringArrayViewer::Slot);
+  if (col_struct.use_fsst) {
+    thread_local std::vector<std::vector<INTEGER>> lengths_v;
+    auto lengths =
+        get_level_data(lengths_v, col_struct.num_codes + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& lengths_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.lengths_scheme);
+    lengths_scheme.decompress(lengths, nullptr, col_struct.data + col_struct.lengths_offset,
+                              col_struct.num_codes, level + 1);
+    u32 total_length = 0;
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      total_length += lengths[c];
+    }
+    // -------------------------------------------------------------------------------------
+    auto dest = get_data(dictionary, slots_size + total_length + SIMD_EXTRA_BYTES);
+    auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+    u32 current_offset = slots_size;
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      dest_slots[c].offset = current_offset;
+      current_offset += lengths[c];
+    }
+    dest_slots[col_struct.num_codes].offset = current_offset;
+    // -------------------------------------------------------------------------------------
+    // All entries in one go, they are stored back to back
+    fsst_decoder_t decoder;
+    die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+    u32 total_compressed_length = col_struct.fsst_offsets_offset - FSST_MAXHEADER;
+    fsst_decompress(&decoder, total_compressed_length,
+                    const_cast<u8*>(col_struct.data + FSST_MAXHEADER),
+                    total_length + SIMD_EXTRA_BYTES, dest + slots_size);
+  } else {
+    // The dictionary is stored in the StringArrayViewer layout already
+    auto dict_slots = reinterpret_cast<const StringArrayViewer::Slot*>(col_struct.data);
+    u32 dict_size = dict_slots[col_struct.num_codes].offset;
+    std::memcpy(get_data(dictionary, dict_size + SIMD_EXTRA_BYTES), col_struct.data, dict_size);
+  }
+  // -------------------------------------------------------------------------------------
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  codes_scheme.decompress(reinterpret_cast<INTEGER*>(codes), nullptr,
+                          col_struct.data + col_struct.codes_offset, tuple_count, level + 1);
+  return col_struct.num_codes;
+}
+// -------------------------------------------------------------------------------------
 std::string DynamicDictionary::fullDescription(const u8* src) {
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
   IntegerScheme& codes_scheme =
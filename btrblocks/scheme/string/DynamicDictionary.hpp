@@ -37,6 +37,23 @@ class DynamicDictionary : public StringScheme {
                         const u8* src,
                         u32 tuple_count,
                         u32 level) override;
+  void scan(const StringPredicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  u32 decompressDictionary(vector<u8>& dictionary,
+                           u32* codes,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) override;
+  void decompressSelected(u8* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
   inline StringSchemeType schemeType() override { return staticSchemeType(); }
   inline static StringSchemeType staticSchemeType() { return StringSchemeType::DICT; }
 };
@@ -1,6 +1,7 @@
 #include "btrblocks.hpp"
 // ------------------------------------------------------------------------------
 #include "Fsst.hpp"
+#include "FsstMatcher.hpp"
 // ------------------------------------------------------------------------------
 #include "common/Log.hpp"
 #include "compression/SchemePicker.hpp"
@@ -108,6 +109,38 @@ void Fsst::decompress(u8* dest, BitmapWrapper*, const u8* src, u32 tuple_count,
   die_if(dest_write_ptr - dest == col_struct.total_decompressed_size)
 }
 
+void Fsst::scan(const StringPredicate& predicate,
+                BITMAP* result,
+                const u8* src,
+                u32 tuple_count,
+                u32 level) {
+  auto& col_struct = *reinterpret_cast<const FsstStructure*>(src);
+  if (!FsstMatcher::isSupported(predicate)) {
+    StringScheme::scan(predicate, result, src, tuple_count, level);
+    return;
+  }
+  fsst_decoder_t decoder;
+  die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+  FsstMatcher matcher(decoder, predicate);
+  if (!matcher.valid()) {
+    StringScheme::scan(predicate, result, src, tuple_count, level);
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  // The compressed strings are stored back to back, their boundaries follow
+  // from the decompressed lengths
+  thread_local std::vector<std::vector<INTEGER>> offsets_v;
+  auto offsets = get_level_data(offsets_v, tuple_count + 1 + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerScheme& offsets_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.offsets_scheme);
+  offsets_scheme.decompress(offsets, nullptr, col_struct.data + col_struct.offsets_offset,
+                            tuple_count + 1, level + 1);
+  const u8* codes = col_struct.data + col_struct.strings_offset;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    codes = matcher.matchNext(codes, offsets[row_i + 1] - offsets[row_i], result[row_i]);
+  }
+}
+
 std::string Fsst::fullDescription(const u8* src) {
   auto& col_struct = *reinterpret_cast<const FsstStructure*>(src);
   IntegerScheme& offsets_scheme =
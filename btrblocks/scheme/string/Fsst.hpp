@@ -28,6 +28,11 @@ class Fsst : public StringScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void scan(const StringPredicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   bool isUsable(StringStats& stats) override;
   std::string fullDescription(const u8* src) override;
   inline StringSchemeType schemeType() override { return staticSchemeType(); }
@@ -0,0 +1,182 @@
+#include "FsstMatcher.hpp"
+#include "common/Exceptions.hpp"
+// -------------------------------------------------------------------------------------
+#include <map>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+namespace {
+// Pattern elements besides literal bytes
+constexpr s32 ANY_BYTE = -1;
+constexpr s32 ANY_SEQUENCE = -2;
+}  // namespace
+// -------------------------------------------------------------------------------------
+bool FsstMatcher::isSupported(const StringPredicate& predicate) {
+  return predicate.type == PredicateType::EQUAL || predicate.type == PredicateType::PREFIX ||
+         predicate.type == PredicateType::LIKE;
+}
+// -------------------------------------------------------------------------------------
+FsstMatcher::FsstMatcher(const fsst_decoder_t& decoder, const StringPredicate& predicate) {
+  die_if(isSupported(predicate));
+  vector<s32> pattern;
+  for (const char c : predicate.lower) {
+    const auto byte = static_cast<s32>(static_cast<u8>(c));
+    if (predicate.type != PredicateType::LIKE) {
+      pattern.push_back(byte);
+    } else if (c == '_') {
+      pattern.push_back(ANY_BYTE);
+    } else if (c != '%') {
+      pattern.push_back(byte);
+    } else if (pattern.empty() || pattern.back() != ANY_SEQUENCE) {
+      pattern.push_back(ANY_SEQUENCE);
+    }
+  }
+  if (predicate.type == PredicateType::PREFIX) {
+    pattern.push_back(ANY_SEQUENCE);
+  }
+  compile(pattern, decoder);
+}
+// -------------------------------------------------------------------------------------
+void FsstMatcher::compile(const vector<s32>& pattern, const fsst_decoder_t& decoder) {
+  // Subset construction: a DFA state is the set of pattern positions the
+  // bytes read so far can end at, position m means the whole pattern matched
+  const u32 m = pattern.size();
+  using PositionSet = vector<bool>;
+  auto closure = [&](PositionSet& positions) {
+    for (u32 p = 0; p < m; p++) {
+      if (positions[p] && pattern[p] == ANY_SEQUENCE) {
+        positions[p + 1] = true;
+      }
+    }
+  };
+  std::map<PositionSet, State> state_ids;
+  vector<PositionSet> states;
+  auto getState = [&](PositionSet&& positions) -> s32 {
+    auto it = state_ids.find(positions);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    if (states.size() == MAX_STATES) {
+      return -1;
+    }
+    auto id = static_cast<State>(states.size());
+    state_ids.emplace(positions, id);
+    states.push_back(std::move(positions));
+    return id;
+  };
+  // -------------------------------------------------------------------------------------
+  PositionSet initial(m + 1, false);
+  initial[0] = true;
+  closure(initial);
+  start = getState(std::move(initial));
+  for (u32 state = 0; state < states.size(); state++) {
+    for (u32 byte = 0; byte < 256; byte++) {
+      PositionSet next(m + 1, false);
+      for (u32 p = 0; p < m; p++) {
+        if (!states[state][p]) {
+          continue;
+        }
+        if (pattern[p] == ANY_SEQUENCE) {
+          next[p] = true;
+        } else if (pattern[p] == ANY_BYTE || pattern[p] == static_cast<s32>(byte)) {
+          next[p + 1] = true;
+        }
+      }
+      closure(next);
+      s32 next_state = getState(std::move(next));
+      if (next_state < 0) {
+        byte_transitions.clear();
+        return;
+      }
+      byte_transitions.push_back(next_state);
+    }
+  }
+  const u32 state_count = states.size();
+  accepting.resize(state_count);
+  for (u32 state = 0; state < state_count; state++) {
+    accepting[state] = states[state][m];
+  }
+  // -------------------------------------------------------------------------------------
+  // States from which the result cannot change anymore
+  vector<bool> may_accept(accepting.begin(), accepting.end());
+  vector<bool> must_accept(accepting.begin(), accepting.end());
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (u32 state = 0; state < state_count; state++) {
+      for (u32 byte = 0; byte < 256; byte++) {
+        const State next = byte_transitions[state * 256 + byte];
+        if (!may_accept[state] && may_accept[next]) {
+          may_accept[state] = changed = true;
+        }
+        if (must_accept[state] && !must_accept[next]) {
+          must_accept[state] = false;
+          changed = true;
+        }
+      }
+    }
+  }
+  kinds.resize(state_count);
+  for (u32 state = 0; state < state_count; state++) {
+    kinds[state] = !may_accept[state]  ? StateKind::REJECT
+                   : must_accept[state] ? StateKind::ACCEPT
+                                        : StateKind::OPEN;
+  }
+  // -------------------------------------------------------------------------------------
+  // Lift the byte transitions to whole symbols
+  symbol_transitions.resize(state_count * 256);
+  for (u32 code = 0; code < 256; code++) {
+    symbol_lengths[code] = code == FSST_ESC ? 0 : std::min<u32>(decoder.len[code], 8);
+  }
+  for (u32 state = 0; state < state_count; state++) {
+    for (u32 code = 0; code < 256; code++) {
+      State current = state;
+      for (u32 i = 0; i < symbol_lengths[code]; i++) {
+        const u8 byte = (decoder.symbol[code] >> (8 * i)) & 0xFF;
+        current = byte_transitions[current * 256 + byte];
+      }
+      symbol_transitions[state * 256 + code] = current;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+bool FsstMatcher::matches(const u8* codes, u32 length) const {
+  State state = start;
+  for (u32 i = 0; i < length && kinds[state] == StateKind::OPEN; i++) {
+    if (codes[i] == FSST_ESC) {
+      state = byte_transitions[state * 256 + codes[++i]];
+    } else {
+      state = symbol_transitions[state * 256 + codes[i]];
+    }
+  }
+  return accepting[state];
+}
+// -------------------------------------------------------------------------------------
+const u8* FsstMatcher::matchNext(const u8* codes, u32 decompressed_length, BITMAP& result) const {
+  State state = start;
+  u32 decoded = 0;
+  while (decoded < decompressed_length && kinds[state] == StateKind::OPEN) {
+    const u8 code = *codes++;
+    if (code == FSST_ESC) {
+      state = byte_transitions[state * 256 + *codes++];
+      decoded++;
+    } else {
+      state = symbol_transitions[state * 256 + code];
+      decoded += symbol_lengths[code];
+    }
+  }
+  // The rest of the string is only skipped
+  while (decoded < decompressed_length) {
+    const u8 code = *codes++;
+    if (code == FSST_ESC) {
+      codes++;
+      decoded++;
+    } else {
+      decoded += symbol_lengths[code];
+    }
+  }
+  result = accepting[state];
+  return codes;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
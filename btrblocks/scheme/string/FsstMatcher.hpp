@@ -0,0 +1,48 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/Predicate.hpp"
+// -------------------------------------------------------------------------------------
+#include <fsst.h>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+// Evaluates EQUAL, PREFIX and LIKE directly on FSST compressed strings. The
+// pattern is compiled into a DFA over bytes, which is then lifted to the
+// symbol table of the decoder: one transition per (state, code) consumes a
+// whole symbol. A string is decided as soon as the DFA reaches a state from
+// which either no or every continuation matches, so strings that fail within
+// their first symbols are never decoded.
+class FsstMatcher {
+ public:
+  FsstMatcher(const fsst_decoder_t& decoder, const StringPredicate& predicate);
+  // -------------------------------------------------------------------------------------
+  static bool isSupported(const StringPredicate& predicate);
+  // Patterns whose DFA would grow too large are not compiled, the caller has
+  // to decompress and use StringPredicate::matches instead.
+  [[nodiscard]] inline bool valid() const { return !accepting.empty(); }
+  // -------------------------------------------------------------------------------------
+  // codes[0, length) is a single compressed string
+  [[nodiscard]] bool matches(const u8* codes, u32 length) const;
+  // codes points into compressed strings that are stored back to back without
+  // offsets, decompressed_length is the length of the next string. Returns
+  // the codes behind that string.
+  const u8* matchNext(const u8* codes, u32 decompressed_length, BITMAP& result) const;
+
+ private:
+  using State = u16;
+  static constexpr u32 MAX_STATES = 256;
+  enum class StateKind : u8 { OPEN, REJECT, ACCEPT };
+  // -------------------------------------------------------------------------------------
+  vector<State> byte_transitions;    // [state * 256 + byte], for escaped bytes
+  vector<State> symbol_transitions;  // [state * 256 + code]
+  vector<BITMAP> accepting;
+  vector<StateKind> kinds;
+  u8 symbol_lengths[256];
+  State start = 0;
+  // -------------------------------------------------------------------------------------
+  void compile(const vector<s32>& pattern, const fsst_decoder_t& decoder);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
@@ -12,7 +12,7 @@
 namespace btrblocks::legacy::strings {
 // -------------------------------------------------------------------------------------
 double OneValue::expectedCompressionRatio(StringStats& stats, u8 allowed_cascading_level) {
-  if (stats.distinct_values.size() <= 1) {
+  if (stats.unique_count <= 1) {
     return stats.tuple_count;
   } else {
     return 0;
@@ -24,6 +24,7 @@ u32 OneValue::compress(const StringArrayViewer,
                        u8* dest,
                        StringStats& stats) {
   auto& col_struct = *reinterpret_cast<OneValueStructure*>(dest);
+  stats.makeExact();
   const auto one_value = *stats.distinct_values.begin();
   col_struct.length = one_value.length();
   std::memcpy(col_struct.data, one_value.data(), col_struct.length);
@@ -188,5 +189,38 @@ u32 OneValue::getTotalLength(const u8* src, u32, BitmapWrapper* nullmap) {
   return nullmap->cardinality() * col_struct.length;
 }
 // -------------------------------------------------------------------------------------
+void OneValue::scan(const StringPredicate& predicate,
+                    BITMAP* result,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32) {
+  auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  const str one_value(reinterpret_cast<const char*>(col_struct.data), col_struct.length);
+  std::memset(result, predicate.matches(one_value), tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompressSelected(u8* dest,
+                                  const u32* selection,
+                                  u32 count,
+                                  BitmapWrapper* nullmap,
+                                  const u8* src,
+                                  u32,
+                                  u32) {
+  auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+  u32 write_offset = (count + 1) * sizeof(StringArrayViewer::Slot);
+  // Same as decompress: null rows are empty strings, they take no space in
+  // getTotalLength
+  const bool all_set = nullmap == nullptr || nullmap->type() == BitmapType::ALLONES;
+  for (u32 i = 0; i < count; i++) {
+    dest_slots[i].offset = write_offset;
+    if (all_set || nullmap->test(selection[i])) {
+      std::memcpy(dest + write_offset, col_struct.data, col_struct.length);
+      write_offset += col_struct.length;
+    }
+  }
+  dest_slots[count].offset = write_offset;
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::strings
 // -------------------------------------------------------------------------------------
@@ -29,6 +29,18 @@ class OneValue : public StringScheme {
                         const u8* src,
                         u32 tuple_count,
                         u32 level) override;
+  void scan(const StringPredicate& predicate,
+            BITMAP* result,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void decompressSelected(u8* dest,
+                          const u32* selection,
+                          u32 count,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) override;
   inline StringSchemeType schemeType() override { return staticSchemeType(); }
   inline static StringSchemeType staticSchemeType() { return StringSchemeType::ONE_VALUE; }
 };
@@ -44,5 +44,37 @@ u32 Uncompressed::getTotalLength(const u8* src, u32 tuple_count, BitmapWrapper*
   return col_struct.total_size - ((tuple_count + 1) * sizeof(StringArrayViewer::Slot));
 }
 // -------------------------------------------------------------------------------------
+void Uncompressed::scan(const StringPredicate& predicate,
+                        BITMAP* result,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32) {
+  auto& col_struct = *reinterpret_cast<const UncompressedStructure*>(src);
+  StringArrayViewer viewer(col_struct.data);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    result[row_i] = predicate.matches(viewer(row_i));
+  }
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompressSelected(u8* dest,
+                                      const u32* selection,
+                                      u32 count,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32,
+                                      u32) {
+  auto& col_struct = *reinterpret_cast<const UncompressedStructure*>(src);
+  StringArrayViewer viewer(col_struct.data);
+  auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+  u32 write_offset = (count + 1) * sizeof(StringArrayViewer::Slot);
+  for (u32 i = 0; i < count; i++) {
+    const str value = viewer(selection[i]);
+    dest_slots[i].offset = write_offset;
+    std::memcpy(dest + write_offset, value.data(), value.length());
+    write_offset += value.length();
+  }
+  dest_slots[count].offset = write_offset;
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::legacy::strings
 // -------------------------------------------------------------------------------------
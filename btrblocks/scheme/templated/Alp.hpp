@@ -0,0 +1,554 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Adaptive lossless floating point: every vector of values is multiplied by
+// 10^exponent / 10^factor and rounded to integers, one (exponent, factor) pair
+// per vector. The pairs are picked on a sample, values that do not survive the
+// round trip are stored as exceptions and patched in by their position.
+namespace alp {
+const u32 vector_size = 1024;
+struct Params {
+  u8 exponent;
+  u8 factor;
+};
+static_assert(sizeof(Params) == 2);
+// -------------------------------------------------------------------------------------
+// (exponent, factor) pairs the vectors of a block choose from
+const u32 max_candidates = 5;
+// Vectors the candidates are searched on, and values sampled from each vector
+const u32 sampled_vectors = 8;
+const u32 samples_per_vector = 32;
+// The digits are guessed in double precision, where adding and subtracting
+// 2^52 + 2^51 rounds to the nearest integer without a call to std::round
+const DOUBLE magic_number = 6755399441055744.0;
+const DOUBLE min_digit = std::numeric_limits<INTEGER>::min();
+const DOUBLE max_digit = std::numeric_limits<INTEGER>::max();
+static const double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+};
+static const double fractions_of_ten[] = {
+    1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8,  1e-9,
+    1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18,
+};
+// Up to 10^10 the powers of ten are exact in a float as well
+static const float exact_powers_of_ten_f[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+// -------------------------------------------------------------------------------------
+// How a width decodes its digits. The SIMD loops convert and decode the
+// leading rows of a vector and return how many they did.
+template <typename NumberType>
+struct Traits;
+// -------------------------------------------------------------------------------------
+template <>
+struct Traits<DOUBLE> {
+  static constexpr u8 max_exponent = 18;
+  static constexpr const char* name = "double";
+  // -------------------------------------------------------------------------------------
+  static inline DOUBLE decodeValue(INTEGER digit, Params params) {
+    return static_cast<DOUBLE>(digit) * exact_powers_of_ten[params.factor] *
+           fractions_of_ten[params.exponent];
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 encodeBlocks(const DOUBLE* src,
+                                 u32 count,
+                                 Params params,
+                                 INTEGER* digits,
+                                 INTEGER* positions,
+                                 u32 offset,
+                                 u32& exceptions) {
+    u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256d power = _mm256_set1_pd(exact_powers_of_ten[params.exponent]);
+    const __m256d fraction = _mm256_set1_pd(fractions_of_ten[params.factor]);
+    const __m256d inverse_power = _mm256_set1_pd(exact_powers_of_ten[params.factor]);
+    const __m256d inverse_fraction = _mm256_set1_pd(fractions_of_ten[params.exponent]);
+    const __m256d magic = _mm256_set1_pd(magic_number);
+    const __m256d min = _mm256_set1_pd(min_digit);
+    const __m256d max = _mm256_set1_pd(max_digit);
+    for (; row_i + 4 <= count; row_i += 4) {
+      __m256d values = _mm256_loadu_pd(src + row_i);
+      __m256d scaled = _mm256_mul_pd(_mm256_mul_pd(values, power), fraction);
+      __m256d rounded = _mm256_sub_pd(_mm256_add_pd(scaled, magic), magic);
+      // NaN compares false and is out of range as well
+      __m256d in_range = _mm256_and_pd(_mm256_cmp_pd(rounded, min, _CMP_GE_OQ),
+                                       _mm256_cmp_pd(rounded, max, _CMP_LE_OQ));
+      __m128i converted = _mm256_cvttpd_epi32(rounded);
+      __m256d decoded = _mm256_mul_pd(
+          _mm256_mul_pd(_mm256_cvtepi32_pd(converted), inverse_power), inverse_fraction);
+      __m256i same =
+          _mm256_cmpeq_epi64(_mm256_castpd_si256(decoded), _mm256_castpd_si256(values));
+      int converted_mask = _mm256_movemask_pd(_mm256_and_pd(in_range, _mm256_castsi256_pd(same)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(digits + row_i), converted);
+      if (converted_mask != 0xF) {
+        for (u32 lane_i = 0; lane_i < 4; lane_i++) {
+          if (!(converted_mask & (1 << lane_i))) {
+            positions[exceptions++] = offset + row_i + lane_i;
+          }
+        }
+      }
+    }
+#endif
+    return row_i;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 decodeBlocks(const INTEGER* digits, u32 count, Params params, DOUBLE* dest) {
+    u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256d power = _mm256_set1_pd(exact_powers_of_ten[params.factor]);
+    const __m256d fraction = _mm256_set1_pd(fractions_of_ten[params.exponent]);
+    for (; row_i + 8 <= count; row_i += 8) {
+      __m256d digits_0 =
+          _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + row_i)));
+      __m256d digits_1 = _mm256_cvtepi32_pd(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + row_i + 4)));
+      _mm256_storeu_pd(dest + row_i, _mm256_mul_pd(_mm256_mul_pd(digits_0, power), fraction));
+      _mm256_storeu_pd(dest + row_i + 4, _mm256_mul_pd(_mm256_mul_pd(digits_1, power), fraction));
+    }
+#endif
+    return row_i;
+  }
+};
+static_assert(sizeof(exact_powers_of_ten) == sizeof(double) * (Traits<DOUBLE>::max_exponent + 1));
+static_assert(sizeof(fractions_of_ten) == sizeof(double) * (Traits<DOUBLE>::max_exponent + 1));
+// -------------------------------------------------------------------------------------
+// Exponents stop at 10 like the powers of ten a float holds exactly
+template <>
+struct Traits<FLOAT> {
+  static constexpr u8 max_exponent = 10;
+  static constexpr const char* name = "float";
+  // -------------------------------------------------------------------------------------
+  // Dividing by the exact power of ten rounds like parsing the decimal does,
+  // multiplying with the rounded fraction would make many values exceptions
+  static inline FLOAT decodeValue(INTEGER digit, Params params) {
+    return static_cast<FLOAT>(digit) * exact_powers_of_ten_f[params.factor] /
+           exact_powers_of_ten_f[params.exponent];
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 encodeBlocks(const FLOAT* src,
+                                 u32 count,
+                                 Params params,
+                                 INTEGER* digits,
+                                 INTEGER* positions,
+                                 u32 offset,
+                                 u32& exceptions) {
+    u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256d power = _mm256_set1_pd(exact_powers_of_ten[params.exponent]);
+    const __m256d fraction = _mm256_set1_pd(fractions_of_ten[params.factor]);
+    const __m256 factor_power = _mm256_set1_ps(exact_powers_of_ten_f[params.factor]);
+    const __m256 exponent_power = _mm256_set1_ps(exact_powers_of_ten_f[params.exponent]);
+    const __m256d magic = _mm256_set1_pd(magic_number);
+    const __m256d min = _mm256_set1_pd(min_digit);
+    const __m256d max = _mm256_set1_pd(max_digit);
+    for (; row_i + 8 <= count; row_i += 8) {
+      __m256 values = _mm256_loadu_ps(src + row_i);
+      // Both halves are widened, scaled and rounded in double precision
+      __m256d halves[2] = {_mm256_cvtps_pd(_mm256_castps256_ps128(values)),
+                           _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1))};
+      __m128i converted[2];
+      int in_range_mask = 0;
+      for (u32 half_i = 0; half_i < 2; half_i++) {
+        __m256d scaled = _mm256_mul_pd(_mm256_mul_pd(halves[half_i], power), fraction);
+        __m256d rounded = _mm256_sub_pd(_mm256_add_pd(scaled, magic), magic);
+        // NaN compares false and is out of range as well
+        __m256d in_range = _mm256_and_pd(_mm256_cmp_pd(rounded, min, _CMP_GE_OQ),
+                                         _mm256_cmp_pd(rounded, max, _CMP_LE_OQ));
+        in_range_mask |= _mm256_movemask_pd(in_range) << (half_i * 4);
+        converted[half_i] = _mm256_cvttpd_epi32(rounded);
+      }
+      __m256i digits_v = _mm256_set_m128i(converted[1], converted[0]);
+      __m256 decoded = _mm256_div_ps(
+          _mm256_mul_ps(_mm256_cvtepi32_ps(digits_v), factor_power), exponent_power);
+      __m256i same =
+          _mm256_cmpeq_epi32(_mm256_castps_si256(decoded), _mm256_castps_si256(values));
+      int converted_mask = in_range_mask & _mm256_movemask_ps(_mm256_castsi256_ps(same));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits + row_i), digits_v);
+      if (converted_mask != 0xFF) {
+        for (u32 lane_i = 0; lane_i < 8; lane_i++) {
+          if (!(converted_mask & (1 << lane_i))) {
+            positions[exceptions++] = offset + row_i + lane_i;
+          }
+        }
+      }
+    }
+#endif
+    return row_i;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 decodeBlocks(const INTEGER* digits, u32 count, Params params, FLOAT* dest) {
+    u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256 factor = _mm256_set1_ps(exact_powers_of_ten_f[params.factor]);
+    const __m256 exponent = _mm256_set1_ps(exact_powers_of_ten_f[params.exponent]);
+    for (; row_i + 16 <= count; row_i += 16) {
+      __m256 digits_0 = _mm256_cvtepi32_ps(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + row_i)));
+      __m256 digits_1 = _mm256_cvtepi32_ps(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + row_i + 8)));
+      _mm256_storeu_ps(dest + row_i, _mm256_div_ps(_mm256_mul_ps(digits_0, factor), exponent));
+      _mm256_storeu_ps(dest + row_i + 8,
+                       _mm256_div_ps(_mm256_mul_ps(digits_1, factor), exponent));
+    }
+#endif
+    return row_i;
+  }
+};
+static_assert(sizeof(exact_powers_of_ten_f) == sizeof(float) * (Traits<FLOAT>::max_exponent + 1));
+}  // namespace alp
+// -------------------------------------------------------------------------------------
+struct AlpStructure {
+  u32 exceptions_count;
+  u32 numbers_offset;
+  u32 positions_offset;
+  u32 exceptions_offset;
+  // -------------------------------------------------------------------------------------
+  u8 numbers_scheme;
+  u8 positions_scheme;
+  u8 exceptions_scheme;
+  u8 padding;
+  // -------------------------------------------------------------------------------------
+  u8 data[];  // params of every vector | numbers | positions | exceptions
+};
+// -------------------------------------------------------------------------------------
+// BitsType holds the bits of a NumberType, -0.0 and NaN only survive the round
+// trip when the bits are compared
+template <typename NumberType,
+          typename BitsType,
+          typename SchemeType,
+          typename StatsType,
+          typename SchemeCodeType>
+class TAlp {
+  static_assert(sizeof(NumberType) == sizeof(BitsType));
+  using Traits = alp::Traits<NumberType>;
+  using Picker = CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>;
+  static constexpr u8 max_exponent = Traits::max_exponent;
+  // An exception stores its value and its position
+  static constexpr u32 exception_bits = (sizeof(NumberType) + sizeof(INTEGER)) * 8;
+
+ public:
+  // -------------------------------------------------------------------------------------
+  static inline u32 compressColumn(const NumberType* src,
+                                   u8* dest,
+                                   StatsType& stats,
+                                   u8 allowed_cascading_level) {
+    // Layout : Header | params | numbers_v | positions_v | exceptions_v
+    auto& col_struct = *reinterpret_cast<AlpStructure*>(dest);
+    const u32 vector_count = (stats.tuple_count + alp::vector_size - 1) / alp::vector_size;
+    auto params = reinterpret_cast<alp::Params*>(col_struct.data);
+    auto& arena = ThreadCache::get().arena;
+    auto numbers_v = arena.allocate<INTEGER>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+    auto positions_v = arena.allocate<INTEGER>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+    auto exceptions_v =
+        arena.allocate<NumberType>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(NumberType));
+
+    auto candidates = findCandidates(src, stats.tuple_count);
+    u32 exceptions_count = 0;
+    for (u32 vector_i = 0; vector_i < vector_count; vector_i++) {
+      const u32 offset = vector_i * alp::vector_size;
+      const u32 count = std::min(alp::vector_size, stats.tuple_count - offset);
+      params[vector_i] = pickParams(src + offset, count, candidates);
+      u32 vector_exceptions = encodeVector(src + offset, count, params[vector_i],
+                                           numbers_v + offset, positions_v + exceptions_count,
+                                           offset);
+      for (u32 exception_i = exceptions_count;
+           exception_i < exceptions_count + vector_exceptions; exception_i++) {
+        exceptions_v[exception_i] = src[positions_v[exception_i]];
+      }
+      exceptions_count += vector_exceptions;
+      if (exceptions_count > stats.tuple_count / 2) {
+        // Same as Decimal, a big size makes the picker choose another scheme
+        return stats.total_size + 1000;
+      }
+    }
+    col_struct.exceptions_count = exceptions_count;
+    col_struct.numbers_offset = vector_count * sizeof(alp::Params);
+    auto write_ptr = col_struct.data + col_struct.numbers_offset;
+
+    // Compress digits
+    {
+      u32 used_space;
+      IntegerSchemePicker::compress(numbers_v, nullptr, write_ptr, stats.tuple_count,
+                                    allowed_cascading_level - 1, used_space,
+                                    col_struct.numbers_scheme, autoScheme(), "alp digits");
+      write_ptr += used_space;
+      Log::debug("Alp: d_c = {} d_s = {}", CI(col_struct.numbers_scheme), CI(used_space));
+    }
+
+    // Compress exception positions and values
+    col_struct.positions_offset = write_ptr - col_struct.data;
+    col_struct.exceptions_offset = col_struct.positions_offset;
+    if (exceptions_count > 0) {
+      u32 used_space;
+      IntegerSchemePicker::compress(positions_v, nullptr, write_ptr, exceptions_count,
+                                    allowed_cascading_level - 1, used_space,
+                                    col_struct.positions_scheme, autoScheme(), "alp positions");
+      write_ptr += used_space;
+      col_struct.exceptions_offset = write_ptr - col_struct.data;
+      Picker::compress(exceptions_v, nullptr, write_ptr, exceptions_count,
+                       allowed_cascading_level - 1, used_space, col_struct.exceptions_scheme,
+                       autoScheme(), "alp exceptions");
+      write_ptr += used_space;
+      Log::debug("Alp: e_c = {} e_s = {}", CI(col_struct.exceptions_scheme), CI(used_space));
+    }
+
+    return write_ptr - dest;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void decompressColumn(NumberType* dest, const u8* src, u32 tuple_count, u32 level) {
+    const auto& col_struct = *reinterpret_cast<const AlpStructure*>(src);
+    const u32 vector_count = (tuple_count + alp::vector_size - 1) / alp::vector_size;
+    auto params = reinterpret_cast<const alp::Params*>(col_struct.data);
+
+    thread_local std::vector<std::vector<INTEGER>> numbers_v;
+    auto numbers = get_level_data(numbers_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& numbers_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.numbers_scheme);
+    numbers_scheme.decompress(numbers, nullptr, col_struct.data + col_struct.numbers_offset,
+                              tuple_count, level + 1);
+    for (u32 vector_i = 0; vector_i < vector_count; vector_i++) {
+      const u32 offset = vector_i * alp::vector_size;
+      decodeVector(numbers + offset, std::min(alp::vector_size, tuple_count - offset),
+                   params[vector_i], dest + offset);
+    }
+
+    // Patch the exceptions
+    if (col_struct.exceptions_count > 0) {
+      thread_local std::vector<std::vector<INTEGER>> positions_v;
+      auto positions = get_level_data(
+          positions_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+      thread_local std::vector<std::vector<NumberType>> exceptions_v;
+      auto exceptions = get_level_data(
+          exceptions_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+      IntegerScheme& positions_scheme =
+          IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme);
+      positions_scheme.decompress(positions, nullptr,
+                                  col_struct.data + col_struct.positions_offset,
+                                  col_struct.exceptions_count, level + 1);
+      SchemeType& exceptions_scheme =
+          Picker::MyTypeWrapper::getScheme(col_struct.exceptions_scheme);
+      exceptions_scheme.decompress(exceptions, nullptr,
+                                   col_struct.data + col_struct.exceptions_offset,
+                                   col_struct.exceptions_count, level + 1);
+      for (u32 exception_i = 0; exception_i < col_struct.exceptions_count; exception_i++) {
+        dest[positions[exception_i]] = exceptions[exception_i];
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline NumberType lookupRow(const u8* src, u32 row, u32 tuple_count, u32 level) {
+    const auto& col_struct = *reinterpret_cast<const AlpStructure*>(src);
+    auto params = reinterpret_cast<const alp::Params*>(col_struct.data);
+
+    // The positions are sorted, the row is an exception if it is among them
+    if (col_struct.exceptions_count > 0) {
+      thread_local std::vector<std::vector<INTEGER>> positions_v;
+      auto positions = get_level_data(
+          positions_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+      IntegerScheme& positions_scheme =
+          IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme);
+      positions_scheme.decompress(positions, nullptr,
+                                  col_struct.data + col_struct.positions_offset,
+                                  col_struct.exceptions_count, level + 1);
+      auto positions_end = positions + col_struct.exceptions_count;
+      auto position = std::lower_bound(positions, positions_end, static_cast<INTEGER>(row));
+      if (position != positions_end && *position == static_cast<INTEGER>(row)) {
+        SchemeType& exceptions_scheme =
+            Picker::MyTypeWrapper::getScheme(col_struct.exceptions_scheme);
+        return exceptions_scheme.lookup(col_struct.data + col_struct.exceptions_offset,
+                                        position - positions, col_struct.exceptions_count,
+                                        level + 1);
+      }
+    }
+    IntegerScheme& numbers_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.numbers_scheme);
+    auto digit = numbers_scheme.lookup(col_struct.data + col_struct.numbers_offset, row,
+                                       tuple_count, level + 1);
+    return Traits::decodeValue(digit, params[row / alp::vector_size]);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string fullDescription(const u8* src, const string& selfDescription) {
+    const auto& col_struct = *reinterpret_cast<const AlpStructure*>(src);
+    string result = selfDescription;
+
+    IntegerScheme& d_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.numbers_scheme);
+    result += "\n\t-> ([int] digits) " +
+              d_scheme.fullDescription(col_struct.data + col_struct.numbers_offset);
+
+    if (col_struct.exceptions_count > 0) {
+      IntegerScheme& p_scheme =
+          IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme);
+      result += "\n\t-> ([int] exception positions) " +
+                p_scheme.fullDescription(col_struct.data + col_struct.positions_offset);
+      SchemeType& e_scheme = Picker::MyTypeWrapper::getScheme(col_struct.exceptions_scheme);
+      result += "\n\t-> ([" + string(Traits::name) + "] exceptions) " +
+                e_scheme.fullDescription(col_struct.data + col_struct.exceptions_offset);
+    }
+
+    return result;
+  }
+  // -------------------------------------------------------------------------------------
+ private:
+  static inline DOUBLE encodeValue(NumberType value, alp::Params params) {
+    DOUBLE scaled = static_cast<DOUBLE>(value) * alp::exact_powers_of_ten[params.exponent] *
+                    alp::fractions_of_ten[params.factor];
+    return scaled + alp::magic_number - alp::magic_number;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline bool sameBits(NumberType a, NumberType b) {
+    BitsType a_bits, b_bits;
+    std::memcpy(&a_bits, &a, sizeof(a));
+    std::memcpy(&b_bits, &b, sizeof(b));
+    return a_bits == b_bits;
+  }
+  // -------------------------------------------------------------------------------------
+  // Converts a value, returns false if it has to be stored as an exception
+  static inline bool convert(NumberType value, alp::Params params, INTEGER& digit) {
+    DOUBLE rounded = encodeValue(value, params);
+    if (!(rounded >= alp::min_digit && rounded <= alp::max_digit)) {
+      return false;
+    }
+    digit = static_cast<INTEGER>(rounded);
+    return sameBits(Traits::decodeValue(digit, params), value);
+  }
+  // -------------------------------------------------------------------------------------
+  // Estimated bits of the vector, taken from samples_per_vector of its values
+  static u64 estimateBits(const NumberType* src, u32 count, alp::Params params) {
+    const u32 step = std::max(1u, count / alp::samples_per_vector);
+    INTEGER min = std::numeric_limits<INTEGER>::max();
+    INTEGER max = std::numeric_limits<INTEGER>::min();
+    u32 sample_count = 0, exceptions = 0;
+    for (u32 row_i = 0; row_i < count; row_i += step) {
+      INTEGER digit;
+      sample_count++;
+      if (convert(src[row_i], params, digit)) {
+        min = std::min(min, digit);
+        max = std::max(max, digit);
+      } else {
+        exceptions++;
+      }
+    }
+    u32 bit_width = 0;
+    if (exceptions < sample_count) {
+      u64 range = static_cast<u64>(static_cast<s64>(max) - static_cast<s64>(min));
+      bit_width = range == 0 ? 0 : 64 - __builtin_clzll(range);
+    }
+    return static_cast<u64>(bit_width) * sample_count +
+           static_cast<u64>(exceptions) * exception_bits;
+  }
+  // -------------------------------------------------------------------------------------
+  // Every sampled vector votes for the pair that suits it best, the pairs with
+  // the most votes are the candidates of the whole block
+  static vector<alp::Params> findCandidates(const NumberType* src, u32 tuple_count) {
+    const u32 vector_count = (tuple_count + alp::vector_size - 1) / alp::vector_size;
+    const u32 vector_step = std::max(1u, vector_count / alp::sampled_vectors);
+    u32 votes[max_exponent + 1][max_exponent + 1] = {};
+    for (u32 vector_i = 0; vector_i < vector_count; vector_i += vector_step) {
+      const u32 offset = vector_i * alp::vector_size;
+      const u32 count = std::min(alp::vector_size, tuple_count - offset);
+      alp::Params best{0, 0};
+      u64 best_bits = std::numeric_limits<u64>::max();
+      for (u8 exponent = 0; exponent <= max_exponent; exponent++) {
+        for (u8 factor = 0; factor <= exponent; factor++) {
+          u64 bits = estimateBits(src + offset, count, {exponent, factor});
+          if (bits < best_bits) {
+            best_bits = bits;
+            best = {exponent, factor};
+          }
+        }
+      }
+      votes[best.exponent][best.factor]++;
+    }
+    // -------------------------------------------------------------------------------------
+    vector<std::pair<u32, alp::Params>> voted;
+    for (u8 exponent = 0; exponent <= max_exponent; exponent++) {
+      for (u8 factor = 0; factor <= exponent; factor++) {
+        if (votes[exponent][factor] > 0) {
+          voted.push_back({votes[exponent][factor], {exponent, factor}});
+        }
+      }
+    }
+    std::stable_sort(voted.begin(), voted.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    vector<alp::Params> candidates;
+    for (u32 i = 0; i < std::min<u32>(voted.size(), alp::max_candidates); i++) {
+      candidates.push_back(voted[i].second);
+    }
+    return candidates;
+  }
+  // -------------------------------------------------------------------------------------
+  static alp::Params pickParams(const NumberType* src,
+                                u32 count,
+                                const vector<alp::Params>& candidates) {
+    if (candidates.size() == 1) {
+      return candidates[0];
+    }
+    alp::Params best = candidates[0];
+    u64 best_bits = std::numeric_limits<u64>::max();
+    for (auto params : candidates) {
+      u64 bits = estimateBits(src, count, params);
+      if (bits < best_bits) {
+        best_bits = bits;
+        best = params;
+      }
+    }
+    return best;
+  }
+  // -------------------------------------------------------------------------------------
+  // Writes the digits of a vector and appends the rows that did not convert to
+  // positions, returns how many did not
+  static u32 encodeVector(const NumberType* src,
+                          u32 count,
+                          alp::Params params,
+                          INTEGER* digits,
+                          INTEGER* positions,
+                          u32 offset) {
+    u32 exceptions = 0;
+    u32 row_i = Traits::encodeBlocks(src, count, params, digits, positions, offset, exceptions);
+    for (; row_i < count; row_i++) {
+      if (!convert(src[row_i], params, digits[row_i])) {
+        positions[exceptions++] = offset + row_i;
+      }
+    }
+    // -------------------------------------------------------------------------------------
+    if (exceptions > 0) {
+      // Exceptions take the digit of a value that converted, so that they do
+      // not widen the range the digits are bit packed with
+      INTEGER placeholder = 0;
+      for (u32 row_i = 0, exception_i = 0; row_i < count; row_i++) {
+        if (exception_i < exceptions &&
+            positions[exception_i] == static_cast<INTEGER>(offset + row_i)) {
+          exception_i++;
+        } else {
+          placeholder = digits[row_i];
+          break;
+        }
+      }
+      for (u32 exception_i = 0; exception_i < exceptions; exception_i++) {
+        digits[positions[exception_i] - offset] = placeholder;
+      }
+    }
+    return exceptions;
+  }
+  // -------------------------------------------------------------------------------------
+  static void decodeVector(const INTEGER* digits, u32 count, alp::Params params, NumberType* dest) {
+    for (u32 row_i = Traits::decodeBlocks(digits, count, params, dest); row_i < count; row_i++) {
+      dest[row_i] = Traits::decodeValue(digits[row_i], params);
+    }
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
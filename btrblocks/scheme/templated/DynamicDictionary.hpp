@@ -45,14 +45,15 @@ class TDynamicDictionary {
     auto dict_begin = reinterpret_cast<NumberType*>(col_struct.data);
     auto dict_end = reinterpret_cast<NumberType*>(col_struct.data) + distinct_i;
     // -------------------------------------------------------------------------------------
-    vector<INTEGER> codes;
+    auto codes = ThreadCache::get().arena.allocate<INTEGER>(stats.tuple_count +
+                                                            SIMD_EXTRA_ELEMENTS(INTEGER));
     for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
       auto it = std::lower_bound(dict_begin, dict_end, src[row_i]);
       if (it == dict_end) {
-        die_if(stats.distinct_values.find(src[row_i]) != stats.distinct_values.end());
+        die_if(stats.distinct_values.contains(src[row_i]));
       }
       die_if(it != dict_end);
-      codes.push_back(std::distance(dict_begin, it));
+      codes[row_i] = std::distance(dict_begin, it);
     }
     // -------------------------------------------------------------------------------------
     // Compress codes
@@ -62,7 +63,7 @@ class TDynamicDictionary {
     // For Number dictionaries, we only need FBP/PBP for coding, if any other
     // schemes was useful beneath, it had to be rather chosen instead of X_DICT
     // in the first place.
-    IntegerSchemePicker::compress(codes.data(), nullptr, write_ptr, codes.size(),
+    IntegerSchemePicker::compress(codes, nullptr, write_ptr, stats.tuple_count,
                                   allowed_cascading_level - 1, used_space,
                                   col_struct.codes_scheme_code, CB(IntegerSchemeType::BP), "codes");
     // -------------------------------------------------------------------------------------
@@ -95,6 +96,128 @@ class TDynamicDictionary {
     }
   }
   // -------------------------------------------------------------------------------------
+  // Counts how often every code occurs and aggregates the dictionary values
+  // with their frequency
+  static inline TAggregate<NumberType> aggregateColumn(BitmapWrapper* nullmap,
+                                                       const u8* src,
+                                                       u32 tuple_count,
+                                                       u32 level) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    TAggregate<NumberType> aggregate;
+    if (nullmap != nullptr && nullmap->type() == BitmapType::ALLZEROS) {
+      return aggregate;
+    }
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<INTEGER>> codes_v;
+    auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+                      level + 1);
+    // -------------------------------------------------------------------------------------
+    const u32 dict_size = col_struct.codes_offset / sizeof(NumberType);
+    thread_local std::vector<std::vector<u32>> histogram_v;
+    auto histogram = get_level_data(histogram_v, dict_size, level);
+    std::fill_n(histogram, dict_size, 0);
+    if (nullmap == nullptr || nullmap->type() == BitmapType::ALLONES) {
+      for (u32 i = 0; i < tuple_count; i++) {
+        histogram[codes[i]]++;
+      }
+    } else {
+      thread_local std::vector<std::vector<BITMAP>> not_null_v;
+      auto not_null = get_level_data(not_null_v, tuple_count, level);
+      nullmap->writeBITMAP(not_null);
+      for (u32 i = 0; i < tuple_count; i++) {
+        histogram[codes[i]] += not_null[i];
+      }
+    }
+    // -------------------------------------------------------------------------------------
+    auto dict = reinterpret_cast<const NumberType*>(col_struct.data);
+    for (u32 code = 0; code < dict_size; code++) {
+      aggregate.add(dict[code], histogram[code]);
+    }
+    return aggregate;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 decompressDictionaryColumn(vector<u8>& dictionary,
+                                               u32* codes,
+                                               const u8* src,
+                                               u32 tuple_count,
+                                               u32 level) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    // The dictionary is stored uncompressed in front of the codes
+    std::memcpy(get_data(dictionary, col_struct.codes_offset), col_struct.data,
+                col_struct.codes_offset);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompress(reinterpret_cast<INTEGER*>(codes), nullptr,
+                      col_struct.data + col_struct.codes_offset, tuple_count, level + 1);
+    return col_struct.codes_offset / sizeof(NumberType);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline NumberType lookupRow(const u8* src, u32 row, u32 tuple_count, u32 level) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    auto code = scheme.lookup(col_struct.data + col_struct.codes_offset, row, tuple_count,
+                              level + 1);
+    return reinterpret_cast<const NumberType*>(col_struct.data)[code];
+  }
+  // -------------------------------------------------------------------------------------
+  // Only the selected codes are decoded, see IntegerScheme::decompressSelected
+  static inline void decompressSelectedColumn(NumberType* dest,
+                                              const u32* selection,
+                                              u32 count,
+                                              const u8* src,
+                                              u32 tuple_count,
+                                              u32 level) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<INTEGER>> codes_v;
+    auto codes = get_level_data(codes_v, count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompressSelected(codes, selection, count, nullptr,
+                              col_struct.data + col_struct.codes_offset, tuple_count, level + 1);
+    // -------------------------------------------------------------------------------------
+    auto dict = reinterpret_cast<const NumberType*>(col_struct.data);
+    for (u32 i = 0; i < count; i++) {
+      dest[i] = dict[codes[i]];
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void scanColumn(const TPredicate<NumberType>& predicate,
+                                BITMAP* result,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    // The codes directly follow the sorted dictionary
+    auto dict = reinterpret_cast<const NumberType*>(col_struct.data);
+    const u32 dict_size = col_struct.codes_offset / sizeof(NumberType);
+    const auto selection =
+        CodeSelection::build(dict_size, [&](u32 code) { return predicate.matches(dict[code]); });
+    if (selection.none() || selection.all()) {
+      std::memset(result, selection.all(), tuple_count);
+      return;
+    }
+    // -------------------------------------------------------------------------------------
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    if (selection.isRange()) {
+      scheme.scan(selection.rangePredicate(), result, col_struct.data + col_struct.codes_offset,
+                  tuple_count, level + 1);
+      return;
+    }
+    thread_local std::vector<std::vector<INTEGER>> codes_v;
+    auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+                      level + 1);
+    selection.apply(codes, tuple_count, result);
+  }
+  // -------------------------------------------------------------------------------------
   static inline string fullDescription(const u8* src, const string& selfDescription) {
     auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
     IntegerScheme& scheme =
@@ -214,4 +337,58 @@ inline void TDynamicDictionary<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeTy
     i++;
   }
 }
+
+template <>
+inline void TDynamicDictionary<FLOAT, FloatScheme, FloatStats, FloatSchemeType>::
+    decompressColumn(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
+  BTR_IFSIMD({
+    static_assert(sizeof(*dest) == 4);
+    static_assert(SIMD_EXTRA_BYTES >= 4 * sizeof(__m256));
+  })
+
+  auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+
+  // Decode codes
+  thread_local std::vector<std::vector<INTEGER>> codes_v;
+  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerScheme& scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+  scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+                    level + 1);
+
+  auto dict = reinterpret_cast<const FLOAT*>(col_struct.data);
+  u32 i = 0;
+#ifdef BTR_USE_SIMD
+  if (tuple_count >= 32) {
+    while (i < tuple_count - 31) {
+      // Load codes
+      __m256i codes_0 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 0));
+      __m256i codes_1 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 8));
+      __m256i codes_2 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 16));
+      __m256i codes_3 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 24));
+
+      // gather values
+      __m256 values_0 = _mm256_i32gather_ps(dict, codes_0, 4);
+      __m256 values_1 = _mm256_i32gather_ps(dict, codes_1, 4);
+      __m256 values_2 = _mm256_i32gather_ps(dict, codes_2, 4);
+      __m256 values_3 = _mm256_i32gather_ps(dict, codes_3, 4);
+
+      // store values
+      _mm256_storeu_ps(dest + 0, values_0);
+      _mm256_storeu_ps(dest + 8, values_1);
+      _mm256_storeu_ps(dest + 16, values_2);
+      _mm256_storeu_ps(dest + 24, values_3);
+
+      dest += 32;
+      codes += 32;
+      i += 32;
+    }
+  }
+#endif
+
+  while (i < tuple_count) {
+    *dest++ = dict[*codes++];
+    i++;
+  }
+}
 }  // namespace btrblocks
@@ -44,7 +44,7 @@ inline u32 FDictCompressColumn(const NumberType* src, const BITMAP*, u8* dest, S
   for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
     auto it = std::lower_bound(dict_begin, dict_end, src[row_i]);
     if (it == dict_end) {
-      die_if(stats.distinct_values.find(src[row_i]) != stats.distinct_values.end());
+      die_if(stats.distinct_values.contains(src[row_i]));
     }
     die_if(it != dict_end);
     codes[row_i] = static_cast<CodeType>(std::distance(dict_begin, it));
@@ -70,4 +70,35 @@ inline void FDictDecompressColumn(NumberType* dest,
   }
 }
 // -------------------------------------------------------------------------------------
+template <typename CodeType, typename NumberType>
+inline void FDictScanColumn(const TPredicate<NumberType>& predicate,
+                            BITMAP* result,
+                            const u8* src,
+                            u32 tuple_count) {
+  const auto& col_struct = *reinterpret_cast<const FixedDictionaryStructure<NumberType>*>(src);
+  const u32 dict_size =
+      (col_struct.codes_offset - sizeof(FixedDictionaryStructure<NumberType>)) / sizeof(NumberType);
+  const auto selection = CodeSelection::build(
+      dict_size, [&](u32 code) { return predicate.matches(col_struct.dict_slots[code]); });
+  // -------------------------------------------------------------------------------------
+  const auto codes = reinterpret_cast<const CodeType*>(src + col_struct.codes_offset);
+  selection.apply(codes, tuple_count, result);
+}
+// -------------------------------------------------------------------------------------
+template <typename CodeType, typename NumberType>
+inline u32 FDictDecompressDictionary(vector<u8>& dictionary,
+                                     u32* codes,
+                                     const u8* src,
+                                     u32 tuple_count) {
+  const auto& col_struct = *reinterpret_cast<const FixedDictionaryStructure<NumberType>*>(src);
+  const u32 dict_bytes = col_struct.codes_offset - sizeof(FixedDictionaryStructure<NumberType>);
+  std::memcpy(get_data(dictionary, dict_bytes), col_struct.dict_slots, dict_bytes);
+  // -------------------------------------------------------------------------------------
+  const auto src_codes = reinterpret_cast<const CodeType*>(src + col_struct.codes_offset);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    codes[row_i] = src_codes[row_i];
+  }
+  return dict_bytes / sizeof(NumberType);
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks
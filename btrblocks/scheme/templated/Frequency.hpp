@@ -135,6 +135,64 @@ class TFrequency {
         &param);
   }
   // -------------------------------------------------------------------------------------
+  // Every non-null row that is not an exception holds the top value, only
+  // the exceptions are aggregated in their own scheme
+  static inline TAggregate<NumberType> aggregateColumn(BitmapWrapper* nullmap,
+                                                       const u8* src,
+                                                       u32 tuple_count,
+                                                       u32 level) {
+    const auto& col_struct = *reinterpret_cast<const FrequencyStructure<NumberType>*>(src);
+    Roaring exceptions_bitmap =
+        Roaring::read(reinterpret_cast<const char*>(col_struct.data), false);
+    const u32 exceptions_count = exceptions_bitmap.cardinality();
+    const u32 not_null_count = nullmap == nullptr ? tuple_count : nullmap->cardinality();
+    // -------------------------------------------------------------------------------------
+    TAggregate<NumberType> aggregate;
+    aggregate.add(col_struct.top_value, not_null_count - exceptions_count);
+    if (exceptions_count > 0) {
+      aggregate.merge(
+          CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::MyTypeWrapper::
+              getScheme(col_struct.next_scheme)
+                  .aggregate(nullptr, col_struct.data + col_struct.exceptions_offset,
+                             exceptions_count, level + 1));
+    }
+    return aggregate;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void scanColumn(const TPredicate<NumberType>& predicate,
+                                BITMAP* result,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) {
+    const auto& col_struct = *reinterpret_cast<const FrequencyStructure<NumberType>*>(src);
+    // -------------------------------------------------------------------------------------
+    // The top value decides for every row that is not an exception
+    std::memset(result, predicate.matches(col_struct.top_value), tuple_count);
+    // -------------------------------------------------------------------------------------
+    Roaring exceptions_bitmap =
+        Roaring::read(reinterpret_cast<const char*>(col_struct.data), false);
+    const u32 exceptions_count = exceptions_bitmap.cardinality();
+    if (exceptions_count == 0) {
+      return;
+    }
+    thread_local std::vector<std::vector<BITMAP>> exception_matches_v;
+    auto exception_matches = get_level_data(exception_matches_v, exceptions_count, level);
+    CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::MyTypeWrapper::getScheme(
+        col_struct.next_scheme)
+        .scan(predicate, exception_matches, col_struct.data + col_struct.exceptions_offset,
+              exceptions_count, level + 1);
+    // -------------------------------------------------------------------------------------
+    std::pair<BITMAP*, const BITMAP*> param = {result, exception_matches};
+    exceptions_bitmap.iterate(
+        [](uint32_t value, void* param) {
+          auto p = reinterpret_cast<std::pair<BITMAP*, const BITMAP*>*>(param);
+          p->first[value] = *(p->second);
+          p->second++;
+          return true;
+        },
+        &param);
+  }
+  // -------------------------------------------------------------------------------------
   static inline string fullDescription(const u8* src, const string& selfDescription) {
     const auto& col_struct = *reinterpret_cast<const FrequencyStructure<NumberType>*>(src);
     auto result = selfDescription;
@@ -2,6 +2,8 @@
 #include "compression/SchemePicker.hpp"
 #include "scheme/CompressionScheme.hpp"
 // -------------------------------------------------------------------------------------
+#include <numeric>
+// -------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
@@ -26,8 +28,12 @@ class TRLE {
                                    u8 force_counts = autoScheme()) {
     auto& col_struct = *reinterpret_cast<RLEStructure*>(dest);
     // -------------------------------------------------------------------------------------
-    std::vector<NumberType> rle_values;
-    std::vector<INTEGER> rle_count;
+    // At most one run per tuple, released by the scope of the caller
+    auto& arena = ThreadCache::get().arena;
+    auto rle_values =
+        arena.allocate<NumberType>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(NumberType));
+    auto rle_count = arena.allocate<INTEGER>(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+    u32 runs_count = 0;
     // -------------------------------------------------------------------------------------
     // RLE encoding
     NumberType last_item = src[0];
@@ -38,17 +44,18 @@ class TRLE {
                                                       // no compression benefits
         count++;
       } else {
-        rle_count.push_back(count);
-        rle_values.push_back(last_item);
+        rle_count[runs_count] = count;
+        rle_values[runs_count] = last_item;
+        runs_count++;
         last_item = src[row_i];
         count = 1;
       }
     }
-    rle_count.push_back(count);
-    rle_values.push_back(last_item);
+    rle_count[runs_count] = count;
+    rle_values[runs_count] = last_item;
+    runs_count++;
     // -------------------------------------------------------------------------------------
-    col_struct.runs_count = rle_count.size();
-    die_if(rle_count.size() == rle_values.size());
+    col_struct.runs_count = runs_count;
     // -------------------------------------------------------------------------------------
     auto write_ptr = col_struct.data;
     // -------------------------------------------------------------------------------------
@@ -56,7 +63,7 @@ class TRLE {
     {
       u32 used_space;
       CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::compress(
-          rle_values.data(), nullptr, write_ptr, rle_values.size(), allowed_cascading_level - 1,
+          rle_values, nullptr, write_ptr, runs_count, allowed_cascading_level - 1,
           used_space, col_struct.values_scheme_code, autoScheme(), "values");
       write_ptr += used_space;
       // -------------------------------------------------------------------------------------
@@ -69,7 +76,7 @@ class TRLE {
     {
       col_struct.runs_count_offset = write_ptr - col_struct.data;
       u32 used_space;
-      IntegerSchemePicker::compress(rle_count.data(), nullptr, write_ptr, rle_count.size(),
+      IntegerSchemePicker::compress(rle_count, nullptr, write_ptr, runs_count,
                                     allowed_cascading_level - 1, used_space,
                                     col_struct.counts_scheme_code, force_counts, "counts");
       write_ptr += used_space;
@@ -127,6 +134,136 @@ class TRLE {
     return col_struct.runs_count;
   }
   // -------------------------------------------------------------------------------------
+  // Binary search over the prefix sums of the run lengths, only the value of
+  // the hit run is decoded
+  static inline NumberType lookupRow(const u8* src, u32 row, u32, u32 level) {
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& counts_scheme =
+        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
+    counts_scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
+                             col_struct.runs_count, level + 1);
+    std::partial_sum(counts, counts + col_struct.runs_count, counts);
+    // The first run that ends behind row
+    const INTEGER target = row;
+    u32 run_i = std::upper_bound(counts, counts + col_struct.runs_count, target) - counts;
+    // -------------------------------------------------------------------------------------
+    auto& value_scheme =
+        TypeWrapper<SchemeType, SchemeCodeType>::getScheme(col_struct.values_scheme_code);
+    return value_scheme.lookup(col_struct.data, run_i, col_struct.runs_count, level + 1);
+  }
+  // -------------------------------------------------------------------------------------
+  // Walks the runs along the ascending selection instead of expanding them
+  static inline void decompressSelectedColumn(NumberType* dest,
+                                              const u32* selection,
+                                              u32 count,
+                                              const u8* src,
+                                              u32 tuple_count,
+                                              u32 level) {
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    if (count == 0) {
+      return;
+    }
+    thread_local std::vector<std::vector<NumberType>> values_v;
+    auto values =
+        get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    decompressRuns(values, counts, nullptr, src, tuple_count, level);
+    // -------------------------------------------------------------------------------------
+    u32 run_i = 0;
+    u32 run_end = counts[0];
+    for (u32 i = 0; i < count; i++) {
+      while (selection[i] >= run_end) {
+        run_end += counts[++run_i];
+      }
+      dest[i] = values[run_i];
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Evaluates the predicate once per run and fills whole ranges of result.
+  // Integer run values are scanned in their own (compressed) scheme.
+  static inline void scanColumn(const TPredicate<NumberType>& predicate,
+                                BITMAP* result,
+                                const u8* src,
+                                u32,
+                                u32 level) {
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<BITMAP>> run_matches_v;
+    auto run_matches = get_level_data(run_matches_v, col_struct.runs_count, level);
+    auto& value_scheme =
+        TypeWrapper<SchemeType, SchemeCodeType>::getScheme(col_struct.values_scheme_code);
+    if constexpr (std::is_same_v<SchemeType, IntegerScheme>) {
+      value_scheme.scan(predicate, run_matches, col_struct.data, col_struct.runs_count,
+                        level + 1);
+    } else {
+      thread_local std::vector<std::vector<NumberType>> values_v;
+      auto values =
+          get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+      value_scheme.decompress(values, nullptr, col_struct.data, col_struct.runs_count, level + 1);
+      predicate.evaluate(values, col_struct.runs_count, run_matches);
+    }
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& counts_scheme =
+        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
+    counts_scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
+                             col_struct.runs_count, level + 1);
+    // -------------------------------------------------------------------------------------
+    auto write_ptr = result;
+    for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
+      std::memset(write_ptr, run_matches[run_i], counts[run_i]);
+      write_ptr += counts[run_i];
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Aggregates value x run length without expanding the runs. compressColumn
+  // folds null rows into the preceding run, so they are taken out again with
+  // the nullmap.
+  static inline TAggregate<NumberType> aggregateColumn(BitmapWrapper* nullmap,
+                                                       const u8* src,
+                                                       u32 tuple_count,
+                                                       u32 level) {
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    TAggregate<NumberType> aggregate;
+    if (nullmap != nullptr && nullmap->type() == BitmapType::ALLZEROS) {
+      return aggregate;
+    }
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<NumberType>> values_v;
+    auto values =
+        get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    u32 runs_count = decompressRuns(values, counts, nullptr, src, tuple_count, level);
+    // -------------------------------------------------------------------------------------
+    if (nullmap == nullptr || nullmap->type() == BitmapType::ALLONES) {
+      for (u32 run_i = 0; run_i < runs_count; run_i++) {
+        aggregate.add(values[run_i], counts[run_i]);
+      }
+      return aggregate;
+    }
+    thread_local std::vector<std::vector<BITMAP>> not_null_v;
+    auto not_null = get_level_data(not_null_v, tuple_count, level);
+    nullmap->writeBITMAP(not_null);
+    for (u32 run_i = 0; run_i < runs_count; run_i++) {
+      u32 non_null_count = 0;
+      for (INTEGER i = 0; i < counts[run_i]; i++) {
+        non_null_count += not_null[i];
+      }
+      not_null += counts[run_i];
+      aggregate.add(values[run_i], non_null_count);
+    }
+    return aggregate;
+  }
+  // -------------------------------------------------------------------------------------
 };
 
 template <>
@@ -248,4 +385,118 @@ inline void TRLE<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>::decompres
   }
 #endif
 }
+
+template <>
+inline void TRLE<FLOAT, FloatScheme, FloatStats, FloatSchemeType>::decompressColumn(
+    FLOAT* dest,
+    BitmapWrapper*,
+    const u8* src,
+    u32 tuple_count,
+    u32 level) {
+  static_assert(sizeof(*dest) == 4);
+
+  const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // Decompress values
+  thread_local std::vector<std::vector<FLOAT>> values_v;
+  auto values =
+      get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(FLOAT), level);
+  {
+    FloatScheme& scheme =
+        TypeWrapper<FloatScheme, FloatSchemeType>::getScheme(col_struct.values_scheme_code);
+    scheme.decompress(values, nullptr, col_struct.data, col_struct.runs_count, level + 1);
+  }
+  // -------------------------------------------------------------------------------------
+  // Decompress counts
+  thread_local std::vector<std::vector<INTEGER>> counts_v;
+  auto counts =
+      get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  {
+    IntegerScheme& scheme =
+        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
+    scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
+                      col_struct.runs_count, level + 1);
+  }
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = dest;
+#ifdef BTR_USE_SIMD
+  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
+    auto target_ptr = write_ptr + counts[run_i];
+
+    // set is a sequential operation
+    __m256 vec = _mm256_set1_ps(values[run_i]);
+    while (write_ptr < target_ptr) {
+      // store is performed in a single cycle
+      _mm256_storeu_ps(write_ptr, vec);
+      write_ptr += 8;
+    }
+    write_ptr = target_ptr;
+  }
+#else
+  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
+    auto val = values[run_i];
+    auto target_ptr = write_ptr + counts[run_i];
+    while (write_ptr != target_ptr) {
+      *write_ptr++ = val;
+    }
+  }
+#endif
+}
+
+template <>
+inline void TRLE<BIGINT, BigIntScheme, BigIntStats, BigIntSchemeType>::decompressColumn(
+    BIGINT* dest,
+    BitmapWrapper*,
+    const u8* src,
+    u32 tuple_count,
+    u32 level) {
+  static_assert(sizeof(*dest) == 8);
+
+  const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // Decompress values
+  thread_local std::vector<std::vector<BIGINT>> values_v;
+  auto values =
+      get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(BIGINT), level);
+  {
+    BigIntScheme& scheme =
+        TypeWrapper<BigIntScheme, BigIntSchemeType>::getScheme(col_struct.values_scheme_code);
+    scheme.decompress(values, nullptr, col_struct.data, col_struct.runs_count, level + 1);
+  }
+  // -------------------------------------------------------------------------------------
+  // Decompress counts
+  thread_local std::vector<std::vector<INTEGER>> counts_v;
+  auto counts =
+      get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  {
+    IntegerScheme& scheme =
+        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
+    scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
+                      col_struct.runs_count, level + 1);
+  }
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = dest;
+#ifdef BTR_USE_SIMD
+  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
+    auto target_ptr = write_ptr + counts[run_i];
+
+    // set is a sequential operation
+    __m256i vec = _mm256_set1_epi64x(values[run_i]);
+    while (write_ptr < target_ptr) {
+      // store is performed in a single cycle
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_ptr), vec);
+      write_ptr += 4;
+    }
+    write_ptr = target_ptr;
+  }
+#else
+  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
+    auto val = values[run_i];
+    auto target_ptr = write_ptr + counts[run_i];
+    while (write_ptr != target_ptr) {
+      *write_ptr++ = val;
+    }
+  }
+#endif
+}
 }  // namespace btrblocks
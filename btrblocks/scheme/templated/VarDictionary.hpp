@@ -14,11 +14,11 @@ struct VarDictionaryStructure {
 // -------------------------------------------------------------------------------------
 template <typename CodeType>
 inline double VDictExpectedCompressionRatio(StringStats& stats) {
-  if (stats.distinct_values.size() > (std::numeric_limits<CodeType>::max())) {
+  if (stats.unique_count > (std::numeric_limits<CodeType>::max())) {
     return 0;
   } else {
     u32 after_size = (stats.tuple_count * (sizeof(CodeType))) +
-                     (sizeof(StringArrayViewer::Slot) * (1 + stats.distinct_values.size())) +
+                     (sizeof(StringArrayViewer::Slot) * (1 + stats.unique_count)) +
                      sizeof(VarDictionaryStructure);
     after_size += stats.total_unique_length;
     return CD(stats.total_size) / CD(after_size);
@@ -32,14 +32,13 @@ inline u32 VDictCompressColumn(const StringArrayViewer src,
                                StringStats& stats) {
   // Layout: STRINGS | OFFSETS | CODES
   // -------------------------------------------------------------------------------------
+  stats.makeExact();
   die_if(stats.distinct_values.size() <= std::numeric_limits<CodeType>::max());
   // -------------------------------------------------------------------------------------
   auto& col_struct = *reinterpret_cast<VarDictionaryStructure*>(dest);
   col_struct.total_size = stats.total_size;
-  vector<str> distinct_values(stats.distinct_values.begin(), stats.distinct_values.end());
+  const auto& distinct_values = stats.distinct_values.sorted();
   // -------------------------------------------------------------------------------------
-  // set is assumed to be implemented as red-black tree with order preserving
-  // iterator
   auto dest_slot_ptr = reinterpret_cast<StringArrayViewer::Slot*>(col_struct.data);
   u8* str_write_ptr =
       col_struct.data + ((distinct_values.size() + 1) * sizeof(StringArrayViewer::Slot));
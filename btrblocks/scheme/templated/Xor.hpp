@@ -0,0 +1,241 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/BitStream.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Every value is XORed with its predecessor and only the bits between the
+// leading and trailing zeros of the result are stored (Chimp). The values are
+// split into streams of a fixed size that start from scratch, so that several
+// streams can be decoded side by side and a lookup decodes only one of them.
+struct XorStructure {
+  u32 stream_count;
+  u32 padding;
+  // -------------------------------------------------------------------------------------
+  u8 data[];  // word offset of every stream | bits of the streams as u64 words
+};
+// -------------------------------------------------------------------------------------
+namespace xor_stream {
+// Values per stream, the first value of a stream is stored as is
+const u32 stream_size = 512;
+// Streams decoded side by side, their dependency chains overlap
+const u32 decode_lanes = 4;
+// Flags of the four cases
+const u64 flag_same = 0;     // the XOR is 0
+const u64 flag_center = 1;   // 3 bits leading code, center length, the center
+const u64 flag_reuse = 2;    // leading zeros of the previous value, the bits after them
+const u64 flag_leading = 3;  // 3 bits leading code, the bits after the leading zeros
+// -------------------------------------------------------------------------------------
+// Leading zeros are rounded down to one of 8 values, so that 3 bits encode
+// them. With more trailing zeros than trailing_threshold only the center bits
+// are stored, its length takes center_bits.
+template <typename BitsType>
+struct Width;
+// -------------------------------------------------------------------------------------
+template <>
+struct Width<u64> {
+  static constexpr u32 trailing_threshold = 6;
+  static constexpr u32 center_bits = 6;
+  static constexpr u8 leading_values[] = {0, 8, 12, 16, 18, 20, 22, 24};
+  static constexpr u8 leading_codes[] = {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  };
+  static inline u32 leadingZeros(u64 bits) { return __builtin_clzll(bits); }
+  static inline u32 trailingZeros(u64 bits) { return __builtin_ctzll(bits); }
+};
+static_assert(sizeof(Width<u64>::leading_codes) == 65);
+// -------------------------------------------------------------------------------------
+template <>
+struct Width<u32> {
+  static constexpr u32 trailing_threshold = 5;
+  static constexpr u32 center_bits = 5;
+  static constexpr u8 leading_values[] = {0, 4, 8, 10, 12, 14, 16, 18};
+  static constexpr u8 leading_codes[] = {
+      0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+      6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  };
+  static inline u32 leadingZeros(u32 bits) { return __builtin_clz(bits); }
+  static inline u32 trailingZeros(u32 bits) { return __builtin_ctz(bits); }
+};
+static_assert(sizeof(Width<u32>::leading_codes) == 33);
+}  // namespace xor_stream
+// -------------------------------------------------------------------------------------
+// BitsType holds the bits of a NumberType, they are what is XORed
+template <typename NumberType, typename BitsType>
+class TXor {
+  static_assert(sizeof(NumberType) == sizeof(BitsType));
+  using Width = xor_stream::Width<BitsType>;
+  static constexpr u32 stream_size = xor_stream::stream_size;
+  static constexpr u32 decode_lanes = xor_stream::decode_lanes;
+  static constexpr u32 value_bits = sizeof(BitsType) * 8;
+  // the next value cannot reuse the leading zeros
+  static constexpr u32 no_leading = value_bits + 1;
+
+ public:
+  // -------------------------------------------------------------------------------------
+  static inline u32 compressColumn(const NumberType* src, u32 tuple_count, u8* dest) {
+    // Layout : Header | offsets | words
+    auto& col_struct = *reinterpret_cast<XorStructure*>(dest);
+    col_struct.stream_count = (tuple_count + stream_size - 1) / stream_size;
+    auto offsets = reinterpret_cast<u32*>(col_struct.data);
+    auto words = reinterpret_cast<u64*>(col_struct.data + wordsOffset(col_struct.stream_count));
+
+    u32 word_count = 0;
+    for (u32 stream_i = 0; stream_i < col_struct.stream_count; stream_i++) {
+      const u32 offset = stream_i * stream_size;
+      offsets[stream_i] = word_count;
+      BitWriter writer(words + word_count);
+      encodeStream(src + offset, std::min(stream_size, tuple_count - offset), writer);
+      word_count += writer.wordCount();
+    }
+
+    return reinterpret_cast<u8*>(words + word_count) - dest;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void decompressColumn(NumberType* dest, const u8* src, u32 tuple_count) {
+    const auto& col_struct = *reinterpret_cast<const XorStructure*>(src);
+    // Streams other than the last one are full, they are decoded decode_lanes at a time
+    const u32 full_streams = tuple_count / stream_size;
+    u32 stream_i = 0;
+    for (; stream_i + decode_lanes <= full_streams; stream_i += decode_lanes) {
+      StreamDecoder lanes[decode_lanes] = {
+          {streamWords(col_struct, stream_i + 0), dest + (stream_i + 0) * stream_size},
+          {streamWords(col_struct, stream_i + 1), dest + (stream_i + 1) * stream_size},
+          {streamWords(col_struct, stream_i + 2), dest + (stream_i + 2) * stream_size},
+          {streamWords(col_struct, stream_i + 3), dest + (stream_i + 3) * stream_size},
+      };
+      static_assert(decode_lanes == 4);
+      for (u32 row_i = 1; row_i < stream_size; row_i++) {
+        for (auto& lane : lanes) {
+          lane.next();
+        }
+      }
+    }
+    for (; stream_i < col_struct.stream_count; stream_i++) {
+      const u32 offset = stream_i * stream_size;
+      StreamDecoder decoder(streamWords(col_struct, stream_i), dest + offset);
+      const u32 count = std::min(stream_size, tuple_count - offset);
+      for (u32 row_i = 1; row_i < count; row_i++) {
+        decoder.next();
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline NumberType lookupRow(const u8* src, u32 row) {
+    const auto& col_struct = *reinterpret_cast<const XorStructure*>(src);
+    NumberType values[stream_size];
+    const u32 stream_i = row / stream_size;
+    StreamDecoder decoder(streamWords(col_struct, stream_i), values);
+    for (u32 row_i = stream_i * stream_size; row_i < row; row_i++) {
+      decoder.next();
+    }
+    return values[row % stream_size];
+  }
+  // -------------------------------------------------------------------------------------
+ private:
+  static inline BitsType toBits(NumberType value) {
+    BitsType bits;
+    std::memcpy(&bits, &value, sizeof(value));
+    return bits;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline NumberType fromBits(BitsType bits) {
+    NumberType value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+  // -------------------------------------------------------------------------------------
+  static void encodeStream(const NumberType* src, u32 count, BitWriter& writer) {
+    using namespace xor_stream;
+    BitsType previous = toBits(src[0]);
+    writer.write(previous, value_bits);
+    u32 previous_leading = no_leading;
+    for (u32 row_i = 1; row_i < count; row_i++) {
+      BitsType value = toBits(src[row_i]);
+      BitsType xored = value ^ previous;
+      previous = value;
+      if (xored == 0) {
+        writer.write(flag_same, 2);
+        previous_leading = no_leading;
+        continue;
+      }
+      u8 leading_code = Width::leading_codes[Width::leadingZeros(xored)];
+      u32 leading = Width::leading_values[leading_code];
+      u32 trailing = Width::trailingZeros(xored);
+      if (trailing > Width::trailing_threshold) {
+        u32 center = value_bits - leading - trailing;
+        writer.write(flag_center | (leading_code << 2) | (center << 5), 5 + Width::center_bits);
+        writer.write(xored >> trailing, center);
+        previous_leading = no_leading;
+      } else if (leading == previous_leading) {
+        writer.write(flag_reuse, 2);
+        writer.write(xored, value_bits - leading);
+      } else {
+        writer.write(flag_leading | (leading_code << 2), 5);
+        writer.write(xored, value_bits - leading);
+        previous_leading = leading;
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  class StreamDecoder {
+   public:
+    StreamDecoder(const u64* words, NumberType* dest) : reader(words), dest(dest) {
+      previous = reader.read(value_bits);
+      *this->dest++ = fromBits(previous);
+    }
+    inline void next() {
+      using namespace xor_stream;
+      BitsType xored = 0;
+      switch (reader.read(2)) {
+        case flag_same:
+          previous_leading = no_leading;
+          break;
+        case flag_center: {
+          u32 leading = Width::leading_values[reader.read(3)];
+          u32 center = reader.read(Width::center_bits);
+          xored = reader.read(center) << (value_bits - leading - center);
+          previous_leading = no_leading;
+          break;
+        }
+        case flag_reuse:
+          xored = reader.read(value_bits - previous_leading);
+          break;
+        default:
+          previous_leading = Width::leading_values[reader.read(3)];
+          xored = reader.read(value_bits - previous_leading);
+          break;
+      }
+      previous ^= xored;
+      *dest++ = fromBits(previous);
+    }
+
+   private:
+    BitReader reader;
+    NumberType* dest;
+    BitsType previous;
+    u32 previous_leading = no_leading;
+  };
+  // -------------------------------------------------------------------------------------
+  // The words start behind the offsets, aligned by 8
+  static inline u32 wordsOffset(u32 stream_count) {
+    return (stream_count * sizeof(u32) + sizeof(u64) - 1) & ~(sizeof(u64) - 1);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline const u64* streamWords(const XorStructure& col_struct, u32 stream_i) {
+    auto offsets = reinterpret_cast<const u32*>(col_struct.data);
+    auto words =
+        reinterpret_cast<const u64*>(col_struct.data + wordsOffset(col_struct.stream_count));
+    return words + offsets[stream_i];
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
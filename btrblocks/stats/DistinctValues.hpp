@@ -0,0 +1,101 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// The distinct values of a column and how often they occur. They are counted
+// with a flat open addressing table that lives in a per thread scratch buffer
+// and is compacted into entries afterwards. Values are compared by their bits,
+// so NaNs count as values and -0.0 differs from 0.0.
+// Iterating yields the entries in ascending order, they are only sorted on
+// first use; entries() gives them unordered without that cost.
+template <typename T>
+class DistinctValues {
+ public:
+  using Entry = std::pair<T, u32>;
+  // -------------------------------------------------------------------------------------
+  void count(const T* src, u32 tuple_count) {
+    u32 capacity = 16;
+    while (capacity < 2 * tuple_count) {
+      capacity *= 2;
+    }
+    const u32 shift = 64 - __builtin_ctz(capacity);
+    // -------------------------------------------------------------------------------------
+    thread_local vector<Key> keys;
+    thread_local vector<u32> counts;  // 0 = empty slot
+    if (counts.size() < capacity) {
+      keys.resize(capacity);
+      counts.resize(capacity, 0);
+    }
+    // -------------------------------------------------------------------------------------
+    const u32 mask = capacity - 1;
+    for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+      const Key key = toKey(src[row_i]);
+      u32 slot = (key * 0x9E3779B97F4A7C15ull) >> shift;
+      while (counts[slot] != 0 && keys[slot] != key) {
+        slot = (slot + 1) & mask;
+      }
+      keys[slot] = key;
+      counts[slot]++;
+    }
+    // -------------------------------------------------------------------------------------
+    // Compact and leave the scratch buffer empty for the next column
+    values.clear();
+    for (u32 slot = 0; slot < capacity; slot++) {
+      if (counts[slot] != 0) {
+        values.emplace_back(fromKey(keys[slot]), counts[slot]);
+        counts[slot] = 0;
+      }
+    }
+    is_sorted = false;
+  }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] inline u32 size() const { return values.size(); }
+  [[nodiscard]] inline bool empty() const { return values.empty(); }
+  [[nodiscard]] inline const vector<Entry>& entries() const { return values; }
+  [[nodiscard]] const vector<Entry>& sorted() {
+    if (!is_sorted) {
+      // NaNs go last, so that the order stays strict
+      std::sort(values.begin(), values.end(), [](const Entry& a, const Entry& b) {
+        return b.first != b.first ? a.first == a.first : a.first < b.first;
+      });
+      is_sorted = true;
+    }
+    return values;
+  }
+  inline typename vector<Entry>::const_iterator begin() { return sorted().begin(); }
+  inline typename vector<Entry>::const_iterator end() { return sorted().end(); }
+  // -------------------------------------------------------------------------------------
+  bool contains(T value) {
+    const Key key = toKey(value);
+    return std::any_of(values.begin(), values.end(),
+                       [&](const Entry& entry) { return toKey(entry.first) == key; });
+  }
+
+ private:
+  using Key = std::conditional_t<sizeof(T) == 8, u64, u32>;
+  static_assert(sizeof(T) == sizeof(Key));
+  // -------------------------------------------------------------------------------------
+  vector<Entry> values;
+  bool is_sorted = true;
+  // -------------------------------------------------------------------------------------
+  static inline Key toKey(T value) {
+    Key key;
+    std::memcpy(&key, &value, sizeof(Key));
+    return key;
+  }
+  static inline T fromKey(Key key) {
+    T value;
+    std::memcpy(&value, &key, sizeof(T));
+    return value;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
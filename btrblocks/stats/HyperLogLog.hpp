@@ -0,0 +1,65 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Estimates the number of distinct values with 2^PRECISION one byte
+// registers, the standard error is 1.04 / sqrt(2^PRECISION) ~ 1.6%. Small
+// counts are estimated by linear counting, which is close to exact for them.
+class HyperLogLog {
+ public:
+  static constexpr u32 PRECISION = 12;
+  static constexpr u32 REGISTER_COUNT = 1u << PRECISION;
+  // -------------------------------------------------------------------------------------
+  HyperLogLog() { registers.fill(0); }
+  // -------------------------------------------------------------------------------------
+  template <typename T>
+  inline void add(T value) {
+    static_assert(sizeof(T) <= sizeof(u64));
+    u64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    const u64 hash = mix(bits ^ 0x9E3779B97F4A7C15ull);
+    const u32 index = hash >> (64 - PRECISION);
+    const u64 rest = hash << PRECISION;
+    const u8 rank = rest == 0 ? 64 - PRECISION + 1 : __builtin_clzll(rest) + 1;
+    registers[index] = std::max(registers[index], rank);
+  }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] double estimate() const {
+    double sum = 0;
+    u32 zero_count = 0;
+    for (const u8 rank : registers) {
+      sum += std::ldexp(1.0, -rank);
+      zero_count += rank == 0;
+    }
+    const double m = REGISTER_COUNT;
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    const double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && zero_count > 0) {
+      return m * std::log(m / zero_count);
+    }
+    return raw;
+  }
+
+ private:
+  std::array<u8, REGISTER_COUNT> registers;
+  // -------------------------------------------------------------------------------------
+  // Finalizer of MurmurHash3
+  static inline u64 mix(u64 value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -1,11 +1,12 @@
 #pragma once
 // -------------------------------------------------------------------------------------
 #include "common/Units.hpp"
+#include "stats/DistinctValues.hpp"
+#include "stats/HyperLogLog.hpp"
+#include "stats/Sampling.hpp"
 // -------------------------------------------------------------------------------------
 #include <algorithm>
 #include <cmath>
-#include <map>
-#include <random>
 #include <set>
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
@@ -18,7 +19,7 @@ struct NumberStats {
   // -------------------------------------------------------------------------------------
   const T* src;
   const BITMAP* bitmap;
-  std::map<T, u32> distinct_values;
+  DistinctValues<T> distinct_values;
   T min;
   T max;
   NumberStats() = delete;
@@ -30,103 +31,140 @@ struct NumberStats {
   u32 set_count;
   u32 average_run_length;
   bool is_sorted;
+  // Approximate stats only estimate unique_count, average_run_length and
+  // is_sorted, and leave distinct_values empty. makeExact() has to be called
+  // before they are used for more than choosing a scheme.
+  bool is_exact = false;
   // -------------------------------------------------------------------------------------
+  // The rows Sampling picks for n samples of length values
   tuple<vector<T>, vector<BITMAP>> samples(u32 n, u32 length) {
-    // -------------------------------------------------------------------------------------
-    std::random_device rd;   // Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  // Standard mersenne_twister_engine seeded with
-                             // rd()
-    // -------------------------------------------------------------------------------------
-    // TODO : Construction Site !! need a better theory and algorithm for
-    // sampling Constraints: RLE(runs), nulls, uniqueness, naive approach to
-    // pick enough elements that approximate stratified sample run ~8 normal
-    // rounds, then check if the
     vector<T> compiled_values;
     vector<BITMAP> compiled_bitmap;
-    // -------------------------------------------------------------------------------------
-    if (tuple_count <= n * length) {
-      compiled_values.insert(compiled_values.end(), src, src + tuple_count);
-      if (bitmap != nullptr) {
-        compiled_bitmap.insert(compiled_bitmap.end(), bitmap, bitmap + tuple_count);
+    compiled_values.reserve(std::min(tuple_count, n * length));
+    compiled_bitmap.reserve(std::min(tuple_count, n * length));
+    for (const auto run : Sampling::runs(tuple_count, bitmap, n, length)) {
+      compiled_values.insert(compiled_values.end(), src + run.begin, src + run.begin + run.length);
+      if (bitmap == nullptr) {
+        compiled_bitmap.insert(compiled_bitmap.end(), run.length, 1);
       } else {
-        compiled_bitmap.insert(compiled_bitmap.end(), tuple_count, 1);
-      }
-    } else {
-      u32 separator =
-          tuple_count / n;  // how big is the slice of the input, of which we take a part....
-      u32 remainder = tuple_count % n;
-      for (u32 sample_i = 0; sample_i < n; sample_i++) {
-        u32 range_end = ((sample_i == n - 1) ? (separator + remainder) : separator) - length;
-        std::uniform_int_distribution<> dis(0, range_end);
-        u32 partition_begin = sample_i * separator + dis(gen);
-        // (sample_i * separator, (sample_i + 1 ) * separator) range to pick
-        // from
-        compiled_values.insert(compiled_values.end(), src + partition_begin,
-                               src + partition_begin + length);
-        if (bitmap == nullptr) {
-          compiled_bitmap.insert(compiled_bitmap.end(), length, 1);
-        } else {
-          compiled_bitmap.insert(compiled_bitmap.end(), bitmap + partition_begin,
-                                 bitmap + partition_begin + length);
-        }
+        compiled_bitmap.insert(compiled_bitmap.end(), bitmap + run.begin,
+                               bitmap + run.begin + run.length);
       }
     }
-
-    return std::make_tuple(compiled_values, compiled_bitmap);
+    return std::make_tuple(std::move(compiled_values), std::move(compiled_bitmap));
   }
   // -------------------------------------------------------------------------------------
   static NumberStats generateStats(const T* src, const BITMAP* nullmap, u32 tuple_count) {
     NumberStats stats(src, nullmap, tuple_count);
+    stats.computeBounds();
+    stats.makeExact();
+    return stats;
+  }
+  // -------------------------------------------------------------------------------------
+  // Counts distinct values with a HyperLogLog sketch and estimates runs and
+  // sortedness from sample_count samples of sample_size values
+  static NumberStats generateApproximateStats(const T* src,
+                                              const BITMAP* nullmap,
+                                              u32 tuple_count,
+                                              u32 sample_count,
+                                              u32 sample_size) {
+    NumberStats stats(src, nullmap, tuple_count);
+    stats.computeBounds();
+    if (tuple_count <= sample_count * sample_size) {
+      stats.makeExact();
+      return stats;
+    }
     // -------------------------------------------------------------------------------------
-    stats.tuple_count = tuple_count;
-    stats.total_size = tuple_count * sizeof(T);
-    stats.null_count = 0;
-    stats.average_run_length = 0;
-    stats.is_sorted = true;
-    // -------------------------------------------------------------------------------------
-    bool is_init_value_initialized = false;
+    HyperLogLog sketch;
+    for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+      sketch.add(src[row_i]);
+    }
+    stats.unique_count = std::clamp<u32>(std::llround(sketch.estimate()), 1, tuple_count);
     // -------------------------------------------------------------------------------------
+    // Runs of neighbouring rows, even if the schemes are estimated on single rows
+    u32 run_breaks = 0;
+    u32 neighbours = 0;
+    bool is_unsorted = false;
+    bool has_value = false;
+    T last_value{};
+    for (const auto run : Sampling::runs(tuple_count, nullmap, sample_count, sample_size, true)) {
+      for (u32 row_i = run.begin; row_i < run.begin + run.length; row_i++) {
+        if ((nullmap != nullptr && !nullmap[row_i]) || (has_value && src[row_i] == last_value)) {
+          continue;
+        }
+        // There is a gap between the runs
+        run_breaks += has_value && row_i != run.begin;
+        is_unsorted |= has_value && src[row_i] < last_value;
+        last_value = src[row_i];
+        has_value = true;
+      }
+      neighbours += run.length - 1;
+    }
+    const double breaks_per_tuple = CD(run_breaks) / CD(std::max<u32>(1, neighbours));
+    stats.average_run_length = CD(tuple_count) / (1 + breaks_per_tuple * (tuple_count - 1));
+    stats.is_sorted = !is_unsorted;
+    return stats;
+  }
+  // -------------------------------------------------------------------------------------
+  void makeExact() {
+    if (is_exact) {
+      return;
+    }
     // Let NULL_CODE (0) of null values also taken into stats consideration
     // -------------------------------------------------------------------------------------
-    T last_value;
     u32 run_count = 0;
-    // -------------------------------------------------------------------------------------
-    for (u64 row_i = 0; row_i < tuple_count; row_i++) {
-      if (!is_init_value_initialized) {
-        stats.min = stats.max = last_value = src[0];
-        is_init_value_initialized = true;
-      }
-      // -------------------------------------------------------------------------------------
-      auto current_value = src[row_i];
-      if (current_value != last_value && (nullmap == nullptr || nullmap[row_i])) {
-        if (current_value < last_value) {
-          stats.is_sorted = false;
+    bool is_unsorted = false;
+    if (tuple_count > 0) {
+      // Runs and sortedness only look at non-null values, the loops are
+      // branch free so that the compiler can vectorize them
+      if (bitmap == nullptr) {
+        for (u32 row_i = 1; row_i < tuple_count; row_i++) {
+          run_count += src[row_i] != src[row_i - 1];
+          is_unsorted |= src[row_i] < src[row_i - 1];
         }
-        last_value = current_value;
-        run_count++;
-      }
-      if (stats.distinct_values.find(current_value) == stats.distinct_values.end()) {
-        stats.distinct_values.insert({current_value, 1});
       } else {
-        stats.distinct_values[current_value]++;
-      }
-      if (current_value > stats.max) {
-        stats.max = current_value;
-      } else if (current_value < stats.min) {
-        stats.min = current_value;
-      }
-      if (nullmap != nullptr && !nullmap[row_i]) {
-        stats.null_count++;
-        continue;
+        T last_value = src[0];
+        for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+          const bool is_new_run = bitmap[row_i] && src[row_i] != last_value;
+          run_count += is_new_run;
+          is_unsorted |= is_new_run && src[row_i] < last_value;
+          last_value = is_new_run ? src[row_i] : last_value;
+        }
       }
     }
+    distinct_values.count(src, tuple_count);
     run_count++;
     // -------------------------------------------------------------------------------------
-    stats.average_run_length = CD(tuple_count) / CD(run_count);
-    stats.unique_count = stats.distinct_values.size();
-    stats.set_count = stats.tuple_count - stats.null_count;
-    // -------------------------------------------------------------------------------------
-    return stats;
+    average_run_length = CD(tuple_count) / CD(run_count);
+    is_sorted = !is_unsorted;
+    unique_count = distinct_values.size();
+    is_exact = true;
+  }
+  // Schemes only read the stats apart from makeExact() and the lazy sort of
+  // the distinct values. Sorting up front lets several schemes share exact
+  // stats, approximate ones can only be shared for estimating.
+  void makeShareable() { (void)distinct_values.sorted(); }
+
+ private:
+  // min, max and the null count are always exact
+  void computeBounds() {
+    total_size = tuple_count * sizeof(T);
+    null_count = 0;
+    if (tuple_count > 0) {
+      T min_value = src[0], max_value = src[0];
+      for (u32 row_i = 1; row_i < tuple_count; row_i++) {
+        min_value = std::min(min_value, src[row_i]);
+        max_value = std::max(max_value, src[row_i]);
+      }
+      min = min_value;
+      max = max_value;
+    }
+    if (bitmap != nullptr) {
+      for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+        null_count += !bitmap[row_i];
+      }
+    }
+    set_count = tuple_count - null_count;
   }
 };
 // -------------------------------------------------------------------------------------
@@ -0,0 +1,131 @@
+// -------------------------------------------------------------------------------------
+#include "Sampling.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "common/Exceptions.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Draws tried for a stratum before NULL_AWARE settles for the run with the
+// most values
+constexpr u32 NULL_AWARE_ATTEMPTS = 4;
+// -------------------------------------------------------------------------------------
+u32 countValues(const BITMAP* nullmap, u32 begin, u32 length) {
+  u32 count = 0;
+  for (u32 row_i = begin; row_i < begin + length; row_i++) {
+    count += nullmap[row_i] != 0;
+  }
+  return count;
+}
+// -------------------------------------------------------------------------------------
+vector<SampleRun> stratifiedRuns(SampleRandom& random,
+                                 bool null_aware,
+                                 u32 tuple_count,
+                                 const BITMAP* nullmap,
+                                 u32 sample_count,
+                                 u32 sample_size) {
+  vector<SampleRun> runs;
+  runs.reserve(sample_count);
+  // how big is the slice of the input, of which we take a part
+  const u32 separator = tuple_count / sample_count;
+  const u32 remainder = tuple_count % sample_count;
+  for (u32 sample_i = 0; sample_i < sample_count; sample_i++) {
+    const u32 stratum_size = separator + (sample_i == sample_count - 1 ? remainder : 0);
+    const u32 offsets = stratum_size - sample_size + 1;
+    u32 begin = sample_i * separator + random.below(offsets);
+    if (null_aware && nullmap != nullptr) {
+      u32 best_count = countValues(nullmap, begin, sample_size);
+      for (u32 attempt = 1; attempt < NULL_AWARE_ATTEMPTS && best_count < sample_size; attempt++) {
+        const u32 candidate = sample_i * separator + random.below(offsets);
+        const u32 count = countValues(nullmap, candidate, sample_size);
+        if (count > best_count) {
+          best_count = count;
+          begin = candidate;
+        }
+      }
+    }
+    runs.push_back({begin, sample_size});
+  }
+  return runs;
+}
+// -------------------------------------------------------------------------------------
+// Algorithm L: skips over the rows that do not make it into the reservoir, so
+// it needs random numbers in the order of the sample and not of the column
+vector<SampleRun> reservoirRows(SampleRandom& random, u32 tuple_count, u32 row_count) {
+  vector<u32> reservoir(row_count);
+  for (u32 row_i = 0; row_i < row_count; row_i++) {
+    reservoir[row_i] = row_i;
+  }
+  double w = std::exp(std::log(random.unit()) / row_count);
+  u64 row_i = row_count - 1;
+  while (true) {
+    const double skip = std::floor(std::log(random.unit()) / std::log1p(-w));
+    row_i += static_cast<u64>(std::min(skip, CD(tuple_count))) + 1;
+    if (row_i >= tuple_count) {
+      break;
+    }
+    reservoir[random.below(row_count)] = row_i;
+    w *= std::exp(std::log(random.unit()) / row_count);
+  }
+  std::sort(reservoir.begin(), reservoir.end());
+  // -------------------------------------------------------------------------------------
+  vector<SampleRun> runs;
+  for (u32 row : reservoir) {
+    if (!runs.empty() && runs.back().begin + runs.back().length == row) {
+      runs.back().length++;
+    } else {
+      runs.push_back({row, 1});
+    }
+  }
+  return runs;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+vector<SampleRun> Sampling::runs(u32 tuple_count,
+                                 const BITMAP* nullmap,
+                                 u32 sample_count,
+                                 u32 sample_size,
+                                 bool keep_runs) {
+  const auto& cfg = BtrBlocksConfig::get().sampling;
+  auto strategy = cfg.strategy;
+  if (keep_runs && strategy == SamplingStrategy::RESERVOIR) {
+    strategy = SamplingStrategy::STRATIFIED_RUNS;
+  }
+  return runs(strategy, cfg.seed, tuple_count, nullmap, sample_count, sample_size);
+}
+// -------------------------------------------------------------------------------------
+vector<SampleRun> Sampling::runs(SamplingStrategy strategy,
+                                 u64 seed,
+                                 u32 tuple_count,
+                                 const BITMAP* nullmap,
+                                 u32 sample_count,
+                                 u32 sample_size) {
+  if (tuple_count == 0) {
+    return {};
+  }
+  if (u64(sample_count) * sample_size >= tuple_count || sample_count == 0 || sample_size == 0) {
+    return {{0, tuple_count}};
+  }
+  // Columns of another length get other rows, seeds that differ in a few bits
+  // still give unrelated sequences
+  SampleRandom random(seed ^ ((u64(tuple_count) << 32) | (sample_count * 31 + sample_size)));
+  switch (strategy) {
+    case SamplingStrategy::STRATIFIED_RUNS:
+      return stratifiedRuns(random, false, tuple_count, nullmap, sample_count, sample_size);
+    case SamplingStrategy::NULL_AWARE:
+      return stratifiedRuns(random, true, tuple_count, nullmap, sample_count, sample_size);
+    case SamplingStrategy::RESERVOIR:
+      return reservoirRows(random, tuple_count, sample_count * sample_size);
+    default:
+      throw Generic_Exception("Unknown sampling strategy");
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// How the rows that schemes are estimated on are picked
+enum class SamplingStrategy : uint8_t {
+  STRATIFIED_RUNS,  // one run of sample_size rows at a random offset in each of sample_count strata
+  RESERVOIR,        // sample_count * sample_size single rows, uniform over the column
+  NULL_AWARE,       // like STRATIFIED_RUNS, but avoids runs of nulls if a stratum has values
+};
+// -------------------------------------------------------------------------------------
+// SplitMix64, a few instructions per number and good enough for picking rows
+class SampleRandom {
+ public:
+  explicit SampleRandom(u64 seed) : state(seed) {}
+  // -------------------------------------------------------------------------------------
+  inline u64 next() {
+    u64 z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+  // Uniform in [0, bound)
+  inline u32 below(u32 bound) { return (u64(u32(next())) * bound) >> 32; }
+  // Uniform in (0, 1)
+  inline double unit() { return (CD(next() >> 11) + 0.5) * 0x1.0p-53; }
+
+ private:
+  u64 state;
+};
+// -------------------------------------------------------------------------------------
+struct SampleRun {
+  u32 begin;
+  u32 length;
+};
+// -------------------------------------------------------------------------------------
+// Picks the rows of a column that a sample consists of. The rows only depend
+// on the strategy, the seed and the shape of the column, so the same input
+// always gives the same sample and with it the same compressed output.
+class Sampling {
+ public:
+  // Runs in ascending order, covering all rows if the column has no more than
+  // sample_count * sample_size of them. Uses BtrBlocksConfig::sampling, with
+  // keep_runs RESERVOIR falls back to STRATIFIED_RUNS for callers that
+  // compare neighbouring rows.
+  static vector<SampleRun> runs(u32 tuple_count,
+                                const BITMAP* nullmap,
+                                u32 sample_count,
+                                u32 sample_size,
+                                bool keep_runs = false);
+  static vector<SampleRun> runs(SamplingStrategy strategy,
+                                u64 seed,
+                                u32 tuple_count,
+                                const BITMAP* nullmap,
+                                u32 sample_count,
+                                u32 sample_size);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -1,7 +1,36 @@
 #include "StringStats.hpp"
 // -------------------------------------------------------------------------------------
+#include "stats/Sampling.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+// -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
+const vector<str>& StringDistinctValues::sorted() {
+  if (sorted_values.size() != values.size()) {
+    (void)sortedPositions();
+  }
+  return sorted_values;
+}
+// -------------------------------------------------------------------------------------
+const vector<u32>& StringDistinctValues::sortedPositions() {
+  if (sorted_positions.size() != values.size()) {
+    vector<u32> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](u32 a, u32 b) { return values[a] < values[b]; });
+    sorted_values.resize(values.size());
+    sorted_positions.resize(values.size());
+    for (u32 position = 0; position < order.size(); position++) {
+      sorted_values[position] = values[order[position]];
+      sorted_positions[order[position]] = position;
+    }
+  }
+  return sorted_positions;
+}
+// -------------------------------------------------------------------------------------
 StringStats StringStats::generateStats(const btrblocks::StringArrayViewer src,
                                        const BITMAP* nullmap,
                                        u32 tuple_count,
@@ -12,28 +41,136 @@ StringStats StringStats::generateStats(const btrblocks::StringArrayViewer src,
   // -------------------------------------------------------------------------------------
   stats.tuple_count = tuple_count;
   stats.total_size = column_data_size;
-  stats.total_length = 0;
-  stats.total_unique_length = 0;
-  stats.null_count = 0;
+  stats.src = src;
+  stats.nullmap = nullmap;
+  stats.makeExact();
+  return stats;
+}
+// -------------------------------------------------------------------------------------
+void StringStats::makeExact() {
+  if (is_exact) {
+    return;
+  }
   // -------------------------------------------------------------------------------------
-  for (u64 row_i = 0; row_i < tuple_count; row_i++) {
+  // Open addressing, a slot holds the id + 1 of its string, 0 if it is empty
+  u32 capacity = 16;
+  while (capacity < 2 * tuple_count) {
+    capacity *= 2;
+  }
+  const u32 shift = 64 - __builtin_ctz(capacity);
+  const u32 mask = capacity - 1;
+  thread_local vector<u32> table;
+  if (table.size() < capacity) {
+    table.resize(capacity);
+  }
+  std::fill_n(table.begin(), capacity, 0);
+  // -------------------------------------------------------------------------------------
+  auto& dv = distinct_values;
+  dv.values.clear();
+  dv.value_hashes.clear();
+  dv.sorted_values.clear();
+  dv.sorted_positions.clear();
+  dv.row_ids.resize(tuple_count);
+  total_length = 0;
+  total_unique_length = 0;
+  null_count = 0;
+  // -------------------------------------------------------------------------------------
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    str value;
     if (nullmap == nullptr || nullmap[row_i]) {
-      auto current_value = src(row_i);
-      if (stats.distinct_values.find(current_value) == stats.distinct_values.end()) {
-        stats.distinct_values.insert(current_value);
-        stats.total_unique_length += current_value.length();
+      value = src(row_i);
+      total_length += value.size();
+    } else {
+      null_count++;
+    }
+    const u64 hash = StringDistinctValues::hash(value);
+    u32 slot = hash >> shift;
+    while (true) {
+      const u32 entry = table[slot];
+      if (entry == 0) {
+        table[slot] = dv.values.size() + 1;
+        dv.row_ids[row_i] = dv.values.size();
+        dv.values.push_back(value);
+        dv.value_hashes.push_back(hash);
+        total_unique_length += value.size();
+        break;
+      }
+      if (dv.value_hashes[entry - 1] == hash && dv.values[entry - 1] == value) {
+        dv.row_ids[row_i] = entry - 1;
+        break;
       }
-      stats.total_length += current_value.size();
+      slot = (slot + 1) & mask;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  unique_count = dv.size();
+  set_count = tuple_count - null_count;
+  is_exact = true;
+}
+// -------------------------------------------------------------------------------------
+void StringStats::makeShareable() {
+  (void)distinct_values.sortedPositions();
+}
+// -------------------------------------------------------------------------------------
+StringStats StringStats::generateApproximateStats(const StringArrayViewer src,
+                                                  const BITMAP* nullmap,
+                                                  u32 tuple_count,
+                                                  SIZE column_data_size,
+                                                  u32 sample_count,
+                                                  u32 sample_size) {
+  if (sample_count == 0 || tuple_count <= sample_count * sample_size) {
+    return generateStats(src, nullmap, tuple_count, column_data_size);
+  }
+  StringStats stats;
+  stats.tuple_count = tuple_count;
+  stats.total_size = column_data_size;
+  stats.src = src;
+  stats.nullmap = nullmap;
+  stats.total_length = 0;
+  stats.null_count = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    if (nullmap == nullptr || nullmap[row_i]) {
+      stats.total_length += src.size(row_i);
     } else {
-      stats.distinct_values.insert("");
       stats.null_count++;
-      continue;
     }
   }
+  stats.set_count = tuple_count - stats.null_count;
+  // -------------------------------------------------------------------------------------
+  // The same rows the number columns are sampled on
+  std::unordered_map<str, u32> frequencies;
+  for (const auto run : Sampling::runs(tuple_count, nullmap, sample_count, sample_size)) {
+    for (u32 row_i = run.begin; row_i < run.begin + run.length; row_i++) {
+      if (nullmap == nullptr || nullmap[row_i]) {
+        frequencies[src(row_i)]++;
+      }
+    }
+  }
+  if (frequencies.size() <= 1) {
+    // A single value in the sample decides about ONE_VALUE, which must not be
+    // chosen on a guess
+    stats.makeExact();
+    return stats;
+  }
   // -------------------------------------------------------------------------------------
-  stats.unique_count = stats.distinct_values.size();
-  stats.set_count = stats.tuple_count - stats.null_count;
+  // Bias corrected Chao1 estimator: the ratio of values seen once to values
+  // seen twice in the sample estimates how many were not seen at all
+  u32 singletons = 0, doubletons = 0;
+  u64 sampled_unique_length = 0;
+  for (const auto& [value, frequency] : frequencies) {
+    singletons += frequency == 1;
+    doubletons += frequency == 2;
+    sampled_unique_length += value.size();
+  }
+  const double estimate =
+      frequencies.size() + CD(singletons) * (singletons - 1) / (2.0 * (doubletons + 1));
+  const u32 unique_non_null =
+      std::clamp<u64>(std::llround(estimate), frequencies.size(), stats.set_count);
+  stats.unique_count = unique_non_null + (stats.null_count > 0);
+  stats.total_unique_length =
+      CD(sampled_unique_length) / CD(frequencies.size()) * unique_non_null;
   return stats;
 }
 // -------------------------------------------------------------------------------------
-}  // namespace btrblocks
\ No newline at end of file
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -4,12 +4,79 @@
 // -------------------------------------------------------------------------------------
 #include "storage/StringArrayViewer.hpp"
 // -------------------------------------------------------------------------------------
-#include <set>
+#include <cstring>
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
+// The distinct strings of a column, collected with a flat hash set over a per
+// thread scratch table. Every distinct string gets an id in the order of its
+// first occurrence, and every row remembers the id of its string, so that a
+// dictionary can be built from the ids instead of looking the strings up
+// again. Iterating yields the strings in ascending order, they are only
+// sorted on first use.
+class StringDistinctValues {
+ public:
+  [[nodiscard]] inline u32 size() const { return values.size(); }
+  [[nodiscard]] inline bool empty() const { return values.empty(); }
+  // Indexed by id
+  [[nodiscard]] inline const vector<str>& entries() const { return values; }
+  [[nodiscard]] inline const vector<u64>& hashes() const { return value_hashes; }
+  // The id of the string of every row, null rows have the id of ""
+  [[nodiscard]] inline const vector<u32>& rowIds() const { return row_ids; }
+  // -------------------------------------------------------------------------------------
+  [[nodiscard]] const vector<str>& sorted();
+  // The position of every id in sorted()
+  [[nodiscard]] const vector<u32>& sortedPositions();
+  inline vector<str>::const_iterator begin() { return sorted().begin(); }
+  inline vector<str>::const_iterator end() { return sorted().end(); }
+  // -------------------------------------------------------------------------------------
+  static inline u64 hash(str value) {
+    // Strings up to 16 bytes, the common case, are loaded with two possibly
+    // overlapping words and without a loop
+    const auto data = reinterpret_cast<const u8*>(value.data());
+    const size_t length = value.size();
+    u64 a = 0, b = 0;
+    if (length >= 8) {
+      std::memcpy(&a, data, 8);
+      std::memcpy(&b, data + length - 8, 8);
+      for (size_t i = 8; i + 8 < length; i += 8) {
+        u64 word;
+        std::memcpy(&word, data + i, 8);
+        a = mix(a ^ word);
+      }
+    } else if (length >= 4) {
+      u32 low, high;
+      std::memcpy(&low, data, 4);
+      std::memcpy(&high, data + length - 4, 4);
+      a = low;
+      b = high;
+    } else if (length > 0) {
+      a = (u64(data[0]) << 16) | (u64(data[length / 2]) << 8) | data[length - 1];
+    }
+    return mix(a ^ mix(b ^ length ^ 0x9E3779B97F4A7C15ull));
+  }
+
+ private:
+  friend struct StringStats;
+  // -------------------------------------------------------------------------------------
+  vector<str> values;
+  vector<u64> value_hashes;
+  vector<u32> row_ids;
+  vector<str> sorted_values;
+  vector<u32> sorted_positions;
+  // -------------------------------------------------------------------------------------
+  static inline u64 mix(u64 value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+  }
+};
+// -------------------------------------------------------------------------------------
 struct StringStats {
-  std::set<str> distinct_values;
+  StringDistinctValues distinct_values;
   // -------------------------------------------------------------------------------------
   u32 total_size;           // everything in the column including slots
   u32 total_length;         // only string starting from slots end
@@ -20,10 +87,27 @@ struct StringStats {
   u32 unique_count;
   u32 set_count;
   // -------------------------------------------------------------------------------------
+  // Approximate stats estimate unique_count and total_unique_length from a
+  // sample and leave distinct_values empty. Schemes that need the distinct
+  // values call makeExact().
+  bool is_exact = false;
+  StringArrayViewer src{nullptr};
+  const BITMAP* nullmap = nullptr;
+  // -------------------------------------------------------------------------------------
   static StringStats generateStats(const StringArrayViewer src,
                                    const BITMAP* nullmap,
                                    u32 tuple_count,
                                    SIZE column_data_size);
+  static StringStats generateApproximateStats(const StringArrayViewer src,
+                                              const BITMAP* nullmap,
+                                              u32 tuple_count,
+                                              SIZE column_data_size,
+                                              u32 sample_count,
+                                              u32 sample_size);
+  void makeExact();
+  // Sorts the distinct values up front, after which schemes only read exact
+  // stats and several of them can share them
+  void makeShareable();
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks
@@ -75,6 +75,33 @@ bool Chunk::operator==(const btrblocks::Chunk& other) const {
             }
             break;
           }
+          case ColumnType::BIGINT: {
+            auto me = reinterpret_cast<BIGINT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<BIGINT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : BIGINT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << me << endl
+                   << they << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::FLOAT: {
+            auto me = reinterpret_cast<FLOAT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<FLOAT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << std::setprecision(30) << endl;
+              cerr << "== : FLOAT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << me << endl
+                   << they << endl;
+              return false;
+            }
+            break;
+          }
           case ColumnType::STRING: {
             auto me = this->operator()(column_i, row_i);
             auto they = other.operator()(column_i, row_i);
@@ -192,6 +219,40 @@ bool InputChunk::compareContents(u8* their_data,
       }
       break;
     }
+    case ColumnType::BIGINT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type BIGINT");
+      }
+
+      auto their_bigints = reinterpret_cast<BIGINT*>(their_data);
+      auto my_bigints = reinterpret_cast<BIGINT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->nullmap[idx] && my_bigints[idx] != their_bigints[idx]) {
+          std::cerr << "BigInt data is not equal at index " << idx
+                    << " Expected: " << my_bigints[idx] << " Got: " << their_bigints[idx]
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::FLOAT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type FLOAT");
+      }
+
+      auto their_floats = reinterpret_cast<FLOAT*>(their_data);
+      auto my_floats = reinterpret_cast<FLOAT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->nullmap[idx] && my_floats[idx] != their_floats[idx]) {
+          std::cerr << "Float data is not equal at index " << idx << std::setprecision(1000)
+                    << " Expected: " << my_floats[idx] << " Got: " << their_floats[idx]
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
     case ColumnType::STRING: {
       auto my_view = btrblocks::StringArrayViewer(this->data.get());
       for (u64 idx = 0; idx < their_tuple_count; idx++) {
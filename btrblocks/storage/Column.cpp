@@ -20,6 +20,12 @@ Column::Column(const ColumnType type,
     case ColumnType::STRING:
       data.emplace<2>(data_path.c_str());
       break;
+    case ColumnType::BIGINT:
+      data.emplace<3>(data_path.c_str());
+      break;
+    case ColumnType::FLOAT:
+      data.emplace<4>(data_path.c_str());
+      break;
     default:
       UNREACHABLE();
       break;
@@ -35,6 +41,10 @@ Column::Column(string name, Data&& data, Vector<BITMAP>&& bitmap)
           return ColumnType::DOUBLE;
         } else if (std::holds_alternative<Vector<str>>(d)) {
           return ColumnType::STRING;
+        } else if (std::holds_alternative<Vector<BIGINT>>(d)) {
+          return ColumnType::BIGINT;
+        } else if (std::holds_alternative<Vector<FLOAT>>(d)) {
+          return ColumnType::FLOAT;
         } else {
           UNREACHABLE();
         }
@@ -60,6 +70,14 @@ const Vector<str>& Column::strings() const {
   return std::get<2>(data);
 }
 // -------------------------------------------------------------------------------------
+const Vector<BIGINT>& Column::bigints() const {
+  return std::get<3>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<FLOAT>& Column::floats() const {
+  return std::get<4>(data);
+}
+// -------------------------------------------------------------------------------------
 const Vector<BITMAP>& Column::bitmaps() const {
   return bitmap;
 }
@@ -79,6 +97,12 @@ SIZE Column::sizeInBytes() const {
     case ColumnType::STRING:
       return strings().fileSize;
       break;
+    case ColumnType::BIGINT:
+      return bigints().size() * sizeof(BIGINT);
+      break;
+    case ColumnType::FLOAT:
+      return floats().size() * sizeof(FLOAT);
+      break;
     default:
       UNREACHABLE();
       break;
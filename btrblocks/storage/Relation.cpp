@@ -58,7 +58,7 @@ vector<tuple<u64, u64>> Relation::getRanges(btrblocks::SplitStrategy strategy,
   }
   // -------------------------------------------------------------------------------------
   if (strategy == SplitStrategy::RANDOM) {
-    std::shuffle(ranges.begin(), ranges.end(), std::mt19937(std::random_device()()));
+    std::shuffle(ranges.begin(), ranges.end(), std::mt19937_64(cfg.sampling.seed));
     cout << std::get<0>(ranges[0]) << endl;
   }
   // -------------------------------------------------------------------------------------
@@ -100,6 +100,20 @@ Chunk Relation::getChunk(const vector<btrblocks::Range>& ranges, SIZE chunk_i) c
                     chunk_tuple_count * sizeof(DOUBLE));
         break;
       }
+      case ColumnType::BIGINT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(BIGINT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()), columns[i].bigints().data + offset,
+                    chunk_tuple_count * sizeof(BIGINT));
+        break;
+      }
+      case ColumnType::FLOAT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(FLOAT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()), columns[i].floats().data + offset,
+                    chunk_tuple_count * sizeof(FLOAT));
+        break;
+      }
       case ColumnType::STRING: {
         const u64 slots_size = sizeof(StringArrayViewer::Slot) * (chunk_tuple_count + 1);
         // -------------------------------------------------------------------------------------
@@ -163,6 +177,20 @@ InputChunk Relation::getInputChunk(const Range& range,
                   chunk_tuple_count * sizeof(DOUBLE));
       break;
     }
+    case ColumnType::BIGINT: {
+      size = chunk_tuple_count * sizeof(BIGINT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].bigints().data + offset,
+                  chunk_tuple_count * sizeof(BIGINT));
+      break;
+    }
+    case ColumnType::FLOAT: {
+      size = chunk_tuple_count * sizeof(FLOAT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].floats().data + offset,
+                  chunk_tuple_count * sizeof(FLOAT));
+      break;
+    }
     case ColumnType::STRING: {
       const u64 slots_size = sizeof(StringArrayViewer::Slot) * (chunk_tuple_count + 1);
       // -------------------------------------------------------------------------------------
@@ -24,7 +24,9 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
 
    // vector of vector for each type
    vector<vector<s32>> integer_vectors;
+   vector<vector<s64>> bigint_vectors;
    vector<vector<double>> double_vectors;
+   vector<vector<float>> float_vectors;
    vector<vector<string>> string_vectors;
 
    if ( mkdir(out_dir.c_str(), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
@@ -45,10 +47,18 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
             type = ColumnType::INTEGER;
             integer_vectors.push_back({});
             vector_offset = integer_vectors.size() - 1;
-         } else if ( column_type == "double" || column_type == "float") {
+         } else if ( column_type == "bigint" ) {
+            type = ColumnType::BIGINT;
+            bigint_vectors.push_back({});
+            vector_offset = bigint_vectors.size() - 1;
+         } else if ( column_type == "double" ) {
             type = ColumnType::DOUBLE;
             double_vectors.push_back({});
             vector_offset = double_vectors.size() - 1;
+         } else if ( column_type == "float" ) {
+            type = ColumnType::FLOAT;
+            float_vectors.push_back({});
+            vector_offset = float_vectors.size() - 1;
          } else if ( column_type == "string" ) {
             type = ColumnType::STRING;
             string_vectors.push_back({});
@@ -108,6 +118,18 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                      column_descriptor.empty_count += (value == 0) ? 1 : 0;
                      break;
                   }
+                  case ColumnType::BIGINT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     const BIGINT value = (is_set ? std::stoll(column_str) : NULL_CODE);
+                     bigint_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
                   case ColumnType::DOUBLE: {
                      const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
                      column_descriptor.set_bitmap.push_back(is_set);
@@ -120,6 +142,18 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                      column_descriptor.empty_count += (value == 0) ? 1 : 0;
                      break;
                   }
+                  case ColumnType::FLOAT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     FLOAT value = (is_set ? std::stof(column_str) : static_cast<FLOAT>(NULL_CODE));
+                     float_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
                   case ColumnType::STRING: {
                      const bool is_set = (column_str == "null") ? 0 : 1;
                      column_descriptor.set_bitmap.push_back(is_set);
@@ -167,11 +201,22 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                writeBinary(output_column_file.c_str(), integer_vectors[column_descriptor.vector_offset]);
                break;
             }
+            case ColumnType::BIGINT: {
+               output_column_file += ".bigint";
+               die_if(bigint_vectors[column_descriptor.vector_offset].size() == column_descriptor.set_bitmap.size());
+               writeBinary(output_column_file.c_str(), bigint_vectors[column_descriptor.vector_offset]);
+               break;
+            }
             case ColumnType::DOUBLE: {
                output_column_file += ".double";
                writeBinary(output_column_file.c_str(), double_vectors[column_descriptor.vector_offset]);
                break;
             }
+            case ColumnType::FLOAT: {
+               output_column_file += ".float";
+               writeBinary(output_column_file.c_str(), float_vectors[column_descriptor.vector_offset]);
+               break;
+            }
             case ColumnType::STRING: {
                output_column_file += ".string";
                writeBinary(output_column_file.c_str(), string_vectors[column_descriptor.vector_offset]);
@@ -16,8 +16,6 @@ Relation readDirectory(const YAML::Node& schema, const string& columns_dir, cons
     auto column_type = column["type"].as<string>();
     if (column_type == "smallint") {
       column_type = "integer";
-    } else if (column_type == "float") {
-      column_type = "double";
     }
     // -------------------------------------------------------------------------------------
     if (only_type != "" && column_type != only_type) { continue; }
@@ -25,7 +23,8 @@ Relation readDirectory(const YAML::Node& schema, const string& columns_dir, cons
     const string column_file_prefix =
         columns_dir + std::to_string(column_i + 1) + "_" + column_name;
     const string column_file_path = column_file_prefix + "." + column_type;
-    if (column_type == "integer" || column_type == "double" || column_type == "string") {
+    if (column_type == "integer" || column_type == "bigint" || column_type == "double" ||
+        column_type == "float" || column_type == "string") {
       result.addColumn(column_file_path);
     }
   }
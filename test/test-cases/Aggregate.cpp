@@ -0,0 +1,173 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "compression/BtrReader.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/double/RLE.hpp"
+#include "scheme/integer/RLE.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+const u32 tuple_count = 10000;
+// -------------------------------------------------------------------------------------
+template<typename T>
+TAggregate<T> bruteForce(const vector<T> &values, const vector<BITMAP> &nullmap)
+{
+   TAggregate<T> aggregate;
+   for ( u32 row_i = 0; row_i < values.size(); row_i++ ) {
+      if ( nullmap[row_i] ) {
+         aggregate.add(values[row_i], 1);
+      }
+   }
+   return aggregate;
+}
+// -------------------------------------------------------------------------------------
+template<typename T>
+void expectEqual(const TAggregate<T> &actual, const TAggregate<T> &expected)
+{
+   EXPECT_EQ(actual.count, expected.count);
+   EXPECT_EQ(actual.sum, expected.sum);
+   if ( expected.count > 0 ) {
+      EXPECT_EQ(actual.min, expected.min);
+      EXPECT_EQ(actual.max, expected.max);
+   }
+}
+// -------------------------------------------------------------------------------------
+vector<BITMAP> nullRange(u32 begin, u32 end)
+{
+   vector<BITMAP> nullmap(tuple_count, 1);
+   std::fill(nullmap.begin() + begin, nullmap.begin() + end, 0);
+   return nullmap;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+TEST(Aggregate, IntegerRLE)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<INTEGER>((i / 250) % 7) * 1000 - 3000;
+   }
+   // The smallest value only occurs in rows that are null
+   values[1] = -100000;
+   for ( auto &nullmap : {vector<BITMAP>(tuple_count, 1), nullRange(1, 2), nullRange(300, 1800),
+                          nullRange(0, 500)} ) {
+      EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::RLE);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+      BtrReader reader(part.data());
+      auto meta = reader.getChunkMetadata(0);
+      ASSERT_EQ(meta->compression_type, CB(IntegerSchemeType::RLE));
+      auto &rle = dynamic_cast<integers::RLE &>(IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type));
+      expectEqual(rle.aggregate(reader.getBitmap(0), meta->data, meta->tuple_count, 0), bruteForce(values, nullmap));
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Aggregate, DoubleRLE)
+{
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<DOUBLE>((i / 100) % 13) * 0.5;
+   }
+   auto nullmap = nullRange(1000, 1234);
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::RLE);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE));
+   BtrReader reader(part.data());
+   auto meta = reader.getChunkMetadata(0);
+   ASSERT_EQ(meta->compression_type, CB(DoubleSchemeType::RLE));
+   auto &rle = dynamic_cast<doubles::RLE &>(DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type));
+   expectEqual(rle.aggregate(reader.getBitmap(0), meta->data, meta->tuple_count, 0), bruteForce(values, nullmap));
+   // -------------------------------------------------------------------------------------
+   vector<BITMAP> result(tuple_count);
+   for ( auto &predicate : {DoublePredicate::equal(2.5), DoublePredicate::less(1.0), DoublePredicate::between(0.5, 3.0)} ) {
+      rle.scan(predicate, result.data(), meta->data, meta->tuple_count, 0);
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         if ( nullmap[row_i] ) {
+            ASSERT_EQ(result[row_i], predicate.matches(values[row_i])) << "row " << row_i;
+         }
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Aggregate, Integer)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = ((i / 17) % 40) * 3 + (i % 5 == 0 ? 1000 : 0);
+   }
+   vector<INTEGER> frequent(tuple_count, 1000);
+   for ( u32 i = 0; i < tuple_count; i += 50 ) {
+      frequent[i] = -static_cast<INTEGER>(i % 97);
+   }
+   vector<INTEGER> one_value(tuple_count, -42);
+   BtrBlocksConfig::get().integers.schemes.enable(IntegerSchemeType::FREQUENCY);
+   SchemePool::refresh();
+   for ( auto &nullmap : {vector<BITMAP>(tuple_count, 1), nullRange(0, 500), nullRange(4000, 9000)} ) {
+      for ( auto scheme : {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::DICT, IntegerSchemeType::RLE,
+                           IntegerSchemeType::PFOR, IntegerSchemeType::BP, IntegerSchemeType::FREQUENCY,
+                           IntegerSchemeType::ONE_VALUE, IntegerSchemeType::DELTA,
+                           IntegerSchemeType::DELTA_OF_DELTA} ) {
+         auto &column = scheme == IntegerSchemeType::FREQUENCY ? frequent :
+                        scheme == IntegerSchemeType::ONE_VALUE ? one_value : values;
+         EnforceScheme<IntegerSchemeType> enforcer(scheme);
+         auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(column, nullmap, ColumnType::INTEGER));
+         BtrReader reader(part.data());
+         ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+         auto expected = bruteForce(column, nullmap);
+         expectEqual(reader.aggregateInteger(0), expected);
+         EXPECT_EQ(reader.aggregate(0, AggKind::SUM), static_cast<double>(expected.sum)) << ConvertSchemeTypeToString(scheme);
+         EXPECT_EQ(reader.aggregate(0, AggKind::COUNT), static_cast<double>(expected.count));
+         EXPECT_EQ(reader.aggregate(0, AggKind::MIN), expected.min);
+         EXPECT_EQ(reader.aggregate(0, AggKind::MAX), expected.max);
+      }
+   }
+   BtrBlocksConfig::get().integers.schemes = defaultIntegerSchemes();
+   SchemePool::refresh();
+}
+// -------------------------------------------------------------------------------------
+TEST(Aggregate, Double)
+{
+   // Multiples of 0.25 add up exactly in any order
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<DOUBLE>((i / 100) % 13) * 0.25 - 1.0;
+   }
+   vector<DOUBLE> frequent(tuple_count, 2.5);
+   for ( u32 i = 0; i < tuple_count; i += 50 ) {
+      frequent[i] = static_cast<DOUBLE>(i % 97) * -0.5;
+   }
+   for ( auto &nullmap : {vector<BITMAP>(tuple_count, 1), nullRange(0, 500), nullRange(4000, 9000)} ) {
+      for ( auto scheme : {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::DICT, DoubleSchemeType::RLE,
+                           DoubleSchemeType::PSEUDODECIMAL, DoubleSchemeType::ALP, DoubleSchemeType::XOR,
+                           DoubleSchemeType::FREQUENCY} ) {
+         auto &column = scheme == DoubleSchemeType::FREQUENCY ? frequent : values;
+         EnforceScheme<DoubleSchemeType> enforcer(scheme);
+         auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(column, nullmap, ColumnType::DOUBLE));
+         BtrReader reader(part.data());
+         ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+         expectEqual(reader.aggregateDouble(0), bruteForce(column, nullmap));
+      }
+   }
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::ONE_VALUE);
+   vector<DOUBLE> one_value(tuple_count, 0.75);
+   auto nullmap = nullRange(10, 20);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(one_value, nullmap, ColumnType::DOUBLE));
+   BtrReader reader(part.data());
+   expectEqual(reader.aggregateDouble(0), bruteForce(one_value, nullmap));
+   EXPECT_EQ(reader.aggregate(0, AggKind::SUM), 0.75 * (tuple_count - 10));
+}
+// -------------------------------------------------------------------------------------
+TEST(Aggregate, AllNull)
+{
+   vector<INTEGER> values(tuple_count, 7);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, vector<BITMAP>(tuple_count, 0), ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.aggregate(0, AggKind::COUNT), 0);
+   EXPECT_EQ(reader.aggregate(0, AggKind::SUM), 0);
+   EXPECT_TRUE(std::isnan(reader.aggregate(0, AggKind::MIN)));
+}
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,35 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/BitStream.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+TEST(BitStream, WordBoundary)
+{
+   // Writes that end exactly on a word must not touch the word behind it
+   for ( u32 bits : {64u, 32u, 16u, 1u} ) {
+      vector<u64> words(4, 0xAAAAAAAAAAAAAAAAull);
+      BitWriter writer(words.data());
+      for ( u32 bit_i = 0; bit_i < 128; bit_i += bits ) {
+         writer.write((bit_i / bits) & 1, bits);
+      }
+      ASSERT_EQ(writer.wordCount(), 2u) << bits;
+      EXPECT_EQ(words[2], 0xAAAAAAAAAAAAAAAAull) << bits;
+      BitReader reader(words.data());
+      for ( u32 bit_i = 0; bit_i < 128; bit_i += bits ) {
+         ASSERT_EQ(reader.read(bits), (bit_i / bits) & 1) << bits << " bit " << bit_i;
+      }
+   }
+   vector<u64> words(3, ~0ull);
+   BitWriter writer(words.data());
+   writer.write(5, 3);
+   writer.write(~0ull >> 3, 61);
+   writer.write(0, 7);
+   ASSERT_EQ(writer.wordCount(), 2u);
+   EXPECT_EQ(words[1], 0u);
+   EXPECT_EQ(words[2], ~0ull);
+}
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,401 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "compression/BtrReader.hpp"
+#include "scheme/SchemePool.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+const u32 tuple_count = 10000;
+// -------------------------------------------------------------------------------------
+vector<BITMAP> nullEvery(u32 n)
+{
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( u32 i = 0; i < tuple_count; i += n ) {
+      nullmap[i] = 0;
+   }
+   return nullmap;
+}
+// -------------------------------------------------------------------------------------
+vector<Predicate> integerPredicates()
+{
+   return {Predicate::equal(30), Predicate::equal(12345), Predicate::notEqual(30),
+           Predicate::less(40), Predicate::lessEqual(0), Predicate::greater(100),
+           Predicate::greaterEqual(-5), Predicate::between(10, 60),
+           Predicate::in({99, 3, 1000, 30, 3}), Predicate::isNull(), Predicate::isNotNull()};
+}
+// -------------------------------------------------------------------------------------
+void checkIntegerScan(const vector<INTEGER> &values, const vector<BITMAP> &nullmap, IntegerSchemeType scheme)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(scheme);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+   // -------------------------------------------------------------------------------------
+   vector<BITMAP> result;
+   for ( auto &predicate : integerPredicates()) {
+      reader.scanColumn(result, 0, predicate);
+      ASSERT_EQ(result.size(), values.size());
+      for ( u32 row_i = 0; row_i < values.size(); row_i++ ) {
+         bool expected;
+         if ( !nullmap[row_i] ) {
+            expected = predicate.type == PredicateType::IS_NULL;
+         } else {
+            expected = predicate.type == PredicateType::IS_NOT_NULL || predicate.matches(values[row_i]);
+         }
+         ASSERT_EQ(result[row_i], expected) << ConvertSchemeTypeToString(scheme) << " predicate " << CI(predicate.type) << " row " << row_i;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+vector<INTEGER> runs()
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = ((i / 17) % 40) * 3;
+   }
+   return values;
+}
+// -------------------------------------------------------------------------------------
+vector<StringPredicate> stringPredicates()
+{
+   return {StringPredicate::equal("v30"), StringPredicate::equal("v31"), StringPredicate::notEqual("v30"),
+           StringPredicate::less("v40"), StringPredicate::lessEqual("v0"), StringPredicate::greater("v100"),
+           StringPredicate::greaterEqual("v"), StringPredicate::between("v1", "v6"),
+           StringPredicate::in({"v99", "v3", "x", "v30", "v3"}), StringPredicate::isNull(),
+           StringPredicate::isNotNull(), StringPredicate::startsWith("v1"), StringPredicate::startsWith("v"),
+           StringPredicate::startsWith("v1000"), StringPredicate::like("v%0"), StringPredicate::like("%2%"),
+           StringPredicate::like("v_"), StringPredicate::like("_1_%"), StringPredicate::like("%")};
+}
+// -------------------------------------------------------------------------------------
+void checkStringScan(const vector<string> &values, const vector<BITMAP> &nullmap, StringSchemeType scheme)
+{
+   // Null rows are stored as empty strings, like the relation loader does it
+   vector<string> input = values;
+   for ( u32 row_i = 0; row_i < input.size(); row_i++ ) {
+      if ( !nullmap[row_i] ) {
+         input[row_i].clear();
+      }
+   }
+   EnforceScheme<StringSchemeType> enforcer(scheme);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(input, nullmap));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+   // -------------------------------------------------------------------------------------
+   vector<BITMAP> result;
+   for ( auto &predicate : stringPredicates()) {
+      reader.scanColumn(result, 0, predicate);
+      ASSERT_EQ(result.size(), values.size());
+      for ( u32 row_i = 0; row_i < values.size(); row_i++ ) {
+         bool expected;
+         if ( !nullmap[row_i] ) {
+            expected = predicate.type == PredicateType::IS_NULL;
+         } else {
+            expected = predicate.type == PredicateType::IS_NOT_NULL || predicate.matches(values[row_i]);
+         }
+         ASSERT_EQ(result[row_i], expected) << ConvertSchemeTypeToString(scheme) << " predicate " << CI(predicate.type) << " row " << row_i;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+vector<string> stringRuns()
+{
+   vector<string> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = "v" + std::to_string(((i / 17) % 40) * 3);
+   }
+   return values;
+}
+// -------------------------------------------------------------------------------------
+vector<string> stringCycle()
+{
+   vector<string> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = "v" + std::to_string((i * 7 % 40) * 3);
+   }
+   return values;
+}
+// -------------------------------------------------------------------------------------
+// A zone map may only rule out chunks in which no row qualifies
+template<typename T, typename ValueType>
+void checkZoneMap(BtrReader &reader, const vector<ValueType> &values, const vector<BITMAP> &nullmap, const vector<TPredicate<T>> &predicates)
+{
+   ASSERT_NE(reader.getZoneMap(0), nullptr);
+   for ( auto &predicate : predicates ) {
+      bool any_match = false;
+      for ( u32 row_i = 0; row_i < values.size(); row_i++ ) {
+         if ( !nullmap[row_i] ) {
+            any_match |= predicate.type == PredicateType::IS_NULL;
+         } else {
+            any_match |= predicate.type == PredicateType::IS_NOT_NULL || predicate.matches(values[row_i]);
+         }
+      }
+      if ( any_match ) {
+         ASSERT_TRUE(reader.mayMatch(0, predicate)) << "predicate " << CI(predicate.type);
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+TEST(Scan, Begin)
+{
+   BtrBlocksConfig::get().integers.schemes = defaultIntegerSchemes();
+   BtrBlocksConfig::get().integers.schemes.enable({IntegerSchemeType::FREQUENCY, IntegerSchemeType::PFOR_DELTA,
+                                                   IntegerSchemeType::DICTIONARY_8, IntegerSchemeType::DICTIONARY_16});
+   SchemePool::refresh();
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, Integer)
+{
+   for ( auto scheme : {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::DICT, IntegerSchemeType::RLE,
+                        IntegerSchemeType::PFOR, IntegerSchemeType::BP, IntegerSchemeType::DICTIONARY_8,
+                        IntegerSchemeType::DICTIONARY_16, IntegerSchemeType::DELTA,
+                        IntegerSchemeType::DELTA_OF_DELTA} ) {
+      checkIntegerScan(runs(), nullEvery(31), scheme);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, IntegerOneValue)
+{
+   checkIntegerScan(vector<INTEGER>(tuple_count, 30), nullEvery(7), IntegerSchemeType::ONE_VALUE);
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, IntegerFrequency)
+{
+   vector<INTEGER> values(tuple_count, 1000);
+   for ( u32 i = 0; i < tuple_count; i += 50 ) {
+      values[i] = i % 97;
+   }
+   checkIntegerScan(values, nullEvery(31), IntegerSchemeType::FREQUENCY);
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, IntegerDelta)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = i * 2;
+   }
+   checkIntegerScan(values, vector<BITMAP>(tuple_count, 1), IntegerSchemeType::PFOR_DELTA);
+   // Unsorted, with differences across the whole range
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = i % 100 == 0 ? (i % 200 == 0 ? std::numeric_limits<INTEGER>::min() : std::numeric_limits<INTEGER>::max()) : 1000 - 3 * i;
+   }
+   for ( auto scheme : {IntegerSchemeType::DELTA, IntegerSchemeType::DELTA_OF_DELTA} ) {
+      checkIntegerScan(values, nullEvery(31), scheme);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, String)
+{
+   for ( auto scheme : {StringSchemeType::UNCOMPRESSED, StringSchemeType::DICT, StringSchemeType::FSST} ) {
+      checkStringScan(stringCycle(), nullEvery(31), scheme);
+   }
+   // Long runs make the dictionary use RLE for its codes
+   checkStringScan(stringRuns(), nullEvery(31), StringSchemeType::DICT);
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, StringDictionaryFsst)
+{
+   SchemeConfig::get().strings.dict_force_fsst = true;
+   checkStringScan(stringCycle(), nullEvery(31), StringSchemeType::DICT);
+   checkStringScan(stringRuns(), nullEvery(31), StringSchemeType::DICT);
+   SchemeConfig::get().strings.dict_force_fsst = false;
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, StringLike)
+{
+   EXPECT_TRUE(matchesLike("", ""));
+   EXPECT_TRUE(matchesLike("", "%%"));
+   EXPECT_FALSE(matchesLike("", "_"));
+   EXPECT_TRUE(matchesLike("warning", "%n%g"));
+   EXPECT_TRUE(matchesLike("aab", "%ab"));
+   EXPECT_FALSE(matchesLike("abc", "a%b"));
+   EXPECT_TRUE(matchesLike("a%c", "a_c"));
+   // -------------------------------------------------------------------------------------
+   // Log lines, the matcher has to handle symbols that cover parts of the pattern
+   vector<string> lines(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      const string level = i % 7 == 0 ? "error" : (i % 3 == 0 ? "warning" : "info");
+      lines[i] = "12:00:" + std::to_string(i % 60) + " " + level + " request " + std::to_string(i * 31 % 1000) +
+                 " http://www.logger.org/" + std::to_string(i % 13);
+      if ( i % 101 == 0 ) {
+         lines[i] += '\x01';
+      }
+   }
+   vector<StringPredicate> predicates{StringPredicate::like("%error%"), StringPredicate::like("% warn%"),
+                                      StringPredicate::like("12:00:1_ %"), StringPredicate::like("%/1"),
+                                      StringPredicate::like("%request 9%www%"), StringPredicate::like("%\x01"),
+                                      StringPredicate::startsWith("12:00:5"), StringPredicate::startsWith("12:00:59 error"),
+                                      StringPredicate::equal(lines[42]), StringPredicate::equal("12:00:1")};
+   auto nullmap = nullEvery(31);
+   for ( bool force_fsst : {false, true} ) {
+      SchemeConfig::get().strings.dict_force_fsst = force_fsst;
+      for ( auto scheme : {StringSchemeType::FSST, StringSchemeType::DICT, StringSchemeType::UNCOMPRESSED} ) {
+         vector<string> input = lines;
+         if ( scheme == StringSchemeType::DICT ) {
+            for ( u32 i = 0; i < tuple_count; i++ ) {
+               input[i] = lines[i % 300];
+            }
+         }
+         for ( u32 i = 0; i < tuple_count; i += 31 ) {
+            input[i].clear();
+         }
+         EnforceScheme<StringSchemeType> enforcer(scheme);
+         auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(input, nullmap));
+         BtrReader reader(part.data());
+         ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+         vector<BITMAP> result;
+         for ( auto &predicate : predicates ) {
+            reader.scanColumn(result, 0, predicate);
+            for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+               ASSERT_EQ(result[row_i], nullmap[row_i] && predicate.matches(input[row_i]))
+                                 << ConvertSchemeTypeToString(scheme) << " " << predicate.lower << " row " << row_i;
+            }
+         }
+      }
+   }
+   SchemeConfig::get().strings.dict_force_fsst = false;
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, StringOneValue)
+{
+   checkStringScan(vector<string>(tuple_count, "v30"), vector<BITMAP>(tuple_count, 1), StringSchemeType::ONE_VALUE);
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, ZoneMap)
+{
+   vector<INTEGER> integers(tuple_count);
+   vector<DOUBLE> doubles(tuple_count);
+   vector<string> strings(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      integers[i] = 1000 + i % 1000;
+      doubles[i] = 0.25 * (i % 100);
+      strings[i] = "2023-05-" + std::to_string(10 + i % 20) + "T12:00";
+   }
+   auto nullmap = nullEvery(3);
+   // Null rows hold values outside of the bounds, they must not widen them
+   integers[0] = -5;
+   strings[0] = "1999";
+   {
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+      BtrReader reader(part.data());
+      checkZoneMap(reader, integers, nullmap, integerPredicates());
+      EXPECT_EQ(reader.getZoneMap(0)->null_count, 3334u);
+      EXPECT_FALSE(reader.mayMatch(0, Predicate::equal(-5)));
+      EXPECT_FALSE(reader.mayMatch(0, Predicate::less(1000)));
+      EXPECT_FALSE(reader.mayMatch(0, Predicate::greater(1999)));
+      EXPECT_FALSE(reader.mayMatch(0, Predicate::between(2000, 3000)));
+      EXPECT_FALSE(reader.mayMatch(0, Predicate::in({5, 2500})));
+      EXPECT_TRUE(reader.mayMatch(0, Predicate::in({5, 1500})));
+   }
+   {
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(doubles, nullmap, ColumnType::DOUBLE));
+      BtrReader reader(part.data());
+      checkZoneMap(reader, doubles, nullmap, vector<DoublePredicate>{DoublePredicate::equal(1.5), DoublePredicate::greater(24.0)});
+      EXPECT_FALSE(reader.mayMatch(0, DoublePredicate::greater(24.75)));
+      EXPECT_FALSE(reader.mayMatch(0, DoublePredicate::less(0)));
+   }
+   {
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(strings, nullmap));
+      BtrReader reader(part.data());
+      checkZoneMap(reader, strings, nullmap,
+                   vector<StringPredicate>{StringPredicate::equal("2023-05-10T12:00"), StringPredicate::greaterEqual("2023-05-29T12:00"),
+                                           StringPredicate::greater("2023-05-29"), StringPredicate::lessEqual("2023-05-10T12:00"),
+                                           StringPredicate::between("2023-05-20", "2023-05-21"), StringPredicate::isNull()});
+      EXPECT_FALSE(reader.mayMatch(0, StringPredicate::equal("1999")));
+      EXPECT_FALSE(reader.mayMatch(0, StringPredicate::greater("2023-06")));
+      EXPECT_FALSE(reader.mayMatch(0, StringPredicate::less("2023-05-")));
+      EXPECT_TRUE(reader.mayMatch(0, StringPredicate::startsWith("2023-05-2")));
+      EXPECT_FALSE(reader.mayMatch(0, StringPredicate::startsWith("2023-06")));
+      EXPECT_FALSE(reader.mayMatch(0, StringPredicate::startsWith("19")));
+   }
+   // Chunks written without a zone map have to be scanned
+   BtrBlocksConfig::get().zone_maps = false;
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+   BtrBlocksConfig::get().zone_maps = true;
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.getZoneMap(0), nullptr);
+   EXPECT_TRUE(reader.mayMatch(0, Predicate::equal(-5)));
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, BloomFilter)
+{
+   // High cardinality ids inside the bounds of the zone map, only the bloom
+   // filter can rule out the absent ones
+   vector<INTEGER> integers(tuple_count);
+   vector<DOUBLE> doubles(tuple_count);
+   vector<string> strings(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      integers[i] = 2 * i * 7919 % (2 * tuple_count);
+      doubles[i] = 0.5 * integers[i];
+      strings[i] = "user-" + std::to_string(integers[i] * 2654435761u);
+   }
+   auto nullmap = nullEvery(7);
+   BtrBlocksConfig::get().bloom_filters = true;
+   auto integer_part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+   auto double_part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(doubles, nullmap, ColumnType::DOUBLE));
+   auto string_part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(strings, nullmap));
+   BtrBlocksConfig::get().bloom_filters = false;
+   BtrReader integer_reader(integer_part.data());
+   BtrReader double_reader(double_part.data());
+   BtrReader string_reader(string_part.data());
+   ASSERT_TRUE(integer_reader.getBloomFilter(0).has_value());
+   ASSERT_TRUE(double_reader.getBloomFilter(0).has_value());
+   ASSERT_TRUE(string_reader.getBloomFilter(0).has_value());
+   // -------------------------------------------------------------------------------------
+   // No false negatives
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      if ( !nullmap[i] ) {
+         continue;
+      }
+      ASSERT_TRUE(integer_reader.mayMatch(0, Predicate::equal(integers[i]))) << i;
+      ASSERT_TRUE(double_reader.mayMatch(0, DoublePredicate::equal(doubles[i]))) << i;
+      ASSERT_TRUE(string_reader.mayMatch(0, StringPredicate::equal(strings[i]))) << i;
+   }
+   EXPECT_TRUE(integer_reader.mayMatch(0, Predicate::in({1, 3, integers[1]})));
+   EXPECT_TRUE(double_reader.mayContain(0, -0.0));
+   // -------------------------------------------------------------------------------------
+   // The odd numbers are absent, nearly all of them are ruled out
+   u32 integer_hits = 0, double_hits = 0, string_hits = 0;
+   for ( u32 i = 1; i < 2 * tuple_count; i += 2 ) {
+      integer_hits += integer_reader.mayMatch(0, Predicate::equal(i));
+      double_hits += double_reader.mayMatch(0, DoublePredicate::equal(0.5 * i));
+      string_hits += string_reader.mayMatch(0, StringPredicate::equal("user-" + std::to_string(i * 2654435761u)));
+   }
+   EXPECT_LT(integer_hits, tuple_count / 50);
+   EXPECT_LT(double_hits, tuple_count / 50);
+   EXPECT_LT(string_hits, tuple_count / 50);
+   EXPECT_FALSE(integer_reader.mayMatch(0, Predicate::in({1, 3, 5, 7})));
+   // -------------------------------------------------------------------------------------
+   // The chunk still decompresses and scans as usual
+   vector<u8> output;
+   integer_reader.readColumn(output, 0);
+   auto decompressed = reinterpret_cast<INTEGER *>(output.data());
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      if ( nullmap[i] ) {
+         ASSERT_EQ(decompressed[i], integers[i]) << i;
+      }
+   }
+   vector<BITMAP> result;
+   string_reader.scanColumn(result, 0, StringPredicate::equal(strings[1]));
+   EXPECT_EQ(std::count(result.begin(), result.end(), 1), 1);
+   // -------------------------------------------------------------------------------------
+   // Chunks written without one always may contain a value
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   EXPECT_FALSE(reader.getBloomFilter(0).has_value());
+   EXPECT_TRUE(reader.mayContain(0, 1));
+}
+// -------------------------------------------------------------------------------------
+TEST(Scan, End)
+{
+   BtrBlocksConfig::get().integers.schemes = defaultIntegerSchemes();
+   SchemePool::refresh();
+}
+// -------------------------------------------------------------------------------------
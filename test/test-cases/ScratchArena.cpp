@@ -0,0 +1,64 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "cache/ScratchArena.hpp"
+#include "cache/ThreadCache.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+TEST(ScratchArena, Scopes)
+{
+   ScratchArena arena;
+   u8 *outer;
+   {
+      ScratchArena::Scope scope(arena);
+      outer = arena.allocate<u8>(100);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(outer) % ScratchArena::ALIGNMENT, 0u);
+      u8 *inner;
+      {
+         ScratchArena::Scope inner_scope(arena);
+         inner = arena.allocate<u8>(100);
+         EXPECT_GE(inner, outer + 100);
+      }
+      // The inner scope gave its memory back
+      EXPECT_EQ(arena.allocate<u8>(100), inner);
+      // Too large for the first block
+      auto large = arena.allocate<INTEGER>(ScratchArena::MIN_BLOCK_SIZE);
+      large[ScratchArena::MIN_BLOCK_SIZE - 1] = 1;
+      EXPECT_EQ(arena.blockCount(), 2u);
+   }
+   {
+      ScratchArena::Scope scope(arena);
+      EXPECT_EQ(arena.allocate<u8>(100), outer);
+   }
+   EXPECT_EQ(arena.blockCount(), 2u);
+}
+// -------------------------------------------------------------------------------------
+TEST(ScratchArena, Compression)
+{
+   // After the first chunk the temporaries of the cascade fit into the arena
+   vector<DOUBLE> values(65536);
+   for ( u32 i = 0; i < values.size(); i++ ) {
+      values[i] = ((i / 20) % 1000) * 0.01;
+   }
+   vector<BITMAP> nullmap(values.size(), 1);
+   auto chunk = TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE);
+   Datablock::compress(chunk);
+   auto &arena = ThreadCache::get().arena;
+   const u64 capacity = arena.capacity();
+   EXPECT_GT(capacity, 0u);
+   for ( u32 rep = 0; rep < 3; rep++ ) {
+      auto part = TestHelper::CompressColumnPart(chunk);
+      BtrReader reader(part.data());
+      vector<u8> output;
+      reader.readColumn(output, 0);
+      auto decompressed = reinterpret_cast<DOUBLE *>(output.data());
+      for ( u32 i = 0; i < values.size(); i++ ) {
+         ASSERT_EQ(decompressed[i], values[i]) << i;
+      }
+   }
+   EXPECT_EQ(arena.capacity(), capacity);
+}
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,551 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "compression/BtrReader.hpp"
+#include "compression/SchemePicker.hpp"
+#include "extern/FastPFOR.hpp"
+#include "storage/StringArrayViewer.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <numeric>
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+const u32 tuple_count = 10000;
+// -------------------------------------------------------------------------------------
+vector<BITMAP> nullEvery(u32 n)
+{
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( u32 i = 0; i < tuple_count; i += n ) {
+      nullmap[i] = 0;
+   }
+   return nullmap;
+}
+// -------------------------------------------------------------------------------------
+// Sparse, dense, clustered, tail and empty selections. The tail only touches
+// the values behind the last full block of bit packing.
+vector<vector<u32>> selections()
+{
+   vector<vector<u32>> result(5);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i += 997 ) {
+      result[0].push_back(row_i);
+   }
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      if ( row_i % 3 != 1 ) {
+         result[1].push_back(row_i);
+      }
+   }
+   for ( u32 row_i = 4000; row_i < 4300; row_i++ ) {
+      result[2].push_back(row_i);
+   }
+   for ( u32 row_i = tuple_count - 10; row_i < tuple_count; row_i++ ) {
+      result[3].push_back(row_i);
+   }
+   return result;
+}
+// -------------------------------------------------------------------------------------
+template<typename T>
+void checkNumberSelection(const vector<T> &values, const vector<BITMAP> &nullmap, ColumnType type)
+{
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, type));
+   BtrReader reader(part.data());
+   vector<u8> output;
+   for ( auto &selection : selections()) {
+      reader.readColumnSelected(output, 0, selection);
+      auto selected = reinterpret_cast<const T *>(output.data());
+      for ( u32 i = 0; i < selection.size(); i++ ) {
+         if ( nullmap[selection[i]] ) {
+            ASSERT_EQ(selected[i], values[selection[i]]) << "row " << selection[i];
+         }
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+void checkStringSelection(const vector<string> &values, const vector<BITMAP> &nullmap, StringSchemeType scheme)
+{
+   vector<string> input = values;
+   for ( u32 row_i = 0; row_i < input.size(); row_i++ ) {
+      if ( !nullmap[row_i] ) {
+         input[row_i].clear();
+      }
+   }
+   EnforceScheme<StringSchemeType> enforcer(scheme);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(input, nullmap));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+   vector<u8> output;
+   for ( auto &selection : selections()) {
+      reader.readColumnSelected(output, 0, selection);
+      StringArrayViewer viewer(output.data());
+      for ( u32 i = 0; i < selection.size(); i++ ) {
+         ASSERT_EQ(viewer(i), input[selection[i]]) << ConvertSchemeTypeToString(scheme) << " row " << selection[i];
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+TEST(Selection, Integer)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = ((i / 17) % 40) * 3 + (i % 5 == 0 ? 1000 : 0);
+   }
+   for ( auto scheme : {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::DICT, IntegerSchemeType::RLE,
+                        IntegerSchemeType::PFOR, IntegerSchemeType::BP, IntegerSchemeType::DELTA,
+                        IntegerSchemeType::DELTA_OF_DELTA} ) {
+      EnforceScheme<IntegerSchemeType> enforcer(scheme);
+      checkNumberSelection(values, nullEvery(31), ColumnType::INTEGER);
+   }
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::ONE_VALUE);
+   checkNumberSelection(vector<INTEGER>(tuple_count, 42), nullEvery(7), ColumnType::INTEGER);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, ScanThenMaterialize)
+{
+   vector<INTEGER> keys(tuple_count);
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      keys[i] = (i / 50) % 20;
+      values[i] = i * 0.5;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto key_part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(keys, nullmap, ColumnType::INTEGER));
+   auto value_part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE));
+   BtrReader key_reader(key_part.data());
+   BtrReader value_reader(value_part.data());
+   // -------------------------------------------------------------------------------------
+   vector<BITMAP> matches;
+   key_reader.scanColumn(matches, 0, Predicate::equal(7));
+   auto selection = BtrReader::toSelection(matches);
+   ASSERT_EQ(selection.size(), tuple_count / 20);
+   vector<u8> output;
+   value_reader.readColumnSelected(output, 0, selection);
+   auto selected = reinterpret_cast<const DOUBLE *>(output.data());
+   for ( u32 i = 0; i < selection.size(); i++ ) {
+      ASSERT_EQ(keys[selection[i]], 7);
+      ASSERT_EQ(selected[i], values[selection[i]]);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, Double)
+{
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<DOUBLE>((i / 100) % 13) * 0.25;
+   }
+   for ( auto scheme : {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::DICT, DoubleSchemeType::RLE,
+                        DoubleSchemeType::PSEUDODECIMAL, DoubleSchemeType::ALP, DoubleSchemeType::XOR} ) {
+      EnforceScheme<DoubleSchemeType> enforcer(scheme);
+      checkNumberSelection(values, nullEvery(31), ColumnType::DOUBLE);
+   }
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::ONE_VALUE);
+   checkNumberSelection(vector<DOUBLE>(tuple_count, 0.5), nullEvery(7), ColumnType::DOUBLE);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, String)
+{
+   vector<string> cycle(tuple_count), runs(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      cycle[i] = "v" + std::to_string((i * 7 % 40) * 3);
+      runs[i] = "v" + std::to_string(((i / 17) % 40) * 3);
+   }
+   for ( auto scheme : {StringSchemeType::UNCOMPRESSED, StringSchemeType::DICT, StringSchemeType::FSST} ) {
+      checkStringSelection(cycle, nullEvery(31), scheme);
+   }
+   checkStringSelection(runs, nullEvery(31), StringSchemeType::DICT);
+   SchemeConfig::get().strings.dict_force_fsst = true;
+   checkStringSelection(cycle, nullEvery(31), StringSchemeType::DICT);
+   checkStringSelection(runs, nullEvery(31), StringSchemeType::DICT);
+   SchemeConfig::get().strings.dict_force_fsst = false;
+   checkStringSelection(vector<string>(tuple_count, "v30"), vector<BITMAP>(tuple_count, 1), StringSchemeType::ONE_VALUE);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, IntegerLookup)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = ((i / 17) % 40) * 3 + (i % 5 == 0 ? 1000 : 0);
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( auto scheme : {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::DICT, IntegerSchemeType::RLE,
+                        IntegerSchemeType::PFOR, IntegerSchemeType::BP, IntegerSchemeType::DELTA,
+                        IntegerSchemeType::DELTA_OF_DELTA} ) {
+      EnforceScheme<IntegerSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+      BtrReader reader(part.data());
+      for ( u32 row_i = 0; row_i < tuple_count; row_i += 7 ) {
+         ASSERT_EQ(reader.lookupInteger(0, row_i), values[row_i]) << ConvertSchemeTypeToString(scheme) << " row " << row_i;
+      }
+      ASSERT_EQ(reader.lookupInteger(0, tuple_count - 1), values.back());
+   }
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::ONE_VALUE);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(vector<INTEGER>(tuple_count, 42), nullmap, ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.lookupInteger(0, 1234), 42);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, IntegerLookupTail)
+{
+   // 1000 values end in a block of 3 mini blocks and 8 values after it
+   const u32 count = 1000;
+   vector<INTEGER> values(count);
+   for ( u32 i = 0; i < count; i++ ) {
+      values[i] = (i * 37) % 1000 + (i % 64 < 32 ? 0 : 5000);
+   }
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::BP);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, vector<BITMAP>(count, 1), ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(IntegerSchemeType::BP));
+   vector<u32> selection;
+   for ( u32 row_i = count / 128 * 128; row_i < count; row_i++ ) {
+      ASSERT_EQ(reader.lookupInteger(0, row_i), values[row_i]) << "row " << row_i;
+      selection.push_back(row_i);
+   }
+   vector<u8> output;
+   reader.readColumnSelected(output, 0, selection);
+   auto selected = reinterpret_cast<const INTEGER *>(output.data());
+   for ( u32 i = 0; i < selection.size(); i++ ) {
+      ASSERT_EQ(selected[i], values[selection[i]]) << "row " << selection[i];
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, DoubleLookup)
+{
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<DOUBLE>((i / 100) % 13) * 0.25;
+   }
+   // Pseudodecimal stores these as patches, Alp as exceptions
+   for ( u32 i = 3; i < tuple_count; i += 101 ) {
+      values[i] = 1.0 / 3.0 + i;
+   }
+   values[tuple_count - 2] = -0.0;
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( auto scheme : {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::DICT, DoubleSchemeType::RLE,
+                        DoubleSchemeType::PSEUDODECIMAL, DoubleSchemeType::ALP, DoubleSchemeType::XOR} ) {
+      EnforceScheme<DoubleSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE));
+      BtrReader reader(part.data());
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         ASSERT_EQ(reader.lookupDouble(0, row_i), values[row_i]) << ConvertSchemeTypeToString(scheme) << " row " << row_i;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, IntegerTimestamps)
+{
+   // Epoch seconds every minute with a few gaps
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = 1700000000 + i * 60 + (i / 1000) * 3600;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   auto scheme = static_cast<IntegerSchemeType>(reader.getChunkMetadata(0)->compression_type);
+   EXPECT_TRUE(scheme == IntegerSchemeType::DELTA || scheme == IntegerSchemeType::DELTA_OF_DELTA) << ConvertSchemeTypeToString(scheme);
+   EXPECT_LT(part.size() * 50, values.size() * sizeof(INTEGER));
+   vector<u8> output;
+   reader.readColumn(output, 0);
+   EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(INTEGER)), 0);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, BigInt)
+{
+   // Beyond 32 bits, with offsets from the minimum that still fit
+   vector<BIGINT> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = (BIGINT(1) << 40) + ((i / 17) % 40) * 3 + (i % 5 == 0 ? 1000 : 0);
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( auto scheme : {BigIntSchemeType::UNCOMPRESSED, BigIntSchemeType::DICT, BigIntSchemeType::RLE,
+                        BigIntSchemeType::FREQUENCY, BigIntSchemeType::FOR, BigIntSchemeType::BP,
+                        BigIntSchemeType::DELTA} ) {
+      {
+         EnforceScheme<BigIntSchemeType> enforcer(scheme);
+         checkNumberSelection(values, nullEvery(31), ColumnType::BIGINT);
+      }
+      // The override only holds for one compression
+      EnforceScheme<BigIntSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::BIGINT));
+      BtrReader reader(part.data());
+      EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+      for ( u32 row_i = 0; row_i < tuple_count; row_i += 7 ) {
+         ASSERT_EQ(reader.lookupBigInt(0, row_i), values[row_i]) << ConvertSchemeTypeToString(scheme) << " row " << row_i;
+      }
+      auto aggregate = reader.aggregateBigInt(0);
+      EXPECT_EQ(aggregate.count, tuple_count);
+      EXPECT_TRUE(aggregate.sum == std::accumulate(values.begin(), values.end(), __int128(0))) << ConvertSchemeTypeToString(scheme);
+      EXPECT_EQ(aggregate.min, *std::min_element(values.begin(), values.end()));
+      EXPECT_EQ(aggregate.max, *std::max_element(values.begin(), values.end()));
+   }
+   EnforceScheme<BigIntSchemeType> enforcer(BigIntSchemeType::ONE_VALUE);
+   checkNumberSelection(vector<BIGINT>(tuple_count, BIGINT(1) << 50), nullEvery(7), ColumnType::BIGINT);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, BigIntTimestamps)
+{
+   // Epoch nanoseconds every second with a few gaps, far outside of 32 bits
+   vector<BIGINT> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = 1700000000000000000 + (i + (i / 1000) * 60) * BIGINT(1000000000);
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::BIGINT));
+   BtrReader reader(part.data());
+   auto scheme = static_cast<BigIntSchemeType>(reader.getChunkMetadata(0)->compression_type);
+   EXPECT_EQ(scheme, BigIntSchemeType::DELTA) << ConvertSchemeTypeToString(scheme);
+   EXPECT_LT(part.size() * 50, values.size() * sizeof(BIGINT));
+   vector<u8> output;
+   reader.readColumn(output, 0);
+   EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(BIGINT)), 0);
+   EXPECT_EQ(reader.lookupBigInt(0, 4321), values[4321]);
+   EXPECT_TRUE(reader.mayContain(0, values[1234]));
+   EXPECT_FALSE(reader.mayMatch(0, BigIntPredicate::less(values.front())));
+   // The sum is far beyond 64 bits
+   const __int128 sum = std::accumulate(values.begin(), values.end(), __int128(0));
+   EXPECT_TRUE(reader.aggregateBigInt(0).sum == sum);
+   EXPECT_DOUBLE_EQ(reader.aggregate(0, AggKind::SUM), static_cast<double>(sum));
+   // Within a second, FOR keeps the offsets from a base that large
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = 1700000000000000000 + (i / 100) * 1000 + i % 7;
+   }
+   for ( auto scheme : {BigIntSchemeType::UNCOMPRESSED, BigIntSchemeType::DICT, BigIntSchemeType::RLE,
+                        BigIntSchemeType::FOR, BigIntSchemeType::DELTA} ) {
+      EnforceScheme<BigIntSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::BIGINT));
+      BtrReader reader(part.data());
+      EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+      auto aggregate = reader.aggregateBigInt(0);
+      EXPECT_EQ(aggregate.count, tuple_count);
+      EXPECT_TRUE(aggregate.sum == std::accumulate(values.begin(), values.end(), __int128(0))) << ConvertSchemeTypeToString(scheme);
+      EXPECT_EQ(aggregate.min, *std::min_element(values.begin(), values.end()));
+      EXPECT_EQ(aggregate.max, *std::max_element(values.begin(), values.end()));
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, DoubleAlpExceptions)
+{
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      // Prices with two decimals, the later vectors have four
+      values[i] = i < 5000 ? static_cast<DOUBLE>(i % 977) * 0.01 + 10 : static_cast<DOUBLE>(i % 9973) * 0.0001;
+   }
+   const DOUBLE specials[] = {-0.0, std::numeric_limits<DOUBLE>::quiet_NaN(), std::numeric_limits<DOUBLE>::infinity(),
+                              -std::numeric_limits<DOUBLE>::infinity(), 1e300, std::numeric_limits<DOUBLE>::denorm_min(),
+                              1.0 / 3.0, 3e9};
+   for ( u32 i = 0; i < sizeof(specials) / sizeof(DOUBLE); i++ ) {
+      values[i * 1237 + 5] = specials[i];
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::ALP);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE));
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(DoubleSchemeType::ALP));
+   vector<u8> output;
+   reader.readColumn(output, 0);
+   // Compare the bits, NaN is not equal to itself
+   EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(DOUBLE)), 0);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i += 3 ) {
+      DOUBLE value = reader.lookupDouble(0, row_i);
+      ASSERT_EQ(std::memcmp(&value, &values[row_i], sizeof(DOUBLE)), 0) << "row " << row_i;
+   }
+   for ( u32 i = 0; i < sizeof(specials) / sizeof(DOUBLE); i++ ) {
+      DOUBLE value = reader.lookupDouble(0, i * 1237 + 5);
+      ASSERT_EQ(std::memcmp(&value, &specials[i], sizeof(DOUBLE)), 0) << "special " << i;
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, DoubleXorTimeSeries)
+{
+   // Sensor readings, slowly changing and with float precision
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = static_cast<float>(20.0 + 5.0 * std::sin(i * 0.001) + (i % 7) * 1e-4);
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(DoubleSchemeType::XOR));
+   EXPECT_LT(part.size() * 3, values.size() * sizeof(DOUBLE) * 2);
+   vector<u8> output;
+   reader.readColumn(output, 0);
+   EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(DOUBLE)), 0);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i += 13 ) {
+      ASSERT_EQ(reader.lookupDouble(0, row_i), values[row_i]) << "row " << row_i;
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, Float)
+{
+   vector<FLOAT> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      // Every other run holds the same value, so that frequency encoding pays off
+      values[i] = (i / 17) % 2 == 0 ? 0.5f : static_cast<FLOAT>((i / 34) % 40) * 0.25f + 100.5f;
+   }
+   // Alp stores these as exceptions
+   for ( u32 i = 3; i < tuple_count; i += 101 ) {
+      values[i] = 1.0f / 3.0f + i;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( auto scheme : {FloatSchemeType::UNCOMPRESSED, FloatSchemeType::DICT, FloatSchemeType::RLE,
+                        FloatSchemeType::FREQUENCY, FloatSchemeType::ALP, FloatSchemeType::XOR} ) {
+      {
+         EnforceScheme<FloatSchemeType> enforcer(scheme);
+         checkNumberSelection(values, nullEvery(31), ColumnType::FLOAT);
+      }
+      // The override only holds for one compression
+      EnforceScheme<FloatSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::FLOAT));
+      BtrReader reader(part.data());
+      EXPECT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+      vector<u8> output;
+      reader.readColumn(output, 0);
+      EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(FLOAT)), 0) << ConvertSchemeTypeToString(scheme);
+      for ( u32 row_i = 0; row_i < tuple_count; row_i += 7 ) {
+         ASSERT_EQ(reader.lookupFloat(0, row_i), values[row_i]) << ConvertSchemeTypeToString(scheme) << " row " << row_i;
+      }
+      auto aggregate = reader.aggregateFloat(0);
+      EXPECT_EQ(aggregate.count, tuple_count);
+      EXPECT_EQ(aggregate.min, *std::min_element(values.begin(), values.end()));
+      EXPECT_EQ(aggregate.max, *std::max_element(values.begin(), values.end()));
+   }
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::ONE_VALUE);
+   checkNumberSelection(vector<FLOAT>(tuple_count, 0.5f), nullEvery(7), ColumnType::FLOAT);
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, FloatAlpExceptions)
+{
+   vector<FLOAT> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      // Prices with two decimals, rounded like a parser does
+      values[i] = static_cast<FLOAT>((i % 9973) * 0.01 + 10);
+   }
+   const FLOAT specials[] = {-0.0f, std::numeric_limits<FLOAT>::quiet_NaN(), std::numeric_limits<FLOAT>::infinity(),
+                             -std::numeric_limits<FLOAT>::infinity(), 1e30f, std::numeric_limits<FLOAT>::denorm_min(),
+                             1.0f / 3.0f, 3e9f};
+   for ( u32 i = 0; i < sizeof(specials) / sizeof(FLOAT); i++ ) {
+      values[i * 1237 + 5] = specials[i];
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::ALP);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::FLOAT));
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(FloatSchemeType::ALP));
+   EXPECT_LT(part.size() * 2, values.size() * sizeof(FLOAT));
+   vector<u8> output;
+   reader.readColumn(output, 0);
+   // Compare the bits, NaN is not equal to itself
+   EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(FLOAT)), 0);
+   for ( u32 i = 0; i < sizeof(specials) / sizeof(FLOAT); i++ ) {
+      FLOAT value = reader.lookupFloat(0, i * 1237 + 5);
+      ASSERT_EQ(std::memcmp(&value, &specials[i], sizeof(FLOAT)), 0) << "special " << i;
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, IntegerDictionary)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = ((i / 17) % 40) * 3 - 60;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   vector<u8> dictionary;
+   vector<u32> codes;
+   BtrBlocksConfig::get().integers.schemes.enable({IntegerSchemeType::DICTIONARY_8, IntegerSchemeType::DICTIONARY_16});
+   SchemePool::refresh();
+   for ( auto scheme : {IntegerSchemeType::DICT, IntegerSchemeType::DICTIONARY_8, IntegerSchemeType::DICTIONARY_16} ) {
+      EnforceScheme<IntegerSchemeType> enforcer(scheme);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+      BtrReader reader(part.data());
+      ASSERT_EQ(reader.getChunkMetadata(0)->compression_type, CB(scheme));
+      ASSERT_EQ(reader.readDictionary(dictionary, codes, 0), 40u) << ConvertSchemeTypeToString(scheme);
+      ASSERT_EQ(codes.size(), tuple_count);
+      auto dict = reinterpret_cast<const INTEGER *>(dictionary.data());
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         ASSERT_EQ(dict[codes[row_i]], values[row_i]) << ConvertSchemeTypeToString(scheme) << " row " << row_i;
+      }
+   }
+   BtrBlocksConfig::get().integers.schemes = defaultIntegerSchemes();
+   SchemePool::refresh();
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::BP);
+   auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+   BtrReader reader(part.data());
+   EXPECT_EQ(reader.readDictionary(dictionary, codes, 0), 0u);
+   EXPECT_TRUE(codes.empty());
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, StringGroupBy)
+{
+   vector<string> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = "group" + std::to_string((i * 7 % 40) * 3);
+   }
+   std::map<string, u32> expected;
+   for ( auto &value : values ) {
+      expected[value]++;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   for ( bool force_fsst : {false, true} ) {
+      SchemeConfig::get().strings.dict_force_fsst = force_fsst;
+      EnforceScheme<StringSchemeType> enforcer(StringSchemeType::DICT);
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(values, nullmap));
+      BtrReader reader(part.data());
+      vector<u8> dictionary;
+      vector<u32> codes;
+      u32 dict_size = reader.readDictionary(dictionary, codes, 0);
+      ASSERT_EQ(dict_size, expected.size());
+      // Count per code, strings are only looked at for the groups
+      vector<u32> counts(dict_size, 0);
+      for ( auto code : codes ) {
+         counts[code]++;
+      }
+      StringArrayViewer viewer(dictionary.data());
+      std::map<string, u32> groups;
+      for ( u32 code = 0; code < dict_size; code++ ) {
+         groups[string(viewer(code))] = counts[code];
+      }
+      EXPECT_EQ(groups, expected) << "fsst " << force_fsst;
+   }
+   SchemeConfig::get().strings.dict_force_fsst = false;
+}
+// -------------------------------------------------------------------------------------
+TEST(Selection, FastBinaryPackingTail)
+{
+   // The last block of bit packing may hold less than 4 mini blocks and the
+   // values behind the last multiple of 32 are stored with VariableByte
+   for ( u32 count : {100u, 1000u, 4113u} ) {
+      vector<u32> values(count);
+      for ( u32 i = 0; i < count; i++ ) {
+         values[i] = (i * 37) % 1000 + (i % 64 < 32 ? 0 : 5000);
+      }
+      FBPImpl codec;
+      vector<u32> encoded(count + 1024);
+      size_t u32_count = encoded.size();
+      codec.compress(values.data(), count, encoded.data(), u32_count);
+      vector<u32> all(count), tail;
+      std::iota(all.begin(), all.end(), 0);
+      for ( u32 row_i = count - 10; row_i < count; row_i++ ) {
+         tail.push_back(row_i);
+      }
+      for ( auto &selection : {all, tail} ) {
+         vector<u32> selected(selection.size());
+         codec.decompressSelected(encoded.data(), u32_count, selection.data(), selection.size(), selected.data());
+         for ( u32 i = 0; i < selection.size(); i++ ) {
+            ASSERT_EQ(selected[i], values[selection[i]]) << "count " << count << " row " << selection[i];
+         }
+      }
+      for ( u32 row_i = 0; row_i < count; row_i++ ) {
+         u32 value;
+         codec.decompressSelected(encoded.data(), u32_count, &row_i, 1, &value);
+         ASSERT_EQ(value, values[row_i]) << "count " << count << " row " << row_i;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,523 @@
+// -------------------------------------------------------------------------------------
+#include "TestHelper.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "compression/BtrReader.hpp"
+#include "compression/CompressionBudget.hpp"
+#include "compression/Metrics.hpp"
+#include "compression/ParallelTrials.hpp"
+#include "compression/SchemeDecisionCache.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeCost.hpp"
+#include "storage/StringPointerArrayViewer.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+const u32 tuple_count = 10000;
+// -------------------------------------------------------------------------------------
+// What the stats used to compute with a std::map, row by row
+template<typename T>
+void checkStats(const vector<T> &values, const BITMAP *nullmap)
+{
+   auto stats = NumberStats<T>::generateStats(values.data(), nullmap, values.size());
+   std::map<T, u32> distinct_values;
+   T min = values[0], max = values[0], last_value = values[0];
+   u32 null_count = 0, run_count = 1;
+   bool is_sorted = true;
+   for ( u32 row_i = 0; row_i < values.size(); row_i++ ) {
+      const T value = values[row_i];
+      distinct_values[value]++;
+      min = std::min(min, value);
+      max = std::max(max, value);
+      if ( nullmap != nullptr && !nullmap[row_i] ) {
+         null_count++;
+      } else if ( value != last_value ) {
+         is_sorted &= value > last_value;
+         last_value = value;
+         run_count++;
+      }
+   }
+   EXPECT_EQ(stats.min, min);
+   EXPECT_EQ(stats.max, max);
+   EXPECT_EQ(stats.null_count, null_count);
+   EXPECT_EQ(stats.set_count, values.size() - null_count);
+   EXPECT_EQ(stats.is_sorted, is_sorted);
+   EXPECT_EQ(stats.average_run_length, values.size() / run_count);
+   EXPECT_EQ(stats.unique_count, distinct_values.size());
+   ASSERT_EQ(stats.distinct_values.size(), distinct_values.size());
+   // Iteration is ordered
+   auto expected = distinct_values.begin();
+   for ( auto &[value, count] : stats.distinct_values ) {
+      EXPECT_EQ(value, expected->first);
+      EXPECT_EQ(count, expected->second);
+      expected++;
+   }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+TEST(Stats, Integer)
+{
+   vector<INTEGER> sorted(tuple_count), random(tuple_count), runs(tuple_count);
+   vector<BITMAP> nullmap(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      sorted[i] = i / 3;
+      random[i] = static_cast<INTEGER>(i * 2654435761u) >> 4;
+      runs[i] = (i / 100) % 7 - 3;
+      nullmap[i] = i % 5 != 0;
+   }
+   for ( auto *values : {&sorted, &random, &runs} ) {
+      checkStats(*values, nullptr);
+      checkStats(*values, nullmap.data());
+   }
+   checkStats(vector<INTEGER>(1, 42), nullptr);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, Double)
+{
+   vector<DOUBLE> values(tuple_count);
+   vector<BITMAP> nullmap(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = 0.25 * ((i * 7919) % 1000) - 10;
+      nullmap[i] = i % 3 != 0;
+   }
+   checkStats(values, nullptr);
+   checkStats(values, nullmap.data());
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, Unordered)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = i % 100;
+   }
+   auto stats = SInteger32Stats::generateStats(values.data(), nullptr, tuple_count);
+   u32 total = 0;
+   for ( auto &[value, count] : stats.distinct_values.entries() ) {
+      EXPECT_EQ(count, 100u) << value;
+      total += count;
+   }
+   EXPECT_EQ(total, tuple_count);
+   EXPECT_TRUE(stats.distinct_values.contains(99));
+   EXPECT_FALSE(stats.distinct_values.contains(100));
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, Approximate)
+{
+   vector<INTEGER> values(tuple_count * 6);
+   for ( u32 i = 0; i < values.size(); i++ ) {
+      values[i] = static_cast<INTEGER>((i / 4) * 2654435761u);
+   }
+   auto exact = SInteger32Stats::generateStats(values.data(), nullptr, values.size());
+   auto approximate = SInteger32Stats::generateApproximateStats(values.data(), nullptr, values.size(), 10, 64);
+   EXPECT_FALSE(approximate.is_exact);
+   EXPECT_TRUE(approximate.distinct_values.empty());
+   EXPECT_EQ(approximate.min, exact.min);
+   EXPECT_EQ(approximate.max, exact.max);
+   EXPECT_NEAR(approximate.unique_count, exact.unique_count, exact.unique_count * 0.05);
+   EXPECT_NEAR(approximate.average_run_length, exact.average_run_length, 1);
+   EXPECT_FALSE(approximate.is_sorted);
+   approximate.makeExact();
+   EXPECT_TRUE(approximate.is_exact);
+   EXPECT_EQ(approximate.unique_count, exact.unique_count);
+   EXPECT_EQ(approximate.average_run_length, exact.average_run_length);
+   EXPECT_EQ(approximate.distinct_values.size(), exact.distinct_values.size());
+   // Few distinct values are counted nearly exactly
+   vector<INTEGER> few(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      few[i] = i % 20;
+   }
+   EXPECT_EQ(SInteger32Stats::generateApproximateStats(few.data(), nullptr, tuple_count, 10, 64).unique_count, 20u);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, ApproximateCompression)
+{
+   // The chosen scheme still gets exact stats, so every column round trips
+   vector<vector<INTEGER>> columns(4, vector<INTEGER>(tuple_count * 6));
+   for ( u32 i = 0; i < columns[0].size(); i++ ) {
+      columns[0][i] = i;
+      columns[1][i] = (i * 2654435761u) % 5000;
+      columns[2][i] = (i / 50) % 3;
+      columns[3][i] = i % 40 == 0 ? i : 7;
+   }
+   vector<BITMAP> nullmap(columns[0].size(), 1);
+   BtrBlocksConfig::get().statistics = StatisticsMode::APPROXIMATE;
+   for ( auto &values : columns ) {
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+      BtrReader reader(part.data());
+      vector<u8> output;
+      reader.readColumn(output, 0);
+      auto decompressed = reinterpret_cast<INTEGER *>(output.data());
+      for ( u32 i = 0; i < values.size(); i++ ) {
+         ASSERT_EQ(decompressed[i], values[i]) << i;
+      }
+   }
+   BtrBlocksConfig::get().statistics = StatisticsMode::EXACT;
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, String)
+{
+   vector<string> values(tuple_count);
+   vector<BITMAP> nullmap(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = i % 7 == 0 ? "" : "customer#" + std::to_string((i * 7919) % 3000) + string(i % 13, 'x');
+      nullmap[i] = i % 11 != 0;
+   }
+   auto chunk = TestHelper::MakeStringInputChunk(values, nullmap);
+   const StringArrayViewer viewer(chunk.data.get());
+   auto stats = StringStats::generateStats(viewer, nullmap.data(), tuple_count, chunk.size);
+   // Null rows count as ""
+   std::set<str> distinct_values;
+   u32 total_length = 0, total_unique_length = 0;
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      const str value = nullmap[i] ? str(values[i]) : str();
+      total_length += value.size();
+      if ( distinct_values.insert(value).second ) {
+         total_unique_length += value.size();
+      }
+      ASSERT_EQ(stats.distinct_values.entries()[stats.distinct_values.rowIds()[i]], value) << i;
+   }
+   EXPECT_EQ(stats.unique_count, distinct_values.size());
+   EXPECT_EQ(stats.null_count, tuple_count / 11 + 1);
+   EXPECT_EQ(stats.total_length, total_length);
+   EXPECT_EQ(stats.total_unique_length, total_unique_length);
+   EXPECT_TRUE(std::equal(stats.distinct_values.begin(), stats.distinct_values.end(), distinct_values.begin(), distinct_values.end()));
+   auto &positions = stats.distinct_values.sortedPositions();
+   for ( u32 id = 0; id < stats.distinct_values.size(); id++ ) {
+      EXPECT_EQ(stats.distinct_values.sorted()[positions[id]], stats.distinct_values.entries()[id]);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, StringApproximate)
+{
+   vector<string> unique(tuple_count * 6), repeated(tuple_count * 6);
+   for ( u32 i = 0; i < unique.size(); i++ ) {
+      unique[i] = "id-" + std::to_string(i * 2654435761u);
+      repeated[i] = "city-" + std::to_string((i * 7919) % 100);
+   }
+   vector<BITMAP> nullmap(unique.size(), 1);
+   for ( auto *values : {&unique, &repeated} ) {
+      auto chunk = TestHelper::MakeStringInputChunk(*values, nullmap);
+      const StringArrayViewer viewer(chunk.data.get());
+      auto exact = StringStats::generateStats(viewer, nullmap.data(), values->size(), chunk.size);
+      auto approximate = StringStats::generateApproximateStats(viewer, nullmap.data(), values->size(), chunk.size, 10, 64);
+      EXPECT_FALSE(approximate.is_exact);
+      EXPECT_EQ(approximate.total_length, exact.total_length);
+      // Good enough to tell dictionary from FSST columns apart
+      EXPECT_GT(approximate.unique_count, exact.unique_count / 2);
+      EXPECT_LT(approximate.unique_count, exact.unique_count * 2);
+      approximate.makeExact();
+      EXPECT_EQ(approximate.unique_count, exact.unique_count);
+      EXPECT_EQ(approximate.total_unique_length, exact.total_unique_length);
+   }
+   // Every string scheme makes the stats exact when it needs them
+   BtrBlocksConfig::get().statistics = StatisticsMode::APPROXIMATE;
+   for ( auto *values : {&unique, &repeated} ) {
+      auto part = TestHelper::CompressColumnPart(TestHelper::MakeStringInputChunk(*values, nullmap));
+      BtrReader reader(part.data());
+      vector<u8> output;
+      const bool requires_copy = reader.readColumn(output, 0);
+      for ( u32 i = 0; i < values->size(); i++ ) {
+         const str value = requires_copy ? StringPointerArrayViewer(output.data())(i) : StringArrayViewer(output.data())(i);
+         ASSERT_EQ(value, (*values)[i]) << i;
+      }
+   }
+   BtrBlocksConfig::get().statistics = StatisticsMode::EXACT;
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, DecisionCache)
+{
+   // Stationary chunks reuse the cascade of the first one and still round trip,
+   // every column has its own cache
+   SchemeDecisionCache decisions, string_decisions;
+   vector<BITMAP> nullmap(tuple_count, 1);
+   vector<string> strings(tuple_count);
+   for ( u32 chunk_i = 0; chunk_i < 8; chunk_i++ ) {
+      vector<INTEGER> values(tuple_count);
+      for ( u32 i = 0; i < tuple_count; i++ ) {
+         values[i] = ((i + chunk_i) * 2654435761u) % 500 + (i / 10 == 7 ? 1000 : 0);
+         strings[i] = "city-" + std::to_string((i * 7919 + chunk_i) % 100);
+      }
+      vector<InputChunk> chunks;
+      chunks.push_back(TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER));
+      chunks.push_back(TestHelper::MakeStringInputChunk(strings, nullmap));
+      for ( auto &chunk : chunks ) {
+         vector<u8> part;
+         {
+            SchemeDecisionCache::Scope scope(chunk.type == ColumnType::STRING ? string_decisions : decisions);
+            part = TestHelper::CompressColumnPart(chunk);
+         }
+         BtrReader reader(part.data());
+         vector<u8> output;
+         const bool requires_copy = reader.readColumn(output, 0);
+         EXPECT_TRUE(chunk.compareContents(output.data(), nullmap, tuple_count, requires_copy)) << chunk_i;
+      }
+   }
+   EXPECT_EQ(SchemeDecisionCache::current(), nullptr);
+   EXPECT_GT(decisions.reusedCount(), 0u);
+   EXPECT_GT(string_decisions.reusedCount(), 0u);
+   const u64 estimated_count = decisions.estimatedCount();
+   // A chunk that looks different is estimated again
+   vector<INTEGER> sorted(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      sorted[i] = i;
+   }
+   {
+      SchemeDecisionCache::Scope scope(decisions);
+      TestHelper::CompressColumnPart(TestHelper::MakeInputChunk(sorted, nullmap, ColumnType::INTEGER));
+   }
+   EXPECT_GT(decisions.estimatedCount(), estimated_count);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, SelectionObjective)
+{
+   vector<INTEGER> values(tuple_count);
+   for ( u32 i = 0; i < tuple_count; i++ ) {
+      values[i] = (i / 50) % 3;
+   }
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto chunk = TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER);
+   auto schemeOf = [&]() {
+      return reinterpret_cast<ColumnChunkMeta *>(Datablock::compress(chunk).data())->compression_type;
+   };
+   const u8 best_ratio = schemeOf();
+   // Make the scheme with the best ratio too slow, the next best one is fast enough
+   auto &selection = BtrBlocksConfig::get().selection;
+   const double speed = SchemeCost::get().decompressionSpeed(ColumnType::INTEGER, best_ratio);
+   SchemeCost::get().setDecompressionSpeed(ColumnType::INTEGER, best_ratio, selection.min_decompression_speed / 2);
+   EXPECT_EQ(schemeOf(), best_ratio);
+   selection.objective = SelectionObjective::RATIO_AT_SPEED;
+   const u8 fast = schemeOf();
+   EXPECT_NE(fast, best_ratio);
+   EXPECT_GE(SchemeCost::get().decompressionSpeed(ColumnType::INTEGER, fast), selection.min_decompression_speed);
+   // Loading the compressed data takes no time, so the fastest scheme wins
+   selection.objective = SelectionObjective::MIN_READ_TIME;
+   selection.read_bandwidth = 1e9;
+   EXPECT_EQ(schemeOf(), CB(IntegerSchemeType::UNCOMPRESSED));
+   selection = decltype(BtrBlocksConfig::selection){};
+   SchemeCost::get().setDecompressionSpeed(ColumnType::INTEGER, best_ratio, speed);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, ParallelTrials)
+{
+   // Trying the schemes on several threads has to give the same bytes. SAMPLE
+   // only picks the same scheme as long as the sample is the whole chunk.
+   auto &cfg = BtrBlocksConfig::get();
+   for ( auto selection : {SchemeSelection::SAMPLE, SchemeSelection::TRY_ALL} ) {
+      cfg.scheme_selection = selection;
+      const u32 count = selection == SchemeSelection::SAMPLE ? cfg.sample_count * cfg.sample_size : tuple_count;
+      vector<INTEGER> integers(count);
+      vector<DOUBLE> doubles(count);
+      for ( u32 i = 0; i < count; i++ ) {
+         integers[i] = (i / 7) % 100 + (i % 3 == 0 ? 1000 : 0);
+         doubles[i] = ((i / 5) % 40) * 0.25;
+      }
+      vector<BITMAP> nullmap(count, 1);
+      nullmap[3] = 0;
+      vector<InputChunk> chunks;
+      chunks.push_back(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+      chunks.push_back(TestHelper::MakeInputChunk(doubles, nullmap, ColumnType::DOUBLE));
+      for ( auto &chunk : chunks ) {
+         cfg.trial_threads = 1;
+         auto serial = Datablock::compress(chunk);
+         cfg.trial_threads = 4;
+         auto parallel = Datablock::compress(chunk);
+         ASSERT_EQ(serial.size(), parallel.size());
+         EXPECT_EQ(std::memcmp(serial.data(), parallel.data(), serial.size()), 0);
+      }
+   }
+   cfg.trial_threads = 1;
+   cfg.scheme_selection = SchemeSelection::SAMPLE;
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, ParallelTrialsReuseThreads)
+{
+   // The helpers come from a pool, so their ThreadCache survives between calls
+   std::mutex mutex;
+   std::set<std::thread::id> thread_ids;
+   for ( u32 call_i = 0; call_i < 20; call_i++ ) {
+      runTrials(8, 4, [&](u32) {
+         std::lock_guard<std::mutex> guard(mutex);
+         thread_ids.insert(std::this_thread::get_id());
+      });
+   }
+   EXPECT_LE(thread_ids.size(), 4u);
+   EXPECT_THROW(runTrials(4, 4, [](u32 i) {
+      if ( i == 2 ) {
+         throw std::runtime_error("trial");
+      }
+   }), std::runtime_error);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, Sampling)
+{
+   const u32 sample_count = 10, sample_size = 64;
+   vector<BITMAP> nullmap(65536, 0);
+   for ( u32 row_i = 0; row_i < nullmap.size(); row_i++ ) {
+      nullmap[row_i] = (row_i / 64) % 4 == 0;
+   }
+   auto runs = [&](SamplingStrategy strategy, u64 seed) {
+      return Sampling::runs(strategy, seed, nullmap.size(), nullmap.data(), sample_count, sample_size);
+   };
+   auto rows = [](const vector<SampleRun> &runs) {
+      vector<u32> rows;
+      for ( auto run : runs ) {
+         for ( u32 row_i = run.begin; row_i < run.begin + run.length; row_i++ ) {
+            rows.push_back(row_i);
+         }
+      }
+      return rows;
+   };
+   auto valueCount = [&](const vector<SampleRun> &runs) {
+      u32 count = 0;
+      for ( u32 row_i : rows(runs) ) {
+         count += nullmap[row_i];
+      }
+      return count;
+   };
+   for ( auto strategy : {SamplingStrategy::STRATIFIED_RUNS, SamplingStrategy::RESERVOIR, SamplingStrategy::NULL_AWARE} ) {
+      // The same seed gives the same rows, another one other rows
+      EXPECT_EQ(rows(runs(strategy, 1)), rows(runs(strategy, 1)));
+      EXPECT_NE(rows(runs(strategy, 1)), rows(runs(strategy, 2)));
+      auto sampled = rows(runs(strategy, 1));
+      ASSERT_EQ(sampled.size(), sample_count * sample_size);
+      EXPECT_TRUE(std::is_sorted(sampled.begin(), sampled.end()));
+      EXPECT_EQ(std::adjacent_find(sampled.begin(), sampled.end()), sampled.end());
+      EXPECT_LT(sampled.back(), nullmap.size());
+   }
+   // One run in every stratum
+   auto stratified = runs(SamplingStrategy::STRATIFIED_RUNS, 1);
+   ASSERT_EQ(stratified.size(), sample_count);
+   for ( u32 sample_i = 0; sample_i < sample_count; sample_i++ ) {
+      EXPECT_EQ(stratified[sample_i].begin / (nullmap.size() / sample_count), sample_i);
+   }
+   EXPECT_GT(valueCount(runs(SamplingStrategy::NULL_AWARE, 1)), valueCount(stratified));
+   // Small columns are sampled completely
+   auto all = Sampling::runs(SamplingStrategy::RESERVOIR, 1, 500, nullptr, sample_count, sample_size);
+   ASSERT_EQ(all.size(), 1u);
+   EXPECT_EQ(all[0].length, 500u);
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, ReproducibleCompression)
+{
+   vector<INTEGER> values(65536);
+   for ( u32 i = 0; i < values.size(); i++ ) {
+      values[i] = (i * 7919) % 1000 + (i / 4096) * 5000;
+   }
+   vector<BITMAP> nullmap(values.size(), 1);
+   auto chunk = TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER);
+   EXPECT_EQ(Datablock::compress(chunk), Datablock::compress(chunk));
+   auto stats = SInteger32Stats::generateStats(values.data(), nullmap.data(), values.size());
+   EXPECT_EQ(std::get<0>(stats.samples(10, 64)), std::get<0>(stats.samples(10, 64)));
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, CompressionBudget)
+{
+   EXPECT_FALSE(CompressionBudget::isExhausted());
+   {
+      CompressionBudget::Scope budget(1);
+      CompressionBudget::Scope inner(1000000000);
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+      // The inner block shares the budget of the outer one
+      EXPECT_TRUE(CompressionBudget::isExhausted());
+   }
+   EXPECT_FALSE(CompressionBudget::isActive());
+   // Near unique doubles, Pseudodecimal tries every exponent on them
+   vector<DOUBLE> values(65536);
+   std::mt19937_64 gen(42);
+   std::uniform_real_distribution<DOUBLE> dis(0, 1);
+   for ( auto &value : values ) {
+      value = dis(gen);
+   }
+   vector<BITMAP> nullmap(values.size(), 1);
+   auto chunk = TestHelper::MakeInputChunk(values, nullmap, ColumnType::DOUBLE);
+   auto &cfg = BtrBlocksConfig::get();
+   for ( u32 budget : {0u, 1u} ) {
+      cfg.budget.block_microseconds = budget;
+      auto compressed = Datablock::compress(chunk);
+      if ( budget > 0 ) {
+         // Spent before the first estimate, only the fastest scheme is tried
+         EXPECT_EQ(reinterpret_cast<ColumnChunkMeta *>(compressed.data())->compression_type, CB(DoubleSchemeType::UNCOMPRESSED));
+      }
+      auto part = TestHelper::CompressColumnPart(chunk);
+      BtrReader reader(part.data());
+      vector<u8> output;
+      reader.readColumn(output, 0);
+      EXPECT_EQ(std::memcmp(output.data(), values.data(), values.size() * sizeof(DOUBLE)), 0);
+   }
+   // Measured speeds may put a scheme first that does not compress full width
+   // integers, the block falls back to uncompressed instead of failing
+   vector<INTEGER> integers(values.size());
+   std::uniform_int_distribution<INTEGER> int_dis(std::numeric_limits<INTEGER>::min());
+   for ( auto &value : integers ) {
+      value = int_dis(gen);
+   }
+   auto &cost = SchemeCost::get();
+   const double bp_speed = cost.decompressionSpeed(ColumnType::INTEGER, CB(IntegerSchemeType::BP));
+   cost.setDecompressionSpeed(ColumnType::INTEGER, CB(IntegerSchemeType::BP), 100);
+   cfg.budget.block_microseconds = 1;
+   auto compressed = Datablock::compress(TestHelper::MakeInputChunk(integers, nullmap, ColumnType::INTEGER));
+   EXPECT_EQ(reinterpret_cast<ColumnChunkMeta *>(compressed.data())->compression_type, CB(IntegerSchemeType::UNCOMPRESSED));
+   cost.setDecompressionSpeed(ColumnType::INTEGER, CB(IntegerSchemeType::BP), bp_speed);
+   cfg.budget.block_microseconds = 0;
+}
+// -------------------------------------------------------------------------------------
+TEST(Stats, Metrics)
+{
+   vector<INTEGER> values(65536);
+   for ( u32 i = 0; i < values.size(); i++ ) {
+      values[i] = (i / 16) % 100;
+   }
+   vector<BITMAP> nullmap(values.size(), 1);
+   auto chunk = TestHelper::MakeInputChunk(values, nullmap, ColumnType::INTEGER);
+   auto &cfg = BtrBlocksConfig::get();
+   // Disabled, nothing is recorded
+   {
+      Metrics::ColumnScope scope("off");
+      Datablock::compress(chunk);
+   }
+   EXPECT_EQ(Metrics::toJson().find("\"off\""), string::npos);
+   cfg.metrics = true;
+   vector<u8> output;
+   u8 scheme_code;
+   {
+      Metrics::ColumnScope scope("or\"ders");
+      auto compressed = Datablock::compress(chunk);
+      scheme_code = reinterpret_cast<ColumnChunkMeta *>(compressed.data())->compression_type;
+      auto part = TestHelper::CompressColumnPart(chunk);
+      BtrReader reader(part.data());
+      reader.readColumn(output, 0);
+   }
+   cfg.metrics = false;
+   auto &counters = Metrics::column("or\"ders").schemes[static_cast<u32>(ColumnType::INTEGER) * Metrics::SCHEME_COUNT + scheme_code];
+   // Compressed once by compress and once for the part
+   EXPECT_GE(counters.compressed_chunks.load(), 2u);
+   EXPECT_GE(counters.bytes_in.load(), 2 * values.size() * sizeof(INTEGER));
+   EXPECT_LT(counters.bytes_out.load(), counters.bytes_in.load());
+   EXPECT_GT(counters.estimated_bytes_out.load(), 0u);
+   EXPECT_GE(counters.max_cascade_depth.load(), 1u);
+   EXPECT_EQ(counters.decompressed_chunks.load(), 1u);
+   EXPECT_EQ(counters.decompressed_bytes.load(), values.size() * sizeof(INTEGER));
+   auto json = Metrics::toJson();
+   EXPECT_NE(json.find("{\"column\":\"or\\\"ders\",\"type\":\"integer\""), string::npos);
+   EXPECT_NE(json.find("\"actual_ratio\":"), string::npos);
+   auto prometheus = Metrics::toPrometheus();
+   EXPECT_NE(prometheus.find("# TYPE btrblocks_bytes_in_total counter"), string::npos);
+   EXPECT_NE(prometheus.find("btrblocks_decompressed_chunks_total{column=\"or\\\"ders\",type=\"integer\""), string::npos);
+   Metrics::reset();
+   EXPECT_EQ(counters.compressed_chunks.load(), 0u);
+   EXPECT_EQ(Metrics::toJson(), "{\"schemes\":[]}");
+}
+// -------------------------------------------------------------------------------------
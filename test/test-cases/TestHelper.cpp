@@ -29,3 +29,16 @@ void TestHelper::CheckRelationCompression(Relation &relation, RelationCompressor
 // -------------------------------------------------------------------------------------
 
 // -------------------------------------------------------------------------------------
+vector<u8> TestHelper::CompressColumnPart(const InputChunk &input_chunk)
+{
+   auto compressed = Datablock::compress(input_chunk);
+   // ColumnPartMetadata with a single offset, the chunk is aligned by 16 like in ColumnPart::writeToDisk
+   const u32 chunk_offset = 16;
+   vector<u8> part(chunk_offset + compressed.size() + SIMD_EXTRA_BYTES);
+   auto meta = reinterpret_cast<ColumnPartMetadata *>(part.data());
+   meta->num_chunks = 1;
+   meta->offsets[0] = chunk_offset;
+   std::memcpy(part.data() + chunk_offset, compressed.data(), compressed.size());
+   return part;
+}
+// -------------------------------------------------------------------------------------
@@ -2,6 +2,7 @@
 #include "btrblocks.hpp"
 #include "storage/Relation.hpp"
 #include "compression/Datablock.hpp"
+#include "compression/BtrReader.hpp"
 // -------------------------------------------------------------------------------------
 #include "gtest/gtest.h"
 // -------------------------------------------------------------------------------------
@@ -10,6 +11,38 @@ using namespace btrblocks;
 class TestHelper {
 public:
    static void CheckRelationCompression(Relation &relation, RelationCompressor &compressor, const vector<u8> expected_compression_schemes = {});
+   // Compresses a single chunk and lays it out like a column part with one chunk, so
+   // that it can be opened with a BtrReader
+   static vector<u8> CompressColumnPart(const InputChunk &input_chunk);
+   template<typename T>
+   static InputChunk MakeInputChunk(const vector<T> &values, const vector<BITMAP> &nullmap, ColumnType type)
+   {
+      auto data = std::unique_ptr<u8[]>(new u8[values.size() * sizeof(T)]);
+      std::memcpy(data.get(), values.data(), values.size() * sizeof(T));
+      auto bitmap = std::unique_ptr<BITMAP[]>(new BITMAP[nullmap.size()]);
+      std::memcpy(bitmap.get(), nullmap.data(), nullmap.size());
+      return InputChunk(std::move(data), std::move(bitmap), type, values.size(), values.size() * sizeof(T));
+   }
+   // Strings are laid out like a StringArrayViewer: (n + 1) slots followed by the strings
+   static InputChunk MakeStringInputChunk(const vector<string> &values, const vector<BITMAP> &nullmap)
+   {
+      size_t size = (values.size() + 1) * sizeof(StringArrayViewer::Slot);
+      for ( auto &value : values ) {
+         size += value.size();
+      }
+      auto data = std::unique_ptr<u8[]>(new u8[size]);
+      auto slots = reinterpret_cast<StringArrayViewer::Slot *>(data.get());
+      u32 offset = (values.size() + 1) * sizeof(StringArrayViewer::Slot);
+      for ( u32 i = 0; i < values.size(); i++ ) {
+         slots[i].offset = offset;
+         std::memcpy(data.get() + offset, values[i].data(), values[i].size());
+         offset += values[i].size();
+      }
+      slots[values.size()].offset = offset;
+      auto bitmap = std::unique_ptr<BITMAP[]>(new BITMAP[nullmap.size()]);
+      std::memcpy(bitmap.get(), nullmap.data(), nullmap.size());
+      return InputChunk(std::move(data), std::move(bitmap), ColumnType::STRING, values.size(), size);
+   }
 };
 // -------------------------------------------------------------------------------------
 template<typename T>
@@ -26,10 +59,18 @@ inline IntegerSchemeType& EnforceScheme<IntegerSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().integers.override_scheme;
 }
 template <>
+inline BigIntSchemeType& EnforceScheme<BigIntSchemeType>::getSchemeRef() {
+   return BtrBlocksConfig::get().bigints.override_scheme;
+}
+template <>
 inline DoubleSchemeType& EnforceScheme<DoubleSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().doubles.override_scheme;
 }
 template <>
+inline FloatSchemeType& EnforceScheme<FloatSchemeType>::getSchemeRef() {
+   return BtrBlocksConfig::get().floats.override_scheme;
+}
+template <>
 inline StringSchemeType& EnforceScheme<StringSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().strings.override_scheme;
 }
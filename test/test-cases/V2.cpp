@@ -63,6 +63,24 @@ TEST(V2, DoubleDecimal)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::PSEUDODECIMAL)});
 }
 // -------------------------------------------------------------------------------------
+TEST(V2, DoubleAlp)
+{
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::ALP);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::ALP)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DoubleXor)
+{
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::XOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/RANDOM.double"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::XOR)});
+}
+// -------------------------------------------------------------------------------------
 TEST(V2, DoubleDyanmicDict)
 {
    EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::DICT);
@@ -63,11 +63,21 @@ void outputChunk(std::ofstream &csvstream, u32 tuple_count,
                         csvstream << int_array[row];
                         break;
                     }
+                    case ColumnType::BIGINT: {
+                        auto bigint_array = reinterpret_cast<const BIGINT *>(decompressed_columns[col].data());
+                        csvstream << bigint_array[row];
+                        break;
+                    }
                     case ColumnType::DOUBLE: {
                         auto double_array = reinterpret_cast<const DOUBLE *>(decompressed_columns[col].data());
                         csvstream << double_array[row];
                         break;
                     }
+                    case ColumnType::FLOAT: {
+                        auto float_array = reinterpret_cast<const FLOAT *>(decompressed_columns[col].data());
+                        csvstream << float_array[row];
+                        break;
+                    }
                     case ColumnType::STRING: {
                         std::string data;
                         if (requires_copy[col]) {
@@ -0,0 +1,177 @@
+// -------------------------------------------------------------------------------------
+// Measures how fast every scheme decompresses on this host and writes the
+// speeds in the format SchemeCost::load reads.
+// -------------------------------------------------------------------------------------
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+// -------------------------------------------------------------------------------------
+#include "gflags/gflags.h"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+#include "common/SIMD.hpp"
+#include "compression/BtrReader.hpp"
+#include "compression/Datablock.hpp"
+#include "scheme/SchemeCost.hpp"
+#include "scheme/SchemePool.hpp"
+// -------------------------------------------------------------------------------------
+DEFINE_string(output, "scheme_speeds.txt", "File the measured decompression speeds are written to");
+DEFINE_uint32(tuple_count, 65536, "Tuples in the measured chunk");
+DEFINE_uint32(unique, 200, "Distinct values in the measured chunk, small enough for every dictionary");
+DEFINE_uint32(run_length, 4, "Length of the runs in the measured chunk");
+DEFINE_uint32(reps, 100, "Decompress every chunk reps times");
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+// Runs of FLAGS_unique distinct numbers, or of a single one for ONE_VALUE
+std::vector<u32> generateNumbers(bool one_value) {
+    std::vector<u32> numbers(FLAGS_tuple_count);
+    std::mt19937 gen(42);
+    u32 number = 0;
+    for (u32 i = 0; i < numbers.size(); i++) {
+        if (i % FLAGS_run_length == 0) {
+            number = one_value ? 7 : gen() % FLAGS_unique;
+        }
+        numbers[i] = number;
+    }
+    return numbers;
+}
+// -------------------------------------------------------------------------------------
+InputChunk makeChunk(ColumnType type, bool one_value) {
+    auto numbers = generateNumbers(one_value);
+    auto nullmap = std::unique_ptr<BITMAP[]>(new BITMAP[numbers.size()]);
+    std::memset(nullmap.get(), 1, numbers.size());
+    switch (type) {
+        case ColumnType::INTEGER: {
+            auto data = std::unique_ptr<u8[]>(new u8[numbers.size() * sizeof(INTEGER)]);
+            auto values = reinterpret_cast<INTEGER *>(data.get());
+            for (u32 i = 0; i < numbers.size(); i++) {
+                values[i] = numbers[i];
+            }
+            return InputChunk(std::move(data), std::move(nullmap), type, numbers.size(), numbers.size() * sizeof(INTEGER));
+        }
+        case ColumnType::BIGINT: {
+            // Spread over more than 32 bits, like the timestamps the type is meant for
+            auto data = std::unique_ptr<u8[]>(new u8[numbers.size() * sizeof(BIGINT)]);
+            auto values = reinterpret_cast<BIGINT *>(data.get());
+            for (u32 i = 0; i < numbers.size(); i++) {
+                values[i] = (BIGINT(1) << 40) + numbers[i];
+            }
+            return InputChunk(std::move(data), std::move(nullmap), type, numbers.size(), numbers.size() * sizeof(BIGINT));
+        }
+        case ColumnType::DOUBLE: {
+            auto data = std::unique_ptr<u8[]>(new u8[numbers.size() * sizeof(DOUBLE)]);
+            auto values = reinterpret_cast<DOUBLE *>(data.get());
+            for (u32 i = 0; i < numbers.size(); i++) {
+                values[i] = numbers[i] * 0.25;
+            }
+            return InputChunk(std::move(data), std::move(nullmap), type, numbers.size(), numbers.size() * sizeof(DOUBLE));
+        }
+        case ColumnType::FLOAT: {
+            auto data = std::unique_ptr<u8[]>(new u8[numbers.size() * sizeof(FLOAT)]);
+            auto values = reinterpret_cast<FLOAT *>(data.get());
+            for (u32 i = 0; i < numbers.size(); i++) {
+                values[i] = numbers[i] * 0.25f;
+            }
+            return InputChunk(std::move(data), std::move(nullmap), type, numbers.size(), numbers.size() * sizeof(FLOAT));
+        }
+        case ColumnType::STRING: {
+            // (n + 1) slots followed by the strings, like a StringArrayViewer
+            std::vector<std::string> strings;
+            SIZE size = (numbers.size() + 1) * sizeof(StringArrayViewer::Slot);
+            for (u32 number : numbers) {
+                strings.push_back("value-" + std::to_string(number));
+                size += strings.back().size();
+            }
+            auto data = std::unique_ptr<u8[]>(new u8[size]);
+            auto slots = reinterpret_cast<StringArrayViewer::Slot *>(data.get());
+            u32 offset = (strings.size() + 1) * sizeof(StringArrayViewer::Slot);
+            for (u32 i = 0; i < strings.size(); i++) {
+                slots[i].offset = offset;
+                std::memcpy(data.get() + offset, strings[i].data(), strings[i].size());
+                offset += strings[i].size();
+            }
+            slots[strings.size()].offset = offset;
+            return InputChunk(std::move(data), std::move(nullmap), type, numbers.size(), size);
+        }
+        default:
+            throw Generic_Exception("Type not supported");
+    }
+}
+// -------------------------------------------------------------------------------------
+// Compresses a chunk with the scheme forced at the top and returns the
+// decompression speed in GB/s, or 0 if the scheme does not round trip
+double measure(ColumnType type, u8 scheme_code, u8 &override_scheme) {
+    auto input_chunk = makeChunk(type, scheme_code == CB(IntegerSchemeType::ONE_VALUE));
+    override_scheme = scheme_code;
+    auto compressed = Datablock::compress(input_chunk);
+    override_scheme = autoScheme();
+    if (reinterpret_cast<ColumnChunkMeta *>(compressed.data())->compression_type != scheme_code) {
+        return 0;
+    }
+    // A column part with a single chunk, aligned like ColumnPart::writeToDisk does it
+    const u32 chunk_offset = 16;
+    std::vector<u8> part(chunk_offset + compressed.size() + SIMD_EXTRA_BYTES);
+    auto meta = reinterpret_cast<ColumnPartMetadata *>(part.data());
+    meta->num_chunks = 1;
+    meta->offsets[0] = chunk_offset;
+    std::memcpy(part.data() + chunk_offset, compressed.data(), compressed.size());
+
+    BtrReader reader(part.data());
+    std::vector<u8> output;
+    bool requires_copy = reader.readColumn(output, 0);
+    auto bitmap = reader.getBitmap(0)->writeBITMAP();
+    if (!input_chunk.compareContents(output.data(), bitmap, input_chunk.tuple_count, requires_copy)) {
+        return 0;
+    }
+    u64 nanoseconds = 0;
+    for (u32 rep = 0; rep < FLAGS_reps; rep++) {
+        reader.releaseBitmap(0);
+        auto start_time = std::chrono::steady_clock::now();
+        reader.readColumn(output, 0);
+        auto end_time = std::chrono::steady_clock::now();
+        nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    }
+    return static_cast<double>(input_chunk.size) * FLAGS_reps / nanoseconds;
+}
+// -------------------------------------------------------------------------------------
+template <typename SchemeMap>
+void calibrate(ColumnType type, const SchemeMap &schemes, u8 &override_scheme) {
+    for (auto &[scheme_type, scheme] : schemes) {
+        double speed = 0;
+        try {
+            speed = measure(type, CB(scheme_type), override_scheme);
+        } catch (const std::exception &) {
+            override_scheme = autoScheme();
+        }
+        std::cout << ConvertTypeToString(type) << ' ' << ConvertSchemeTypeToString(scheme_type) << ": ";
+        if (speed > 0) {
+            SchemeCost::get().setDecompressionSpeed(type, CB(scheme_type), speed);
+            std::cout << speed << " GB/s" << std::endl;
+        } else {
+            std::cout << "not usable on the generated data, keeping the default" << std::endl;
+        }
+    }
+}
+// -------------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    // Only the default schemes, the legacy ones keep their default speed
+    BtrBlocksConfig::configure();
+    auto &cfg = BtrBlocksConfig::get();
+    calibrate(ColumnType::INTEGER, SchemePool::available_schemes->integer_schemes,
+              reinterpret_cast<u8 &>(cfg.integers.override_scheme));
+    calibrate(ColumnType::BIGINT, SchemePool::available_schemes->bigint_schemes,
+              reinterpret_cast<u8 &>(cfg.bigints.override_scheme));
+    calibrate(ColumnType::DOUBLE, SchemePool::available_schemes->double_schemes,
+              reinterpret_cast<u8 &>(cfg.doubles.override_scheme));
+    calibrate(ColumnType::FLOAT, SchemePool::available_schemes->float_schemes,
+              reinterpret_cast<u8 &>(cfg.floats.override_scheme));
+    calibrate(ColumnType::STRING, SchemePool::available_schemes->string_schemes,
+              reinterpret_cast<u8 &>(cfg.strings.override_scheme));
+    SchemeCost::get().save(FLAGS_output);
+    std::cout << "Written to " << FLAGS_output << std::endl;
+    return 0;
+}
+// -------------------------------------------------------------------------------------
@@ -18,11 +18,15 @@
 #include <tbb/task_scheduler_init.h>
 // ------------------------------------------------------------------------------
 // Btr internal includes
+#include "btrblocks.hpp"
 #include "common/Utils.hpp"
 #include "storage/Relation.hpp"
+#include "scheme/SchemeCost.hpp"
 #include "scheme/SchemePool.hpp"
 #include "compression/Datablock.hpp"
+#include "compression/SchemeDecisionCache.hpp"
 #include "compression/BtrReader.hpp"
+#include "compression/Metrics.hpp"
 #include "cache/ThreadCache.hpp"
 // ------------------------------------------------------------------------------
 // Btrfiles include
@@ -43,6 +47,11 @@ DEFINE_bool(verify, true, "Verify that decompression works");
 DEFINE_int32(chunk, -1, "Select a specific chunk to measure");
 DEFINE_int32(column, -1, "Select a specific column to measure");
 DEFINE_uint32(threads, 8, "");
+DEFINE_string(objective, "ratio", "Scheme selection objective: ratio, read_time or ratio_at_speed");
+DEFINE_string(scheme_speeds, "", "Decompression speeds measured by calibrate-schemes");
+DEFINE_bool(try_all, false, "Compress with every scheme instead of estimating on samples");
+DEFINE_uint32(trial_threads, 1, "Threads trying the schemes of a single block");
+DEFINE_string(metrics, "", "File to write compression metrics to, Prometheus text if it ends in .prom, JSON otherwise");
 // ------------------------------------------------------------------------------
 using namespace btrblocks;
 // ------------------------------------------------------------------------------
@@ -72,6 +81,25 @@ int main(int argc, char **argv)
     // This seems necessary to be
     SchemePool::refresh();
 
+    auto &selection = BtrBlocksConfig::get().selection;
+    if (FLAGS_objective == "ratio") {
+        selection.objective = SelectionObjective::MAX_RATIO;
+    } else if (FLAGS_objective == "read_time") {
+        selection.objective = SelectionObjective::MIN_READ_TIME;
+    } else if (FLAGS_objective == "ratio_at_speed") {
+        selection.objective = SelectionObjective::RATIO_AT_SPEED;
+    } else {
+        throw std::runtime_error("objective must be one of [ratio, read_time, ratio_at_speed]");
+    }
+    if (!FLAGS_scheme_speeds.empty()) {
+        SchemeCost::get().load(FLAGS_scheme_speeds);
+    }
+    if (FLAGS_try_all) {
+        BtrBlocksConfig::get().scheme_selection = SchemeSelection::TRY_ALL;
+    }
+    BtrBlocksConfig::get().trial_threads = FLAGS_trial_threads;
+    BtrBlocksConfig::get().metrics = !FLAGS_metrics.empty();
+
     // Init TBB TODO: is that actually still necessary ?
     tbb::task_scheduler_init init(FLAGS_threads);
 
@@ -105,12 +133,16 @@ int main(int argc, char **argv)
         typefilter = ColumnType::UNDEFINED;
     } else if (FLAGS_typefilter == "integer") {
         typefilter = ColumnType::INTEGER;
+    } else if (FLAGS_typefilter == "bigint") {
+        typefilter = ColumnType::BIGINT;
     } else if (FLAGS_typefilter == "double") {
         typefilter = ColumnType::DOUBLE;
+    } else if (FLAGS_typefilter == "float") {
+        typefilter = ColumnType::FLOAT;
     } else if (FLAGS_typefilter == "string") {
         typefilter = ColumnType::STRING;
     } else {
-        throw std::runtime_error("typefilter must be one of [integer, double, string]");
+        throw std::runtime_error("typefilter must be one of [integer, bigint, double, float, string]");
     }
 
     if (typefilter != ColumnType::UNDEFINED) {
@@ -154,16 +186,22 @@ int main(int argc, char **argv)
             return;
         }
 
+        Metrics::ColumnScope metrics(relation.columns[column_i].name);
         std::vector<InputChunk> input_chunks;
         std::string path_prefix = FLAGS_btr + "/" + "column" + std::to_string(column_i) + "_part";
         ColumnPart part;
+        SchemeDecisionCache decisions;
         for (SIZE chunk_i = 0; chunk_i < ranges.size(); chunk_i++) {
             if (FLAGS_chunk != -1 && FLAGS_chunk != chunk_i) {
                 continue;
             }
 
             auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, column_i);
-            std::vector<u8> data = Datablock::compress(input_chunk);
+            std::vector<u8> data;
+            {
+                SchemeDecisionCache::Scope scope(decisions);
+                data = Datablock::compress(input_chunk);
+            }
             sizes_uncompressed[column_i] += input_chunk.size;
 
             if (!part.canAdd(data.size())) {
@@ -211,5 +249,11 @@ int main(int argc, char **argv)
                         << " btr: " << btr_creation_time_seconds
                         << " total: " << (binary_creation_time_seconds + btr_creation_time_seconds)
                         << " verify: " << FLAGS_verify << std::endl;
+
+    if (!FLAGS_metrics.empty()) {
+        std::ofstream metrics_stream(FLAGS_metrics);
+        bool prometheus = std::filesystem::path(FLAGS_metrics).extension() == ".prom";
+        metrics_stream << (prometheus ? Metrics::toPrometheus() : Metrics::toJson()) << std::endl;
+    }
     return 0;
 }
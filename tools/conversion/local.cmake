@@ -24,6 +24,10 @@ add_executable(decompression-speed ${BTR_CONVERSION_DIR}/decompression-speed.cpp
 target_include_directories(decompression-speed PRIVATE ${BTR_INCLUDE_DIR})
 target_link_libraries(decompression-speed btrblocks tbb gflags)
 
+add_executable(calibrate-schemes ${BTR_CONVERSION_DIR}/calibrate-schemes.cpp)
+target_include_directories(calibrate-schemes PRIVATE ${BTR_INCLUDE_DIR})
+target_link_libraries(calibrate-schemes btrblocks gflags)
+
 add_executable(decompression-speed-s3 ${BTR_CONVERSION_DIR}/decompression-speed-s3.cpp)
 target_include_directories(decompression-speed-s3 PRIVATE ${BTR_INCLUDE_DIR})
 target_link_libraries(decompression-speed-s3 btrblocks tbb gflags libaws-cpp-sdk-core libaws-cpp-sdk-s3-crt libaws-cpp-sdk-s3)
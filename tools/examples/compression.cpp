@@ -41,7 +41,9 @@ int main(int argc, char *argv[]) {
             auto max_depth  = std::atoi(argv[1]);
             std::cout << "setting max cascade depth to " << max_depth << std::endl;
             config.integers.max_cascade_depth = max_depth;
+            config.bigints.max_cascade_depth = max_depth;
             config.doubles.max_cascade_depth = max_depth;
+            config.floats.max_cascade_depth = max_depth;
             config.strings.max_cascade_depth = max_depth;
         }
         config.doubles.schemes.enable(DoubleSchemeType::DOUBLE_BP);
@@ -106,10 +108,18 @@ int main(int argc, char *argv[]) {
               check = validateData(size, reinterpret_cast<int32_t*>(orig.get()),
                                    reinterpret_cast<int32_t*>(decomp.get()));
               break;
+            case ColumnType::BIGINT:
+              check = validateData(size, reinterpret_cast<int64_t*>(orig.get()),
+                                   reinterpret_cast<int64_t*>(decomp.get()));
+              break;
             case ColumnType::DOUBLE:
               check = validateData(size, reinterpret_cast<double*>(orig.get()),
                                    reinterpret_cast<double*>(decomp.get()));
               break;
+            case ColumnType::FLOAT:
+              check = validateData(size, reinterpret_cast<float*>(orig.get()),
+                                   reinterpret_cast<float*>(decomp.get()));
+              break;
             default:
               UNREACHABLE();
         }
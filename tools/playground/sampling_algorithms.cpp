@@ -27,6 +27,7 @@ DEFINE_int32(bm_skip_files, 0, "skip these many files from the input file list")
 DEFINE_int32(bm_file_count, 20, "test these many files");
 DEFINE_string(bm_input_file_list, "s3-columns.txt", "the file listing the s3 input objects");
 DEFINE_bool(bm_clear_filecache, false, "whether to remove s3 dowloaded files");
+DEFINE_string(bm_strategy, "stratified", "sampling strategy: stratified, reservoir or null_aware");
 // -------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------
 struct InputFiles {
@@ -244,6 +245,7 @@ TestResult testSampling(const std::string& filename, const std::string& bitmap_f
           }
           e.setParam("scheme", scheme->selfDescription());
           e.setParam("sampling", sampler.name());
+          e.setParam("strategy", FLAGS_bm_strategy);
           e.setParam("sample_size", sample_size);
           e.setParam("sample_count", sample_count);
           e.setParam("sampled_items", sampler.sampled_items());
@@ -272,6 +274,16 @@ int main(int argc, char *argv[]) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   spdlog::set_level(spdlog::level::warn);
   SchemePool::refresh();
+  auto& sampling = BtrBlocksConfig::get().sampling;
+  if (FLAGS_bm_strategy == "stratified") {
+    sampling.strategy = SamplingStrategy::STRATIFIED_RUNS;
+  } else if (FLAGS_bm_strategy == "reservoir") {
+    sampling.strategy = SamplingStrategy::RESERVOIR;
+  } else if (FLAGS_bm_strategy == "null_aware") {
+    sampling.strategy = SamplingStrategy::NULL_AWARE;
+  } else {
+    throw std::runtime_error("strategy must be one of [stratified, reservoir, null_aware]");
+  }
   PerfEvent perf;
 
   InputFiles filelist(FLAGS_bm_input_file_list);